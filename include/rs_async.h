@@ -0,0 +1,123 @@
+/**
+ * @file rs_async.h
+ * @brief Asynchronous submit/complete encode and decode on a worker pool.
+ *
+ * For event loops that must not block on a large batch: a job describes a
+ * batch of packed frames exactly like rs_encode_batch()/rs_decode_batch()
+ * (rs_batch.h), rs_async_submit() queues it and returns at once, and the
+ * pool's worker threads process it in chunks of frames, several workers
+ * sharing a large job. When the last chunk is done the job completes:
+ *
+ *   - with job->done set, the callback runs on the worker thread that
+ *     finished the job, or inside rs_async_submit() for an empty job
+ *     (keep it short: hand the job over to another thread);
+ *   - otherwise the job is appended to the pool's completion queue, and
+ *     rs_async_fd() becomes readable. The event loop polls that descriptor
+ *     with its sockets and collects jobs with rs_async_reap().
+ *
+ * The descriptor is an eventfd on Linux, the read end of a pipe on other
+ * POSIX systems, and -1 on Windows (use rs_async_wait() there). It stays
+ * readable while the completion queue is non-empty.
+ *
+ * Jobs are owned by the caller and must stay valid, with their buffers,
+ * until they complete; submitting never allocates. A C++20 wrapper that
+ * awaits jobs from coroutines is in rs_async.hpp.
+ *
+ * Requirements:
+ *   - rs_gf_init(m, N, K, T) must be called before rs_async_create(), and
+ *     the code must not change while the pool exists.
+ */
+
+#ifndef RS_ASYNC_H
+#define RS_ASYNC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RS_ASYNC_ENCODE 0
+#define RS_ASYNC_DECODE 1
+
+/* Frames per work item when rs_async_create() is given chunk = 0 */
+#define RS_ASYNC_CHUNK 32
+
+typedef struct rs_async rs_async;
+typedef struct rs_async_job rs_async_job;
+
+/**
+ * @brief Completion callback, invoked once per job on a worker thread.
+ */
+typedef void (*rs_async_done_fn)(rs_async_job *job);
+
+struct rs_async_job {
+  /* Set by the caller (see rs_encode_batch() / rs_decode_batch_bits()) */
+  int op;            /* RS_ASYNC_ENCODE or RS_ASYNC_DECODE */
+  const uint8_t *in; /* info (encode) or received (decode) frames */
+  size_t in_stride;
+  uint8_t *out; /* codewords / corrected frames (decode: may equal in) */
+  size_t out_stride;
+  int *status; /* decode: optional per-frame status */
+  int *bits;   /* decode: optional per-frame corrected bits */
+  size_t n_frames;
+  rs_async_done_fn done; /* NULL: completion queue */
+  void *user;
+
+  /* Private to the pool */
+  rs_async_job *next;
+  size_t next_frame;
+  size_t frames_left;
+};
+
+/**
+ * @brief Start a worker pool for the current code.
+ *
+ * @param n_threads Worker threads (0 = one per online CPU).
+ * @param chunk     Frames per work item (0 = RS_ASYNC_CHUNK).
+ *
+ * @return Pool, or NULL on failure.
+ */
+rs_async *rs_async_create(int n_threads, size_t chunk);
+
+/**
+ * @brief Finish all submitted jobs, then stop the workers and release the
+ *        pool. Jobs still in the completion queue are not returned.
+ */
+void rs_async_destroy(rs_async *a);
+
+/**
+ * @brief Queue a job; returns without waiting.
+ *
+ * @return 0 if the job was queued, -1 if it is invalid (it will not
+ *         complete then).
+ */
+int rs_async_submit(rs_async *a, rs_async_job *job);
+
+/**
+ * @brief Descriptor that is readable while completed jobs wait in the
+ *        completion queue (-1 where unsupported).
+ */
+int rs_async_fd(const rs_async *a);
+
+/**
+ * @brief Take up to max completed jobs from the completion queue, in
+ *        completion order, without blocking.
+ *
+ * @return Number of jobs stored in jobs[].
+ */
+size_t rs_async_reap(rs_async *a, rs_async_job **jobs, size_t max);
+
+/**
+ * @brief Block until the completion queue is non-empty and take one job.
+ *
+ * Only meaningful for jobs without a callback.
+ */
+rs_async_job *rs_async_wait(rs_async *a);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RS_ASYNC_H */
@@ -0,0 +1,128 @@
+/**
+ * @file rs_async.hpp
+ * @brief C++20 coroutine wrapper over the asynchronous codec (rs_async.h).
+ *
+ * Header only; link the C library as usual. A coroutine awaits a batch and
+ * is resumed by the event loop thread once the workers are done:
+ *
+ *   rs::async_pool pool;                          // after rs_gf_init()
+ *
+ *   task serve(rs::async_pool &pool, connection &c) {
+ *     co_await c.read(recv, n * cb);
+ *     co_await pool.decode(recv, cb, recv, cb, status, n);
+ *     co_await c.write(recv, n * cb);
+ *   }
+ *
+ *   // event loop: poll pool.fd() with the sockets, and when it is readable
+ *   pool.dispatch();                              // resumes the coroutines
+ *
+ * No thread is tied to a connection: a suspended coroutine costs its frame,
+ * the job lives inside it, and decoding overlaps the loop's other I/O. The
+ * coroutine type is the caller's; any coroutine can await these objects.
+ * Where no descriptor exists (Windows), call dispatch() periodically.
+ */
+
+#ifndef RS_ASYNC_HPP
+#define RS_ASYNC_HPP
+
+#include "rs_async.h"
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace rs {
+
+class async_pool {
+public:
+  /**
+   * @param threads Worker threads (0 = one per online CPU).
+   * @param chunk   Frames per work item (0 = RS_ASYNC_CHUNK).
+   */
+  explicit async_pool(int threads = 0, std::size_t chunk = 0)
+      : pool_(rs_async_create(threads, chunk)) {
+    if (!pool_)
+      throw std::runtime_error("rs_async_create failed");
+  }
+  ~async_pool() { rs_async_destroy(pool_); }
+
+  async_pool(const async_pool &) = delete;
+  async_pool &operator=(const async_pool &) = delete;
+
+  /** Descriptor to poll; readable when dispatch() has work. */
+  int fd() const { return rs_async_fd(pool_); }
+
+  /** Resume every coroutine whose job completed; returns how many. */
+  std::size_t dispatch() {
+    rs_async_job *done[64];
+    std::size_t total = 0, n;
+    while ((n = rs_async_reap(pool_, done, 64)) > 0) {
+      for (std::size_t i = 0; i < n; i++)
+        std::coroutine_handle<>::from_address(done[i]->user).resume();
+      total += n;
+    }
+    return total;
+  }
+
+  /** co_await result: true once the batch is done, false if rejected. */
+  class awaitable {
+  public:
+    bool await_ready() const noexcept { return job_.n_frames == 0; }
+    bool await_suspend(std::coroutine_handle<> h) noexcept {
+      job_.user = h.address();
+      ok_ = (rs_async_submit(pool_, &job_) == 0);
+      return ok_; /* resume at once if the job was rejected */
+    }
+    bool await_resume() const noexcept { return ok_; }
+
+  private:
+    friend class async_pool;
+    awaitable(rs_async *pool, const rs_async_job &job)
+        : pool_(pool), job_(job) {}
+
+    rs_async *pool_;
+    rs_async_job job_; /* lives in the awaiting coroutine's frame */
+    bool ok_ = true;
+  };
+
+  /** Encode n packed information frames (rs_encode_batch()). */
+  awaitable encode(const std::uint8_t *info, std::size_t info_stride,
+                   std::uint8_t *code, std::size_t code_stride,
+                   std::size_t n) {
+    return make(RS_ASYNC_ENCODE, info, info_stride, code, code_stride,
+                nullptr, nullptr, n);
+  }
+
+  /** Decode n packed received frames (rs_decode_batch_bits()). */
+  awaitable decode(const std::uint8_t *recv, std::size_t recv_stride,
+                   std::uint8_t *code, std::size_t code_stride, int *status,
+                   std::size_t n, int *bits = nullptr) {
+    return make(RS_ASYNC_DECODE, recv, recv_stride, code, code_stride,
+                status, bits, n);
+  }
+
+  rs_async *get() const { return pool_; }
+
+private:
+  awaitable make(int op, const std::uint8_t *in, std::size_t in_stride,
+                 std::uint8_t *out, std::size_t out_stride, int *status,
+                 int *bits, std::size_t n) {
+    rs_async_job job{};
+    job.op = op;
+    job.in = in;
+    job.in_stride = in_stride;
+    job.out = out;
+    job.out_stride = out_stride;
+    job.status = status;
+    job.bits = bits;
+    job.n_frames = n;
+    return awaitable(pool_, job);
+  }
+
+  rs_async *pool_;
+};
+
+} // namespace rs
+
+#endif /* RS_ASYNC_HPP */
@@ -0,0 +1,110 @@
+/**
+ * @file rs_batch.h
+ * @brief Multi-threaded batch encode/decode on packed frames.
+ *
+ * A batch is n_frames packed codewords (rs_pack.h) laid out with a
+ * constant byte stride, e.g. the rows of a 2-D uint8 array. Frames are
+ * split into contiguous chunks, one per thread; each thread uses its own
+ * workspace, so no frame is copied beyond the packed ↔ symbol conversion.
+ *
+ * The *_batch_sym variants work in place on GF symbols with a stride
+ * between frames and another between the symbols of a frame, so the rows
+ * and the columns of a symbol matrix are both batches (rs_product.h).
+ *
+ * Requirements:
+ *   - rs_gf_init(m, N, K, T) must be called before, and not concurrently.
+ *   - Strides must be at least rs_packed_bytes() of the respective frame.
+ *
+ * n_threads is clamped to the online CPU count and RS_BATCH_MAX_THREADS;
+ * more threads than CPUs only add start-up and workspace cost.
+ */
+
+#ifndef RS_BATCH_H
+#define RS_BATCH_H
+
+#include "rs_gf.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/** Upper bound on the threads of one batch call */
+#define RS_BATCH_MAX_THREADS 64
+
+/**
+ * @brief Encode a batch of packed information frames.
+ *
+ * @param info_pack   Input  frames, rs_packed_bytes(K) bytes each.
+ * @param info_stride Byte distance between input frames.
+ * @param code_pack   Output frames, rs_packed_bytes(K + T) bytes each.
+ * @param code_stride Byte distance between output frames.
+ * @param n_frames    Number of frames.
+ * @param n_threads   Worker threads (0 = one per online CPU).
+ *
+ * @return 0 on success, negative on failure.
+ */
+int rs_encode_batch(const uint8_t *info_pack, size_t info_stride,
+                    uint8_t *code_pack, size_t code_stride, size_t n_frames,
+                    int n_threads);
+
+/**
+ * @brief Decode a batch of packed received frames.
+ *
+ * @param recv_pack   Input  frames, rs_packed_bytes(N) bytes each.
+ * @param recv_stride Byte distance between input frames.
+ * @param code_pack   Output corrected frames (may equal recv_pack with the
+ *                    same stride for in-place decoding).
+ * @param code_stride Byte distance between output frames.
+ * @param status      Optional per-frame status (see rs_decode()).
+ * @param n_frames    Number of frames.
+ * @param n_threads   Worker threads (0 = one per online CPU).
+ *
+ * @return 0 on success, negative on failure.
+ */
+int rs_decode_batch(const uint8_t *recv_pack, size_t recv_stride,
+                    uint8_t *code_pack, size_t code_stride, int *status,
+                    size_t n_frames, int n_threads);
+
+/**
+ * @brief rs_decode_batch() that also reports corrected bits per frame.
+ *
+ * @param bits Optional per-frame count of bits flipped by the decoder
+ *             (rs_decode_last_bits()), the input of rs_stats.h.
+ */
+int rs_decode_batch_bits(const uint8_t *recv_pack, size_t recv_stride,
+                         uint8_t *code_pack, size_t code_stride, int *status,
+                         int *bits, size_t n_frames, int n_threads);
+
+/**
+ * @brief Encode a batch of strided symbol frames in place.
+ *
+ * Symbol n of frame f is sym[f * frame_stride + n * sym_stride]. The K
+ * information symbols of each frame are read and its T parity symbols
+ * written.
+ *
+ * @return 0 on success, negative on failure.
+ */
+int rs_encode_batch_sym(rs_sym_t *sym, size_t frame_stride,
+                        size_t sym_stride, size_t n_frames, int n_threads);
+
+/**
+ * @brief Errors-and-erasures decode of strided symbol frames in place.
+ *
+ * Every frame is decoded with rs_decode_sym_erasures() and the same
+ * erasure list; frames the decoder gives up on are left unmodified.
+ *
+ * @param eras_pos Erased positions shared by all frames (or NULL).
+ * @param n_eras   Number of erasures, 0..T.
+ * @param status   Optional per-frame status (see rs_decode_sym_erasures()).
+ *
+ * @return 0 on success, negative on failure.
+ */
+int rs_decode_batch_sym(rs_sym_t *sym, size_t frame_stride,
+                        size_t sym_stride, const int *eras_pos, int n_eras,
+                        int *status, size_t n_frames, int n_threads);
+
+/**
+ * @brief Number of threads used for n_threads = 0 (online CPUs, at most
+ *        RS_BATCH_MAX_THREADS).
+ */
+int rs_batch_default_threads(void);
+
+#endif /* RS_BATCH_H */
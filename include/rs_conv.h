@@ -0,0 +1,77 @@
+/**
+ * @file rs_conv.h
+ * @brief Rate-1/2, K = 7 convolutional inner code and Viterbi decoder.
+ *
+ * The classic CCSDS / DVB concatenated chain protects RS codewords with
+ * this inner code (generators 171, 133 octal). The encoder is a 6-bit shift
+ * register; every frame is terminated with K - 1 = 6 zero tail bits, so the
+ * decoder starts and ends in state 0. (CCSDS additionally inverts the G2
+ * output; that does not change the decoder's error behaviour and is left
+ * out here.)
+ *
+ * The decoder is a 64-state soft-decision Viterbi decoder with 16-bit path
+ * metrics. Add-compare-select runs 32 butterflies per trellis step in
+ * SIMD registers: AVX2 (2 × 16 lanes), SSE2 (4 × 8 lanes), or a portable
+ * scalar loop. The kernel is chosen once at run time from the CPU's
+ * features (rs_viterbi_kernel()); all kernels make the same decisions,
+ * ties included, and therefore give identical output.
+ *
+ * Bits are stored one per byte (0 / 1). Soft inputs are one byte per coded
+ * bit: 0 = certainly 0, 255 = certainly 1, 128 = erasure.
+ */
+
+#ifndef RS_CONV_H
+#define RS_CONV_H
+
+#include <stdint.h>
+
+#define RS_CONV_K 7                        /* constraint length */
+#define RS_CONV_TAIL (RS_CONV_K - 1)        /* tail bits per frame */
+#define RS_CONV_POLY_A 0171                 /* G1 (octal) */
+#define RS_CONV_POLY_B 0133                 /* G2 (octal) */
+#define RS_CONV_CODED(n) (2 * ((n) + RS_CONV_TAIL)) /* coded bits */
+
+/**
+ * @brief Encode n_bits bits plus the zero tail.
+ *
+ * @param bits   Input bits (n_bits entries, 0 / 1).
+ * @param coded  Output coded bits, RS_CONV_CODED(n_bits) entries, in the
+ *               order G1, G2 per input bit.
+ */
+void rs_conv_encode(const uint8_t *bits, int n_bits, uint8_t *coded);
+
+typedef struct rs_viterbi rs_viterbi;
+
+/**
+ * @brief Create a decoder for frames of up to max_bits information bits.
+ *
+ * Holds the decision memory (8 bytes per trellis step).
+ *
+ * @return Decoder, or NULL on allocation failure.
+ */
+rs_viterbi *rs_viterbi_create(int max_bits);
+
+/**
+ * @brief Release a decoder returned by rs_viterbi_create().
+ */
+void rs_viterbi_destroy(rs_viterbi *v);
+
+/**
+ * @brief Maximum-likelihood decode of one terminated frame.
+ *
+ * @param soft   RS_CONV_CODED(n_bits) soft coded bits.
+ * @param n_bits Information bits in the frame (≤ max_bits).
+ * @param bits   Output bits (n_bits entries, 0 / 1).
+ *
+ * @return 0 on success, negative if n_bits exceeds the decoder's size.
+ */
+int rs_viterbi_decode(rs_viterbi *v, const uint8_t *soft, int n_bits,
+                      uint8_t *bits);
+
+/**
+ * @brief Name of the add-compare-select kernel in use
+ *        ("avx2", "sse2" or "scalar").
+ */
+const char *rs_viterbi_kernel(void);
+
+#endif /* RS_CONV_H */
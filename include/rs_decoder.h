@@ -7,7 +7,8 @@
  * shortened codeword.
  *
  * Decoding process (implemented in rs_decoder.c):
- *   1. Build parent-length input: [S zero-symbols][Ns received symbols]
+ *   1. Convert Ns received symbols (the S leading zero-symbols of the
+ *      parent code are implicit)
  *   2. Compute syndromes
  *   3. Berlekamp–Massey → error-locator polynomial
  *   4. Chien search → error positions
@@ -16,14 +17,92 @@
  *        - code_bits : corrected shortened codeword (Ns symbols)
  *        - info_bits : first K symbols (decoded information)
  *
+ * Post-correction verification (rs_decode_set_verify()):
+ *   With more than t errors the decoder may land on a wrong codeword. Off
+ *   by default; when enabled, every correction is checked before it is
+ *   applied:
+ *     - all T syndromes of the corrected word must vanish; they are updated
+ *       from the error values, O(T·e), not recomputed over N symbols;
+ *     - every error position must lie in the transmitted range, not in the
+ *       S shortened (never sent) positions.
+ *   A failed check returns RS_DECODE_MISCORRECTED and leaves the word
+ *   unmodified. It catches decoder outputs that are not codewords of the
+ *   shortened code; a received word within t symbols of a different
+ *   codeword is indistinguishable from a correctable one by any decoder.
+ *   The check covers every entry point built on this file (symbol, bit,
+ *   packed, batch, pipeline, split and errors-and-erasures decoding).
+ *
  * Requirements:
  *   - rs_gf_init(m, N, K, T) must be called before using this decoder.
  *   - recv_bits must have Ns * m elements.
+ *   - *_ws variants take a workspace sized for the current code; the other
+ *     entry points use the calling thread's default workspace.
  */
 
 #ifndef RS_DECODER_H
 #define RS_DECODER_H
 
+#include "rs_workspace.h"
+#include <stdint.h>
+
+/* Status: verification rejected the correction (rs_decode_set_verify()) */
+#define RS_DECODE_MISCORRECTED (-2)
+
+/* Status: rs_decode_stream_finish() before all Ns symbols arrived */
+#define RS_DECODE_INCOMPLETE (-3)
+
+/**
+ * @brief Enable (1) or disable (0) post-correction verification.
+ *
+ * Process-wide; must not change while other threads are decoding.
+ */
+void rs_decode_set_verify(int enable);
+
+/**
+ * @brief Current verification setting.
+ */
+int rs_decode_get_verify(void);
+
+/*
+ * Syndrome backends (rs_decode_set_syndrome_method()):
+ *   RS_SYND_DIRECT    : evaluate the received word at the T roots of g(x),
+ *                       O(N·T) (rs_poly_eval_geom());
+ *   RS_SYND_REMAINDER : re-encode the K information symbols
+ *                       (rs_encode_parity(), the encoder's kernels) and add
+ *                       the received parity. That is the remainder r(x) mod
+ *                       g(x); a zero remainder proves the word clean, else
+ *                       the T syndromes are its T-symbol evaluation.
+ *                       Needs T ≤ RS_SYND_REM_T_MAX (larger T: direct).
+ * Both give identical syndromes; which is faster depends on the code and
+ * CPU (rs_bench_syndromes).
+ */
+typedef enum { RS_SYND_DIRECT, RS_SYND_REMAINDER } rs_synd_method;
+
+#define RS_SYND_REM_T_MAX 256
+
+/**
+ * @brief Select the syndrome backend (default RS_SYND_DIRECT).
+ *
+ * Process-wide; must not change while other threads are decoding.
+ */
+void rs_decode_set_syndrome_method(rs_synd_method method);
+
+/**
+ * @brief Current syndrome backend.
+ */
+rs_synd_method rs_decode_get_syndrome_method(void);
+
+/**
+ * @brief Bits flipped by the calling thread's last decode.
+ *
+ * Every decode records the popcount of the error values it applied (in the
+ * symbol basis of the code) in its workspace, ws->corr_bits; this reads it
+ * from the default workspace. Summed over codewords and divided by the
+ * number of received bits it is an estimate of the pre-FEC bit error rate
+ * (rs_stats.h). Meaningful when the decode returned a status ≥ 0.
+ */
+int rs_decode_last_bits(void);
+
 /**
  * @brief Decode a shortened systematic Reed–Solomon codeword.
  *
@@ -31,10 +110,246 @@
  * @param code_bits Output corrected codeword bits (Ns * m bits).
  * @param info_bits Output decoded information bits (K * m bits).
  *
+ * @return Number of corrected symbols (0 = clean codeword),
+ *         -1 if an uncorrectable error pattern was detected (codeword
+ *         left as received), or
+ *         RS_DECODE_MISCORRECTED (-2) if verification is enabled and
+ *         rejected the correction (codeword left as received).
+ *
  * Notes:
  *   - This function performs full RS error correction.
  *   - Outputs are given in bit form (LSB-first ordering per symbol).
+ *   - Scratch memory comes from the calling thread's default workspace.
+ */
+int rs_decode(const int *recv_bits, int *code_bits, int *info_bits);
+
+/**
+ * @brief rs_decode() with an explicit workspace (no allocation).
+ *
+ * @param ws Workspace sized for the current code (rs_workspace.h). Every
+ *           *_ws function returns -1 without decoding if it does not fit
+ *           the current code (rs_workspace_check()).
+ */
+int rs_decode_ws(rs_workspace *ws, const int *recv_bits, int *code_bits,
+                 int *info_bits);
+
+/**
+ * @brief Decode a shortened codeword given as GF symbols, in place.
+ *
+ * @param code_sym Received symbols (Ns entries), corrected on return.
+ *
+ * @return Same status as rs_decode().
+ */
+int rs_decode_sym(rs_sym_t *code_sym);
+
+/**
+ * @brief rs_decode_sym() with an explicit workspace.
+ */
+int rs_decode_sym_ws(rs_workspace *ws, rs_sym_t *code_sym);
+
+/**
+ * @brief Decode a packed codeword (rs_pack.h).
+ *
+ * @param recv_pack Input  rs_packed_bytes(Ns) bytes.
+ * @param code_pack Output corrected codeword, rs_packed_bytes(Ns) bytes
+ *                  (may equal recv_pack, or NULL).
+ * @param info_pack Output information part, rs_packed_bytes(K) bytes
+ *                  (or NULL).
+ *
+ * @return Same status as rs_decode().
+ */
+int rs_decode_packed(const uint8_t *recv_pack, uint8_t *code_pack,
+                     uint8_t *info_pack);
+
+/**
+ * @brief rs_decode_packed() with an explicit workspace.
+ */
+int rs_decode_packed_ws(rs_workspace *ws, const uint8_t *recv_pack,
+                        uint8_t *code_pack, uint8_t *info_pack);
+
+/**
+ * @brief Errors-and-erasures decoding of a shortened codeword, in place.
+ *
+ * Symbols at eras_pos are treated as unknown: ρ = n_eras erasures and
+ * e errors are corrected while 2e + ρ ≤ T. As with rs_decode_sym(), a word
+ * the decoder gives up on is left unmodified; unlike it, an error located
+ * in the shortened zone makes the word uncorrectable.
+ *
+ * @param code_sym Received symbols (Ns entries), corrected on return.
+ * @param eras_pos Distinct erased positions 0..Ns-1 (NULL if n_eras = 0).
+ * @param n_eras   Number of erasures, 0..T.
+ *
+ * @return Number of corrected positions (erasures included; an erased
+ *         symbol that was right counts too), 0 if the word is clean,
+ *         -1 if uncorrectable, RS_DECODE_MISCORRECTED if verification
+ *         rejected the correction.
+ */
+int rs_decode_sym_erasures(rs_sym_t *code_sym, const int *eras_pos,
+                           int n_eras);
+
+/**
+ * @brief rs_decode_sym_erasures() with an explicit workspace.
+ */
+int rs_decode_sym_erasures_ws(rs_workspace *ws, rs_sym_t *code_sym,
+                              const int *eras_pos, int n_eras);
+
+/* -------------------------------------------------------------------------
+ * Stage-level API
+ *
+ * rs_decode_sym() == rs_decode_syndromes() followed, for dirty codewords
+ * only, by rs_decode_correct(). The stages only read the tables built by
+ * rs_gf_init(), so different codewords may be processed concurrently.
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Stage 1: compute the T syndromes of a received codeword.
+ *
+ * @param code_sym Received symbols (Ns entries).
+ * @param synd     Output syndromes (T entries).
+ *
+ * @return 0 if all syndromes are zero (clean codeword), 1 otherwise.
+ */
+int rs_decode_syndromes(const rs_sym_t *code_sym, rs_sym_t *synd);
+
+/**
+ * @brief Stage 2: BM → Chien → error magnitudes → correction.
+ *
+ * @param code_sym Received symbols (Ns entries), corrected in place.
+ * @param synd     Syndromes from rs_decode_syndromes().
+ *
+ * @return Same status as rs_decode().
+ */
+int rs_decode_correct(rs_sym_t *code_sym, const rs_sym_t *synd);
+
+/**
+ * @brief rs_decode_correct() with an explicit workspace.
+ */
+int rs_decode_correct_ws(rs_workspace *ws, rs_sym_t *code_sym,
+                         const rs_sym_t *synd);
+
+/**
+ * @brief Berlekamp–Massey step of stage 2 on its own.
+ *
+ * For alternative Chien/magnitude back ends (rs_fft.h).
+ *
+ * @param synd  Syndromes (T entries).
+ * @param sigma Output error-locator σ(x), t + 1 coefficients, σ(0) = 1.
+ *
+ * @return Locator degree L (L > t: uncorrectable).
+ */
+int rs_decode_locator_ws(rs_workspace *ws, const rs_sym_t *synd,
+                         rs_sym_t *sigma);
+
+/* -------------------------------------------------------------------------
+ * Range-level API (intra-codeword parallelism, rs_split.h)
+ *
+ * Stage 1 and the Chien search split over disjoint index ranges; the
+ * ranges of one codeword may be processed concurrently.
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Partial syndromes of received symbols [n0, n1).
+ *
+ * XOR-ing the partials of ranges that cover 0..Ns-1 gives the output of
+ * rs_decode_syndromes().
+ *
+ * @param synd Output partial syndromes (T entries).
+ */
+void rs_decode_syndromes_range(const rs_sym_t *code_sym, int n0, int n1,
+                               rs_sym_t *synd);
+
+/**
+ * @brief Chien search over parent positions [i0, i1).
+ *
+ * @param sigma     Error locator from rs_decode_locator_ws().
+ * @param L         Locator degree (≤ t).
+ * @param error_pos Output roots in ascending order (max_roots entries).
+ * @param max_roots Stop after this many roots.
+ *
+ * @return Number of roots found.
+ */
+int rs_decode_chien_range(const rs_sym_t *sigma, int L, int i0, int i1,
+                          int *error_pos, int max_roots);
+
+/**
+ * @brief Solve the error magnitudes at error_pos and correct code_sym.
+ *
+ * Does nothing unless 0 < count ≤ t; positions inside the shortened zone
+ * are dropped.
+ *
+ * @return 0, or RS_DECODE_MISCORRECTED if verification is enabled and
+ *         rejected the correction (code_sym unmodified).
+ */
+int rs_decode_magnitudes_ws(rs_workspace *ws, rs_sym_t *code_sym,
+                            const rs_sym_t *synd, const int *error_pos,
+                            int count);
+
+/* -------------------------------------------------------------------------
+ * Streaming API (symbols decoded as they arrive)
+ *
+ * The receiver writes a codeword into its buffer as the symbols come in
+ * and announces each batch with rs_decode_stream_push(). Arrived symbols
+ * are folded into the T syndromes (the partial syndromes of their index
+ * range, as rs_decode_syndromes_range()) every RS_DECODE_STREAM_DIV-th of
+ * the codeword, so when the last symbol arrives at most that share of the
+ * syndrome stage is left. rs_decode_stream_finish() completes it, checks
+ * the syndromes and runs BM → Chien → magnitudes only on a dirty word.
+ * Results are identical to rs_decode_sym_ws(); the syndrome backend setting
+ * does not apply.
+ *
+ *   rs_decode_stream st;
+ *   rs_decode_stream_begin(&st, ws, frame);
+ *   while (rs_decode_stream_push(&st, n) > 0)   (n more symbols in frame)
+ *     ...
+ *   status = rs_decode_stream_finish(&st);
+ * ------------------------------------------------------------------------- */
+
+/* Symbols are folded in batches of Ns / RS_DECODE_STREAM_DIV, clamped to
+ * [RS_DECODE_STREAM_MIN, RS_DECODE_STREAM_MAX]; for m > 8 at least
+ * RS_DECODE_STREAM_MIN_WIDE, which the vector kernels need to pay off */
+#define RS_DECODE_STREAM_DIV 16
+#define RS_DECODE_STREAM_MIN 32
+#define RS_DECODE_STREAM_MIN_WIDE 512
+#define RS_DECODE_STREAM_MAX 4096
+
+typedef struct {
+  rs_workspace *ws;   /* Syndromes accumulate in ws->synd */
+  rs_sym_t *code_sym; /* Codeword buffer (Ns symbols) */
+  int pos;            /* Symbols arrived (0..Ns) */
+  int done;           /* Symbols folded into the syndromes (≤ pos) */
+  int batch;          /* Fold once pos - done reaches this */
+} rs_decode_stream;
+
+/**
+ * @brief Start a codeword (the stream may be reused for the next one).
+ *
+ * @param ws       Workspace sized for the current code, used by the
+ *                 stream until rs_decode_stream_finish().
+ * @param code_sym Buffer the Ns received symbols are written into.
+ *
+ * @return 0, or -1 if ws does not fit the current code (the stream's push
+ *         and finish then fail too).
+ */
+int rs_decode_stream_begin(rs_decode_stream *st, rs_workspace *ws,
+                           rs_sym_t *code_sym);
+
+/**
+ * @brief The next n symbols of the codeword (code_sym[pos .. pos + n))
+ *        have arrived.
+ *
+ * @return Symbols still expected (0: the codeword is complete), or -1 if
+ *         n is negative or exceeds that, or the workspace no longer fits
+ *         the code (nothing is added).
+ */
+int rs_decode_stream_push(rs_decode_stream *st, int n);
+
+/**
+ * @brief Finish the codeword: complete and check the syndromes, correct
+ *        code_sym in place if dirty.
+ *
+ * @return Same status as rs_decode_sym(), or RS_DECODE_INCOMPLETE if
+ *         fewer than Ns symbols were pushed (code_sym unmodified).
  */
-void rs_decode(const int *recv_bits, int *code_bits, int *info_bits);
+int rs_decode_stream_finish(rs_decode_stream *st);
 
 #endif /* RS_DECODER_H */
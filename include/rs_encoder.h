@@ -22,6 +22,9 @@
 #ifndef RS_ENCODER_H
 #define RS_ENCODER_H
 
+#include "rs_workspace.h"
+#include <stdint.h>
+
 /**
  * @brief Systematic Reed–Solomon encoding.
  *
@@ -31,7 +34,60 @@
  * Requirements:
  *   - rs_gf_init() must be called before using this function.
  *   - inf_bits and code_bits must be valid, non-overlapping buffers.
+ *
+ * Scratch memory comes from the calling thread's default workspace.
  */
 void rs_encode(const int *inf_bits, int *code_bits);
 
+/**
+ * @brief rs_encode() with an explicit workspace (no allocation).
+ *
+ * @param ws Workspace sized for the current code (rs_workspace.h).
+ *
+ * @return 0, or -1 if ws does not fit the current code
+ *         (rs_workspace_check()); nothing is written then.
+ */
+int rs_encode_ws(rs_workspace *ws, const int *inf_bits, int *code_bits);
+
+/**
+ * @brief Systematic Reed–Solomon encoding on GF symbols.
+ *
+ * @param info_sym Input information symbols (K entries).
+ * @param code_sym Output codeword symbols (K + T entries).
+ *                 May alias info_sym (parity is appended in place).
+ *
+ * Needs no scratch memory.
+ */
+void rs_encode_sym(const rs_sym_t *info_sym, rs_sym_t *code_sym);
+
+/**
+ * @brief Parity symbols only: the remainder of u(x)·x^T divided by g(x).
+ *
+ * @param info_sym Input information symbols (K entries).
+ * @param parity   Output parity symbols (T entries), not overlapping
+ *                 info_sym.
+ *
+ * The register division behind rs_encode_sym() (same kernels). Re-encoding
+ * the information part of a received word and adding its received parity
+ * gives the word's remainder modulo g(x), which the decoder's remainder
+ * syndrome backend evaluates (rs_decode_set_syndrome_method()).
+ */
+void rs_encode_parity(const rs_sym_t *info_sym, rs_sym_t *parity);
+
+/**
+ * @brief Systematic Reed–Solomon encoding on packed buffers (rs_pack.h).
+ *
+ * @param info_pack Input  rs_packed_bytes(K) bytes.
+ * @param code_pack Output rs_packed_bytes(K + T) bytes.
+ */
+void rs_encode_packed(const uint8_t *info_pack, uint8_t *code_pack);
+
+/**
+ * @brief rs_encode_packed() with an explicit workspace.
+ *
+ * @return 0, or -1 if ws does not fit the current code.
+ */
+int rs_encode_packed_ws(rs_workspace *ws, const uint8_t *info_pack,
+                        uint8_t *code_pack);
+
 #endif /* RS_ENCODER_H */
@@ -0,0 +1,86 @@
+/**
+ * @file rs_fft.h
+ * @brief Additive-FFT encoder and decoder front end for long RS codes.
+ *
+ * The LFSR encoder (rs_encoder.c) and the syndrome / Chien loops of the
+ * decoder (rs_decoder.c) cost O(N·T) field operations per codeword, which
+ * dominates for GF(2^16) codes of tens of thousands of symbols. This module
+ * computes the same quantities with polynomial products carried out by the
+ * Lin–Chung–Han additive FFT (novel polynomial basis):
+ *
+ *   - Syndromes S_i = r(β^{b+i}) and the Chien values σ(β^{-i}) (β, b: the
+ *     generator roots of rs_gf.h) are geometric
+ *     evaluations, turned into one Toeplitz product each by the chirp
+ *     identity z^{ij} = w^{i^2} w^{j^2} w^{-(i-j)^2}, w^2 = z.
+ *   - Encoding computes the syndromes of the information part and fills
+ *     the T parity positions as erasures (Forney with the fixed erasure
+ *     locator of the parity positions).
+ *   - Error magnitudes use Forney's formula instead of the t×t linear
+ *     system, O(T·L).
+ *
+ * Products cost O(n log^2 n) for transform length n ≤ 2^m (the basis change
+ * dominates the O(n log n) butterflies), so encoding, syndromes and Chien
+ * search are quasi-linear in N. Berlekamp–Massey (rs_decoder.c) and the key
+ * equation stay O(T^2).
+ *
+ * Codewords, syndromes and decoder status are identical to rs_encode_sym(),
+ * rs_decode_syndromes() and rs_decode_sym(); only the cost differs. The
+ * quadratic code remains faster for small T — run rs_bench_fft to find the
+ * crossover for a given code.
+ *
+ * Requirements:
+ *   - rs_gf_init(m, N, K, T) must be called before rs_fft_create(), and the
+ *     object must be re-created after the code changes.
+ *   - An rs_fft object holds scratch memory and must not be used by two
+ *     threads at the same time.
+ *   - Dual-basis codes (rs_gf_init_ccsds()) are not supported; they are
+ *     short and the quadratic codec is the faster path for them anyway.
+ */
+
+#ifndef RS_FFT_H
+#define RS_FFT_H
+
+#include "rs_gf.h"
+
+typedef struct rs_fft rs_fft;
+
+/**
+ * @brief Build transform tables and product plans for the current code.
+ *
+ * Costs O(T^2 + N log^2 N) once per code (erasure locator of the parity
+ * positions, transformed chirp kernels).
+ *
+ * @return Handle, or NULL on allocation failure or a dual-basis code.
+ */
+rs_fft *rs_fft_create(void);
+
+/**
+ * @brief Release an object returned by rs_fft_create().
+ */
+void rs_fft_destroy(rs_fft *f);
+
+/**
+ * @brief Systematic encoder, same output as rs_encode_sym().
+ *
+ * @param info_sym Input symbols (K entries).
+ * @param code_sym Output symbols (K + T entries), may alias info_sym.
+ */
+void rs_fft_encode_sym(rs_fft *f, const rs_sym_t *info_sym,
+                       rs_sym_t *code_sym);
+
+/**
+ * @brief Syndromes, same output as rs_decode_syndromes().
+ *
+ * @return 0 if all syndromes are zero (clean codeword), 1 otherwise.
+ */
+int rs_fft_syndromes(rs_fft *f, const rs_sym_t *code_sym, rs_sym_t *synd);
+
+/**
+ * @brief Decode a shortened codeword in place.
+ *
+ * @return Same status as rs_decode_sym(). On failure (-1) the received
+ *         symbols are left unmodified.
+ */
+int rs_fft_decode_sym(rs_fft *f, rs_sym_t *code_sym);
+
+#endif /* RS_FFT_H */
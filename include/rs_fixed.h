@@ -0,0 +1,60 @@
+/**
+ * @file rs_fixed.h
+ * @brief Bounded-latency decoder with a data-independent schedule.
+ *
+ * rs_decode_sym() adapts its work to the received word: it stops after the
+ * syndromes of a clean codeword, Berlekamp–Massey branches on every
+ * discrepancy, the Chien search stops after L + 1 roots and the magnitude
+ * system has one row per error. Its latency therefore ranges from the
+ * syndrome cost alone to several times that.
+ *
+ * rs_decode_sym_fixed() runs the same decoder on a schedule fixed by the
+ * code alone:
+ *
+ *   - Syndromes   : all N symbols × T roots, always.
+ *   - Locator     : inversionless Berlekamp–Massey, exactly T iterations
+ *                   over T + 1 coefficients; the register update is chosen
+ *                   with masks instead of branches.
+ *   - Chien       : every parent position 0..Np-1 with t + 1 terms; roots
+ *                   are recorded without branching.
+ *   - Magnitudes  : Forney for all t root slots; slots without a root are
+ *                   computed and discarded by a mask.
+ *
+ * Field products mask the zero case instead of branching on it, so the
+ * instruction stream is identical for every codeword. Where the rs_gf16
+ * multiply-by-constant kernel is a vector one, syndromes and Chien search
+ * run on it (no table lookups at all); elsewhere table lookups hit
+ * data-dependent addresses, which leaves a small, cache-dependent spread.
+ * rs_bench_fixed measures it per code (min / median / p99 / max for 0..T
+ * errors). A clean word costs more than with the adaptive decoder, a word
+ * with many errors less: the mode trades average for worst-case latency.
+ *
+ * Results match rs_decode_sym() for every word; one the decoder gives up
+ * on (-1) is left unmodified by both.
+ *
+ * Requirements:
+ *   - rs_gf_init() (any variant) must be called before, and not
+ *     concurrently.
+ */
+
+#ifndef RS_FIXED_H
+#define RS_FIXED_H
+
+#include "rs_workspace.h"
+
+/**
+ * @brief Decode one shortened codeword in place on the fixed schedule.
+ *
+ * @param code_sym Received symbols (Ns entries), corrected on return.
+ *
+ * @return Number of corrected symbols, 0 if clean, -1 if uncorrectable
+ *         (code_sym unmodified).
+ */
+int rs_decode_sym_fixed(rs_sym_t *code_sym);
+
+/**
+ * @brief rs_decode_sym_fixed() with an explicit workspace.
+ */
+int rs_decode_sym_fixed_ws(rs_workspace *ws, rs_sym_t *code_sym);
+
+#endif /* RS_FIXED_H */
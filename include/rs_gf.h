@@ -3,7 +3,9 @@
  * @brief Finite Field (GF(2^m)) routines for Reed–Solomon encoding/decoding.
  *
  * This header declares:
- *   - Global RS parameters (m, N, K, T)
+ *   - Build profile and symbol storage type (rs_sym_t)
+ *   - Global RS parameters (m, N, K, T) and code options (field
+ *     polynomial, generator roots, symbol basis)
  *   - GF(2^m) tables (exp/log)
  *   - Generator polynomial storage
  *   - Per-symbol bit decomposition table
@@ -20,9 +22,37 @@
 
 /* -------------------------------------------------------------------------
  * Configuration
+ *
+ * Build profiles:
+ *   default     : RS_M_MAX = 16, doubled exp table, bit lookup table
+ *   RS_COMPACT  : embedded profile (make PROFILE=compact), implies
+ *                 RS_M_MAX = 8; no bit lookup table (symbols are split
+ *                 with shifts) and a single 2^m-entry exp table
+ *
+ * Symbols are stored as rs_sym_t: uint8_t when RS_M_MAX <= 8, which halves
+ * every table, workspace and symbol buffer.
  * ------------------------------------------------------------------------- */
+#if defined(RS_COMPACT) && !defined(RS_M_MAX)
 #define RS_M_MAX 8
-#define RS_GF_MAX (1 << RS_M_MAX) /* Maximum GF size = 2^8 = 256 */
+#endif
+#ifndef RS_M_MAX
+#define RS_M_MAX 16 /* Largest supported m (override with -DRS_M_MAX=...) */
+#endif
+#define RS_GF_MAX (1 << RS_M_MAX) /* Maximum GF size = 2^RS_M_MAX */
+
+#if RS_M_MAX <= 8
+typedef uint8_t rs_sym_t;
+#else
+typedef uint16_t rs_sym_t;
+#endif
+
+/* exp table entries: doubled unless compact (α^(Np) = 1 is kept either way
+ * so that rs_gf_inv(1) needs no special case) */
+#ifdef RS_COMPACT
+#define RS_GF_EXP_SIZE RS_GF_MAX
+#else
+#define RS_GF_EXP_SIZE (2 * RS_GF_MAX)
+#endif
 
 /* -------------------------------------------------------------------------
  * Global Reed–Solomon parameters (set by rs_gf_init)
@@ -34,13 +64,56 @@ extern int rs_S;  /* Shortening amount = Np - N */
 extern int rs_K;  /* Number of information symbols */
 extern int rs_T;  /* Number of parity symbols (generator degree) */
 
+extern unsigned rs_code_gen; /* Incremented by every successful rs_gf_init */
+
+/* -------------------------------------------------------------------------
+ * Code options (set by rs_gf_init_params)
+ *
+ * Roots follow the CCSDS / textbook convention, in which the first
+ * transmitted symbol is the highest-degree coefficient:
+ *     g(x) = Π_{i<T} (x - α^{prim·(fcr + i)})
+ * Internally a codeword is read lowest degree first (symbol n ↔ x^{S+n}),
+ * which turns root α^e into α^{-e}; the codec therefore evaluates at
+ * α^{step·(fcr + i)} with step = Np - prim (rs_root_step).
+ * rs_gf_init() keeps the codec's original code: fcr = 0, prim = Np - 1,
+ * i.e. step 1 and internal roots α^0..α^(T-1).
+ * ------------------------------------------------------------------------- */
+extern uint32_t rs_poly;  /* Field polynomial, including the x^m term */
+extern int rs_fcr;        /* First consecutive root (0 ≤ fcr < Np) */
+extern int rs_prim;       /* Root spacing (coprime to Np) */
+extern int rs_root_step;  /* Internal root step = Np - prim */
+
 /* -------------------------------------------------------------------------
  * GF tables and polynomial data
+ *
+ * Read-only views: they point at the process's own tables built by
+ * rs_gf_init(), or into a table file mapped by rs_table_load().
  * ------------------------------------------------------------------------- */
-extern uint16_t rs_gf_exp[2 * RS_GF_MAX];       /* Exponential table */
-extern uint16_t rs_gf_log[RS_GF_MAX];           /* Logarithm table */
-extern uint16_t rs_generator[RS_GF_MAX];        /* Generator polynomial g(x) */
-extern int rs_symbol_bits[RS_GF_MAX][RS_M_MAX]; /* Bit representation table */
+extern const rs_sym_t *rs_gf_exp;    /* Exponential table [RS_GF_EXP_SIZE] */
+extern const rs_sym_t *rs_gf_log;    /* Logarithm table [RS_GF_MAX] */
+extern const rs_sym_t *rs_generator; /* Generator polynomial g(x) [T + 1] */
+extern const rs_sym_t *rs_generator_log; /* log g_j, rs_Np for 0 [T + 1] */
+#ifndef RS_COMPACT
+extern const int (*rs_symbol_bits)[RS_M_MAX]; /* Bit representation table */
+#endif
+
+#if RS_M_MAX > 8
+/* Split rows of g(x) for the wide-field encoder (m > 8), NULL for m ≤ 8 or
+ * T > RS_GEN_SPLIT_T_MAX: row 16·i + v holds (v << 4i)·g_{j+1}, j < T, so
+ * a feedback symbol's product with g is the sum of one row per nibble.
+ * Rows are RS_GEN_SPLIT_STRIDE(T) long, zero past T. [64 × stride] */
+#define RS_GEN_SPLIT_T_MAX 256
+#define RS_GEN_SPLIT_STRIDE(T) (((T) + 7) & ~7)
+extern const rs_sym_t *rs_generator_split;
+#endif
+
+/* Symbol basis conversion, NULL unless the code uses the dual basis.
+ * Every symbol crossing the codec API (encoder input/output, decoder
+ * input/output) is then in the dual basis; the codec converts on the fly
+ * in its own loops. Both maps are GF(2)-linear. [RS_DUAL_SIZE] */
+#define RS_DUAL_SIZE 256
+extern const rs_sym_t *rs_dual_to_conv;
+extern const rs_sym_t *rs_conv_to_dual;
 
 /* -------------------------------------------------------------------------
  * GF(2^m) arithmetic primitives
@@ -71,20 +144,66 @@ uint16_t rs_gf_pow(uint16_t base, int power);
  */
 uint16_t rs_gf_inv(uint16_t a);
 
+/**
+ * @brief Exponent of the i-th internal generator root,
+ *        rs_root_step·(rs_fcr + i) mod Np (syndrome S_i = r(α^e)).
+ */
+int rs_gf_root_log(int i);
+
 /* -------------------------------------------------------------------------
  * Initialization
  * ------------------------------------------------------------------------- */
 
+/**
+ * @brief Rebuild rs_generator_log (and rs_generator_split) from
+ *        rs_generator (rs_gf_init() calls it; table files carry both).
+ */
+void rs_gf_generator_log_update(void);
+
 /**
  * @brief Initialize GF(2^m) and construct RS generator polynomial.
  *
- * @param m  GF size parameter (1–8), GF size = 2^m
- * @param N  Codeword length (shortened)
+ * @param m  GF size parameter (1–RS_M_MAX), GF size = 2^m
+ * @param N  Codeword length (shortened), N = K + T ≤ 2^m - 1
  * @param K  Information symbol length
  * @param T  Parity symbol length (degree of generator polynomial)
  *
  * @return 0 on success, negative on failure.
+ *
+ * Workspaces (rs_workspace.h) created for a previous code must be
+ * re-created after the code changes.
  */
 int rs_gf_init(int m, int N, int K, int T);
 
+/* CCSDS 131.0 Reed–Solomon: x^8 + x^7 + x^2 + x + 1, fcr 112, spacing 11,
+ * Berlekamp dual-basis symbols */
+#define RS_CCSDS_POLY 0x187
+#define RS_CCSDS_FCR 112
+#define RS_CCSDS_PRIM 11
+
+typedef struct {
+  uint32_t poly;  /* Field polynomial with the x^m term, 0 = default for m */
+  int fcr;        /* First consecutive root (reduced mod Np) */
+  int prim;       /* Root spacing, coprime to 2^m - 1 */
+  int dual_basis; /* 1 = CCSDS dual-basis symbols (m = 8, poly 0x187) */
+} rs_code_params;
+
+/**
+ * @brief rs_gf_init() with an explicit field polynomial, generator roots
+ *        and symbol basis.
+ *
+ * @param p  Code options; NULL selects the rs_gf_init() defaults.
+ *
+ * @return 0 on success, negative if the polynomial is not primitive, the
+ *         spacing is not coprime to 2^m - 1, or the dual basis is requested
+ *         for a field other than the CCSDS one.
+ */
+int rs_gf_init_params(int m, int N, int K, int T, const rs_code_params *p);
+
+/**
+ * @brief CCSDS code RS(N, K) over GF(2^8), dual basis (N ≤ 255; N < 255
+ *        is the CCSDS virtual fill, i.e. shortening).
+ */
+int rs_gf_init_ccsds(int N, int K);
+
 #endif /* RS_GF_H */
@@ -0,0 +1,116 @@
+/**
+ * @file rs_gf16.h
+ * @brief Vector GF(2^16) multiplication kernels (split tables, carry-less
+ *        multiply) for the wide fields 8 < m ≤ 16.
+ *
+ * Above m = 8 the log/exp tables outgrow L1 (384 KB for m = 16), and every
+ * scalar product costs three lookups that miss it. The kernels here need
+ * no field-sized table:
+ *
+ *   - Split tables: x ↦ c·x is GF(2)-linear, so c·x is the sum of
+ *     c·(x_i << 4i) over the four nibbles x_i of x. The 4 × 16 products of
+ *     a constant, split into low and high bytes, are eight PSHUFB operands:
+ *     16 (SSSE3) or 32 (AVX2) symbols per eight shuffles. The portable form
+ *     ("split") reads the same 128-byte tables one symbol at a time.
+ *   - Carry-less multiply (PCLMULQDQ): operands packed 32 bits apart give
+ *     two products per instruction, reduced modulo the field polynomial P
+ *     by Barrett: q = ⌊⌊p / x^m⌋ · μ / x^m⌋ with μ = ⌊x^2m / P⌋, then
+ *     r = p + q·P (two more carry-less products). Needs no per-constant
+ *     tables, so it also serves element-wise products.
+ *   - Log/exp tables ("table"): the codec's scalar reference.
+ *
+ * Multiplication by a constant (with its Horner and geometric-sequence
+ * forms for syndromes and Chien search) and element-wise multiplication
+ * each run the kernel that was fastest in a short timing run at first use
+ * (rs_gf16_kernel()); all kernels give identical results.
+ *
+ * Requirements:
+ *   - rs_gf_init(m, N, K, T) must be called first; constants prepared by
+ *     rs_gf16_const_init() are only valid for the field they were built
+ *     in. Symbols are uint16_t (< 2^m) whatever the build profile.
+ */
+
+#ifndef RS_GF16_H
+#define RS_GF16_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Symbols per block of rs_gf16_horner() / rs_gf16_geom() */
+#define RS_GF16_LANES 32
+
+/* A constant c prepared for the multiply-by-constant kernels */
+typedef struct {
+  uint8_t lo[4][16];  /* low bytes of c·(v << 4i), nibble i, v < 16 */
+  uint8_t hi[4][16];  /* high bytes */
+  uint16_t t[4][16];  /* full products (portable kernel) */
+  uint16_t c, log_c;  /* c and log c (table kernel) */
+  uint32_t mu;        /* ⌊x^2m / P⌋ (carry-less kernel) */
+} rs_gf16_const;
+
+/* Operations whose kernel is chosen separately */
+typedef enum {
+  RS_GF16_CONST, /* multiply by a constant, Horner, geometric sequence */
+  RS_GF16_MUL    /* element-wise product */
+} rs_gf16_op;
+
+/**
+ * @brief Prepare c for the multiply-by-constant kernels.
+ */
+void rs_gf16_const_init(rs_gf16_const *k, uint16_t c);
+
+/**
+ * @brief dst[i] = c·a[i], i < n (dst may equal a).
+ */
+void rs_gf16_mul_const(const rs_gf16_const *k, const uint16_t *a,
+                       uint16_t *dst, size_t n);
+
+/**
+ * @brief Horner over blocks of RS_GF16_LANES symbols with x^LANES = c:
+ *        acc ← c·acc + a[t·LANES ..] for t = blocks - 1 down to 0.
+ *
+ * Lane l then holds Σ_t a[t·LANES + l]·c^t, and a(x) = Σ_l acc[l]·x^l.
+ *
+ * @param acc RS_GF16_LANES symbols, in: the initial value (the top partial
+ *            block), out: the result.
+ */
+void rs_gf16_horner(const rs_gf16_const *k, const uint16_t *a,
+                    size_t blocks, uint16_t *acc);
+
+/**
+ * @brief Geometric blocks: out[t·LANES ..] += v, v ← c·v, t < blocks.
+ *
+ * @param v RS_GF16_LANES symbols, advanced by c per block (on return: the
+ *          vector of block number "blocks").
+ */
+void rs_gf16_geom(const rs_gf16_const *k, uint16_t *v, uint16_t *out,
+                  size_t blocks);
+
+/**
+ * @brief c[i] = a[i]·b[i], i < n (c may alias a or b).
+ */
+void rs_gf16_mul_vec(const uint16_t *a, const uint16_t *b, uint16_t *c,
+                     size_t n);
+
+/**
+ * @brief Name of the kernel running an operation: "avx2", "ssse3",
+ *        "clmul", "split" or "table".
+ */
+const char *rs_gf16_kernel(rs_gf16_op op);
+
+/**
+ * @brief 1 if the multiply-by-constant kernel is a vector one (the codec
+ *        takes the rs_gf16 paths only then).
+ */
+int rs_gf16_vector(void);
+
+/**
+ * @brief Force the kernel of an operation (NULL: the measured choice), for
+ *        benchmarks and tests. Not thread-safe against running kernels.
+ *
+ * @return 0, or -1 if the name is unknown, does not implement the
+ *         operation or the CPU lacks the feature.
+ */
+int rs_gf16_set_kernel(rs_gf16_op op, const char *name);
+
+#endif /* RS_GF16_H */
@@ -0,0 +1,85 @@
+/**
+ * @file rs_pack.h
+ * @brief Packed byte buffers ↔ GF(2^m) symbols.
+ *
+ * Packed format (defaults: RS_BIT_LSB_FIRST, RS_PACK_DENSE):
+ *   Symbol i occupies bits [i*m, (i+1)*m) of a little-endian bit stream:
+ *   bit b of the stream is bit (b % 8) of byte (b / 8), and symbol bits
+ *   are stored LSB-first, the same ordering as the int-per-bit API.
+ *   For m = 8 a packed buffer is simply one byte per symbol.
+ *
+ * Wire format options (rs_io_set_format()):
+ *   RS_BIT_MSB_FIRST : big-endian bit stream: bit b of the stream is bit
+ *                      7 - (b % 8) of byte (b / 8), and each symbol is sent
+ *                      MSB first (e.g. 10-bit symbols a, b, c, d fill five
+ *                      bytes a9..a2 | a1 a0 b9..b4 | ...). The int-per-bit
+ *                      API then expects bits[0] to be the symbol's MSB.
+ *   RS_PACK_ALIGNED  : one symbol per ceil(m / 8) bytes, value right-
+ *                      justified, unused high bits written as zero and
+ *                      ignored on input; for m > 8 the two bytes are little-
+ *                      endian with RS_BIT_LSB_FIRST, big-endian with
+ *                      RS_BIT_MSB_FIRST.
+ *   With m = 8 all four formats are one byte per symbol.
+ *
+ * The format applies to every packed and int-per-bit entry point (encoder,
+ * decoder, batch, pipeline, service) and is converted inside their input /
+ * output loops, so buffers in a wire format need no separate repacking
+ * pass. It is process-wide and must not change while other threads are
+ * encoding or decoding.
+ *
+ * A packed codeword of n symbols takes rs_packed_bytes(n) bytes; unused
+ * bits of the last byte are written as zero.
+ */
+
+#ifndef RS_PACK_H
+#define RS_PACK_H
+
+#include "rs_gf.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* Symbol bit order on the wire */
+#define RS_BIT_LSB_FIRST 0
+#define RS_BIT_MSB_FIRST 1
+
+/* Symbol packing */
+#define RS_PACK_DENSE 0   /* m bits per symbol, across byte boundaries */
+#define RS_PACK_ALIGNED 1 /* ceil(m / 8) bytes per symbol */
+
+/**
+ * @brief Select the wire format of packed buffers and bit arrays.
+ *
+ * @param bit_order RS_BIT_LSB_FIRST or RS_BIT_MSB_FIRST.
+ * @param packing   RS_PACK_DENSE or RS_PACK_ALIGNED.
+ *
+ * @return 0 on success, -1 on an invalid argument (format unchanged).
+ */
+int rs_io_set_format(int bit_order, int packing);
+
+/**
+ * @brief Current wire format (either pointer may be NULL).
+ */
+void rs_io_get_format(int *bit_order, int *packing);
+
+/**
+ * @brief Bytes needed for n_sym packed symbols of the current field.
+ */
+size_t rs_packed_bytes(int n_sym);
+
+/**
+ * @brief rs_packed_bytes() for field m and packing, whether or not they
+ *        are current.
+ */
+size_t rs_packed_bytes_for(int m, int packing, int n_sym);
+
+/**
+ * @brief Unpack n_sym symbols from a packed buffer.
+ */
+void rs_unpack_symbols(const uint8_t *in, rs_sym_t *sym, int n_sym);
+
+/**
+ * @brief Pack n_sym symbols into a packed buffer.
+ */
+void rs_pack_symbols(const rs_sym_t *sym, uint8_t *out, int n_sym);
+
+#endif /* RS_PACK_H */
@@ -0,0 +1,74 @@
+/**
+ * @file rs_pipeline.h
+ * @brief Stage-pipelined Reed–Solomon stream decoder.
+ *
+ * The pipeline splits decoding into the two stages exposed by rs_decoder.h
+ * and runs each stage on its own set of threads:
+ *
+ *   caller ──► [syndrome workers] ──SPSC──► [solver workers] ──► completion
+ *
+ *   - Syndrome workers compute the T syndromes of every incoming codeword.
+ *     Clean codewords complete immediately; only dirty ones are forwarded.
+ *   - Solver workers run BM → Chien → error magnitudes → correction.
+ *   - Every syndrome/solver pair is connected by a bounded lock-free
+ *     single-producer/single-consumer queue.
+ *   - The calling thread feeds codewords and retires them strictly in
+ *     input order. At most `window` codewords are in flight, so a slow
+ *     stage throttles the feeder (backpressure) instead of growing memory.
+ *
+ * Requirements:
+ *   - rs_gf_init(m, N, K, T) must be called before rs_pipeline_create().
+ */
+
+#ifndef RS_PIPELINE_H
+#define RS_PIPELINE_H
+
+#include "rs_gf.h"
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct rs_pipeline rs_pipeline;
+
+/**
+ * @brief Completion callback, invoked in input order from the calling thread.
+ *
+ * @param user   User pointer passed to rs_pipeline_decode().
+ * @param frame  Frame index within the current call.
+ * @param status Decoder status (see rs_decode()).
+ */
+typedef void (*rs_pipeline_done_fn)(void *user, size_t frame, int status);
+
+/**
+ * @brief Create a decoding pipeline for the current RS code.
+ *
+ * @param n_synd_threads  Number of syndrome-stage threads (>= 1).
+ * @param n_solve_threads Number of solver-stage threads (>= 1).
+ * @param window          Maximum codewords in flight (rounded up to a
+ *                        power of two, >= 2).
+ *
+ * @return Pipeline handle, or NULL on failure.
+ */
+rs_pipeline *rs_pipeline_create(int n_synd_threads, int n_solve_threads,
+                                int window);
+
+/**
+ * @brief Destroy a pipeline created by rs_pipeline_create().
+ */
+void rs_pipeline_destroy(rs_pipeline *p);
+
+/**
+ * @brief Decode a stream of shortened codewords in place.
+ *
+ * @param p        Pipeline handle.
+ * @param code_sym n_frames * Ns received symbols, corrected in place.
+ * @param n_frames Number of codewords.
+ * @param status   Optional per-frame decoder status (n_frames entries).
+ * @param done     Optional in-order completion callback.
+ * @param user     User pointer for the callback.
+ *
+ * @return 0 on success, negative on failure (threads could not start).
+ */
+int rs_pipeline_decode(rs_pipeline *p, rs_sym_t *code_sym, size_t n_frames,
+                       int *status, rs_pipeline_done_fn done, void *user);
+
+#endif /* RS_PIPELINE_H */
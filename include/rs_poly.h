@@ -0,0 +1,230 @@
+/**
+ * @file rs_poly.h
+ * @brief Polynomial arithmetic over the current GF(2^m).
+ *
+ * A polynomial of length n is an array a[0..n-1] of rs_sym_t, lowest degree
+ * first (degree < n; leading zeros are allowed). All routines use the
+ * exp/log tables of rs_gf.c and keep one operand in the log domain, so a
+ * field product costs one addition and one table lookup.
+ *
+ *   - Kernels       : scale-and-add (a + k·b), with b given as logarithms
+ *                     when it is reused (generator, matrix rows), and single
+ *                     product coefficients (BM discrepancy)
+ *   - Multiplication: schoolbook below RS_POLY_KARATSUBA terms, Karatsuba
+ *                     above
+ *   - Division      : schoolbook, or by a divisor prepared once with the
+ *                     Newton inverse of its reversal (two products per
+ *                     division)
+ *   - Euclid        : gcd and extended Euclid stopped at a remainder degree
+ *                     (key equation: x^T, S(x) → Ω(x), σ(x))
+ *   - Evaluation    : Horner, any point set, and geometric point sets
+ *                     α^{e0 + k·step} (syndromes, Chien search) with the
+ *                     term-update method; for m > 8 on the vector
+ *                     multiply-by-constant kernels of rs_gf16.h
+ *   - Construction  : Π (x - r_i) by a product tree
+ *
+ * The generator polynomial (rs_gf.c), the encoder register and the decoder
+ * stages (rs_decoder.c) are built on these routines; rs_bench_poly compares
+ * the algorithms. Quasi-linear evaluation for long codes is in rs_fft.h.
+ *
+ * Routines that need scratch memory take it from the caller, sized by the
+ * matching *_scratch() function, and never allocate (except
+ * rs_poly_divisor_init()). Outputs must not overlap inputs unless stated.
+ *
+ * Requirements:
+ *   - rs_gf_init(m, N, K, T) must be called first; logarithm arrays and
+ *     prepared divisors are only valid for the field they were built in.
+ */
+
+#ifndef RS_POLY_H
+#define RS_POLY_H
+
+#include "rs_gf.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* Length from which rs_poly_mul() switches to Karatsuba */
+#define RS_POLY_KARATSUBA 32
+
+/* Log "value" of the zero coefficient in logarithm arrays */
+#define RS_POLY_LOG_ZERO ((rs_sym_t)rs_Np)
+
+/* -------------------------------------------------------------------------
+ * Kernels
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Degree of a (the highest non-zero index), -1 for the zero
+ *        polynomial.
+ */
+int rs_poly_deg(const rs_sym_t *a, int n);
+
+/**
+ * @brief Logarithms of n coefficients (RS_POLY_LOG_ZERO for 0).
+ */
+void rs_poly_log(const rs_sym_t *a, rs_sym_t *a_log, int n);
+
+/**
+ * @brief dst[i] = a[i] + k·b[i], i < n.
+ *
+ * dst may equal a, or lie below it (dst = a - 1 shifts a register).
+ */
+void rs_poly_scale_add(rs_sym_t *dst, const rs_sym_t *a, uint16_t k,
+                       const rs_sym_t *b, int n);
+
+/**
+ * @brief rs_poly_scale_add() with b given by rs_poly_log().
+ */
+void rs_poly_scale_add_log(rs_sym_t *dst, const rs_sym_t *a, uint16_t k,
+                           const rs_sym_t *b_log, int n);
+
+/**
+ * @brief Coefficient k of a·b.
+ */
+uint16_t rs_poly_mul_coef(const rs_sym_t *a, int na, const rs_sym_t *b,
+                          int nb, int k);
+
+/* -------------------------------------------------------------------------
+ * Multiplication
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Scratch symbols needed by rs_poly_mul() for these lengths.
+ */
+size_t rs_poly_mul_scratch(int na, int nb);
+
+/**
+ * @brief c = a·b, na + nb - 1 coefficients.
+ *
+ * @param scratch rs_poly_mul_scratch(na, nb) symbols (NULL if that is 0).
+ */
+void rs_poly_mul(const rs_sym_t *a, int na, const rs_sym_t *b, int nb,
+                 rs_sym_t *c, rs_sym_t *scratch);
+
+/**
+ * @brief c = a·b by the quadratic method only (reference and small sizes).
+ */
+void rs_poly_mul_school(const rs_sym_t *a, int na, const rs_sym_t *b, int nb,
+                        rs_sym_t *c);
+
+/* -------------------------------------------------------------------------
+ * Division
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief a = q·b + r by long division.
+ *
+ * The remainder is formed in a register of nb - 1 symbols (the encoder's
+ * LFSR), so the dividend is only read.
+ *
+ * @param q Quotient, na - nb + 1 coefficients (NULL: not needed).
+ * @param r Remainder, nb - 1 coefficients.
+ *
+ * @return 0, or -1 if b[nb - 1] = 0 or na < nb.
+ */
+int rs_poly_divmod(const rs_sym_t *a, int na, const rs_sym_t *b, int nb,
+                   rs_sym_t *q, rs_sym_t *r);
+
+/* Divisor prepared for repeated division of dividends up to max_na long */
+typedef struct {
+  int nb, max_na;
+  rs_sym_t *b;       /* [nb] divisor */
+  rs_sym_t *inv_rev; /* 1 / rev(b) mod x^(max_na - nb + 1) */
+  rs_sym_t *scratch; /* products and reversals */
+} rs_poly_divisor;
+
+/**
+ * @brief Prepare b (b[nb - 1] ≠ 0) for rs_poly_divmod_pre().
+ *
+ * @return 0 on success, -1 on invalid arguments or allocation failure.
+ */
+int rs_poly_divisor_init(rs_poly_divisor *d, const rs_sym_t *b, int nb,
+                         int max_na);
+
+/**
+ * @brief Release a prepared divisor.
+ */
+void rs_poly_divisor_free(rs_poly_divisor *d);
+
+/**
+ * @brief rs_poly_divmod() by a prepared divisor: the quotient is
+ *        rev(rev(a) · inv_rev), two products of Karatsuba cost.
+ *
+ * Not reentrant: the divisor holds the scratch memory.
+ */
+int rs_poly_divmod_pre(const rs_poly_divisor *d, const rs_sym_t *a, int na,
+                       rs_sym_t *q, rs_sym_t *r);
+
+/* -------------------------------------------------------------------------
+ * Euclid
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Scratch symbols needed by rs_poly_xgcd() for these lengths.
+ */
+size_t rs_poly_xgcd_scratch(int na, int nb);
+
+/**
+ * @brief Extended Euclid: r = s·a + t·b.
+ *
+ * stop_deg = 0 runs to the end and returns the monic gcd. stop_deg > 0
+ * returns the first remainder of degree < stop_deg. Solving the key
+ * equation: a = x^T, b = S(x), stop_deg = T/2 gives r = Ω and t = σ up to
+ * the factor t[0].
+ *
+ * @param r, s, t Outputs of max(na, nb) coefficients (s, t may be NULL).
+ * @param scratch rs_poly_xgcd_scratch(na, nb) symbols.
+ *
+ * @return Degree of r (-1 if r = 0).
+ */
+int rs_poly_xgcd(const rs_sym_t *a, int na, const rs_sym_t *b, int nb,
+                 int stop_deg, rs_sym_t *r, rs_sym_t *s, rs_sym_t *t,
+                 rs_sym_t *scratch);
+
+/* -------------------------------------------------------------------------
+ * Evaluation
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief a(x) by Horner's rule.
+ */
+uint16_t rs_poly_eval(const rs_sym_t *a, int n, uint16_t x);
+
+/**
+ * @brief out[k] = a(x[k]), k < count.
+ */
+void rs_poly_eval_many(const rs_sym_t *a, int n, const rs_sym_t *x,
+                       int count, rs_sym_t *out);
+
+/**
+ * @brief out[k] = a(α^{e0 + k·step}), k < count (exponents mod 2^m - 1,
+ *        may be negative).
+ *
+ * Short polynomials keep the terms a_j α^{j·e} as logarithms and advance
+ * them by j·step per point, one addition and lookup per term; long ones
+ * use Horner per point. For m > 8 with a vector rs_gf16 kernel, long
+ * polynomials run Horner in RS_GF16_LANES interleaved lanes (constant
+ * x^LANES), and at least WIDE_POINTS (256) points run each term over
+ * blocks of consecutive points (constant α^{j·step·LANES}).
+ */
+void rs_poly_eval_geom(const rs_sym_t *a, int n, long long e0,
+                       long long step, int count, rs_sym_t *out);
+
+/* -------------------------------------------------------------------------
+ * Construction
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Scratch symbols needed by rs_poly_from_roots() for n roots.
+ */
+size_t rs_poly_from_roots_scratch(int n);
+
+/**
+ * @brief out = Π_{i<n} (x - roots[i]), n + 1 coefficients, monic.
+ *
+ * @param scratch rs_poly_from_roots_scratch(n) symbols (NULL if that is 0).
+ */
+void rs_poly_from_roots(const rs_sym_t *roots, int n, rs_sym_t *out,
+                        rs_sym_t *scratch);
+
+#endif /* RS_POLY_H */
@@ -0,0 +1,80 @@
+/**
+ * @file rs_product.h
+ * @brief Product code RS(N, K) × RS(N, K) for 2-D storage blocks.
+ *
+ * A block is an N × N symbol matrix in row-major order in which every row
+ * and every column is a codeword of the current code:
+ *
+ *            K columns        T columns
+ *        +---------------+---------------+
+ *        |  information  |  row parity   |  K rows
+ *        +---------------+---------------+
+ *        | column parity | checks on     |  T rows
+ *        |               | checks        |
+ *        +---------------+---------------+
+ *
+ * Encoding runs one row pass over the K information rows and one column
+ * pass over all N columns (the code is linear, so the bottom T rows are
+ * row codewords too).
+ *
+ * Decoding alternates row and column passes. A pass decodes all N rows (or
+ * columns) with rs_decode_batch_sym(), the columns through a stride of N
+ * symbols. The rows that failed in a row pass are handed to the next column
+ * pass as erasures, and vice versa, as long as there are at most T of
+ * them. Failed words are left unmodified by the decoder, so an erased
+ * position still holds the received symbol. Decoding stops when
+ *
+ *   - a pass finds every word clean and the previous pass in the other
+ *     direction had no failures (the block is a product codeword), or
+ *   - two passes in a row change nothing and the failure pattern repeats
+ *     (a fixed point; the block is uncorrectable), or
+ *   - max_passes passes have run.
+ *
+ * The product code has minimum distance (T + 1)^2. Iterative row/column
+ * decoding does not reach that bound, but it corrects most patterns with
+ * far more than t errors in a row, and with erasure passing bursts
+ * that wipe out up to T whole rows.
+ *
+ * Requirements:
+ *   - rs_gf_init() (any variant) must be called before, and not
+ *     concurrently. Rows and columns use the same code.
+ */
+
+#ifndef RS_PRODUCT_H
+#define RS_PRODUCT_H
+
+#include "rs_gf.h"
+
+typedef struct {
+  int passes;        /* Row and column passes run */
+  long corrected;    /* Corrected positions, summed over all passes */
+  int failed_rows;   /* Rows that failed in the last row pass */
+  int failed_cols;   /* Columns that failed in the last column pass */
+} rs_product_stats;
+
+/**
+ * @brief Encode a block in place.
+ *
+ * @param block     N × N symbols; the K × K information part is read, all
+ *                  parity symbols are written.
+ * @param n_threads Worker threads per pass (0 = one per online CPU).
+ *
+ * @return 0 on success, negative on failure.
+ */
+int rs_product_encode(rs_sym_t *block, int n_threads);
+
+/**
+ * @brief Iteratively decode a block in place.
+ *
+ * @param block      N × N received symbols, corrected on return.
+ * @param max_passes Upper bound on row + column passes (≤ 0: 16).
+ * @param n_threads  Worker threads per pass (0 = one per online CPU).
+ * @param stats      Optional decoding statistics.
+ *
+ * @return 0 if the block is a product codeword on return, -1 if it could
+ *         not be corrected (or on allocation failure).
+ */
+int rs_product_decode(rs_sym_t *block, int max_passes, int n_threads,
+                      rs_product_stats *stats);
+
+#endif /* RS_PRODUCT_H */
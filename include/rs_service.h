@@ -0,0 +1,59 @@
+/**
+ * @file rs_service.h
+ * @brief Wire protocol of the local RS decoding service (mains/rs_server.c).
+ *
+ * Transport: SOCK_STREAM Unix domain socket. Every message is a fixed
+ * header followed by `len` payload bytes; integers are in host byte order
+ * (the socket never leaves the machine).
+ *
+ *   client → server : rs_svc_req  + payload
+ *   server → client : rs_svc_resp + payload   (one response per request,
+ *                                              in request order per client)
+ *
+ * Operations:
+ *   RS_SVC_ENCODE     payload = packed information frame (rs_pack.h)
+ *                     reply   = packed codeword, status 0
+ *   RS_SVC_DECODE     payload = packed received frame
+ *                     reply   = packed corrected frame,
+ *                               status = decoder status (rs_decode())
+ *   RS_SVC_INFO       payload = none
+ *                     reply   = int32 m, N, K of the served code
+ *   RS_SVC_SET_WINDOW payload = uint32 coalescing window in microseconds
+ *                     reply   = none, status 0
+ *
+ * Requests from all clients that arrive within the coalescing window are
+ * processed together by the batch kernels (rs_batch.h).
+ */
+
+#ifndef RS_SERVICE_H
+#define RS_SERVICE_H
+
+#include <stdint.h>
+
+#define RS_SVC_MAGIC 0x31565352u /* "RSV1" */
+
+#define RS_SVC_ENCODE 1
+#define RS_SVC_DECODE 2
+#define RS_SVC_INFO 3
+#define RS_SVC_SET_WINDOW 4
+
+/* Service-level status codes (decoder statuses are >= -2) */
+#define RS_SVC_EBADREQ (-100) /* unknown op or wrong payload length */
+
+#define RS_SVC_DEFAULT_PATH "/tmp/rs_codec.sock"
+
+typedef struct {
+  uint32_t magic;
+  uint32_t op;
+  uint32_t id;  /* echoed in the response */
+  uint32_t len; /* payload bytes */
+} rs_svc_req;
+
+typedef struct {
+  uint32_t magic;
+  int32_t status;
+  uint32_t id;
+  uint32_t len; /* payload bytes */
+} rs_svc_resp;
+
+#endif /* RS_SERVICE_H */
@@ -0,0 +1,49 @@
+/**
+ * @file rs_split.h
+ * @brief Multi-threaded decoding of a single long codeword.
+ *
+ * rs_batch.h and rs_pipeline.h parallelise across codewords. For very long
+ * codes (GF(2^16), tens of thousands of symbols) one codeword is already
+ * enough work to share, so this decoder splits the two O(N·T) stages of a
+ * single codeword over threads:
+ *
+ *   - Syndromes : each thread takes a contiguous symbol range and computes
+ *                 partial syndromes, shifted by α^{i·(S + n0)} to the
+ *                 range's offset; the calling thread XORs the partials.
+ *   - Chien     : each thread scans a contiguous range of parent positions;
+ *                 the roots are concatenated in range order.
+ *
+ * Berlekamp–Massey and the magnitude solve stay on the calling thread.
+ * Results (corrected symbols and status) are identical to rs_decode_sym().
+ *
+ * Worker threads are started per stage and joined before returning, as in
+ * rs_batch.c; a thread that cannot be started has its range run by the
+ * calling thread.
+ *
+ * Requirements:
+ *   - rs_gf_init(m, N, K, T) must be called before, and not concurrently.
+ */
+
+#ifndef RS_SPLIT_H
+#define RS_SPLIT_H
+
+#include "rs_workspace.h"
+
+/**
+ * @brief Decode one shortened codeword in place using n_threads threads.
+ *
+ * @param code_sym  Received symbols (Ns entries), corrected on return.
+ * @param n_threads Threads including the caller (0 = one per online CPU;
+ *                  at most rs_batch_default_threads()).
+ *
+ * @return Same status as rs_decode_sym().
+ */
+int rs_decode_sym_split(rs_sym_t *code_sym, int n_threads);
+
+/**
+ * @brief rs_decode_sym_split() with an explicit workspace.
+ */
+int rs_decode_sym_split_ws(rs_workspace *ws, rs_sym_t *code_sym,
+                           int n_threads);
+
+#endif /* RS_SPLIT_H */
@@ -0,0 +1,82 @@
+/**
+ * @file rs_stats.h
+ * @brief Pre-FEC bit error rate estimation from decoder corrections.
+ *
+ * Every decoded codeword tells how many received bits were wrong: the
+ * popcount of the error values the decoder applied (rs_decode_last_bits(),
+ * rs_decode_batch_bits()). An rs_chan_stats object turns these counts into
+ * running estimates of the raw channel BER, e.g. for link adaptation:
+ *
+ *   - ber_ewma   : exponentially weighted moving average of the per-word
+ *                  fraction c / (N·m), weight alpha per codeword
+ *   - ber_window : corrected bits / received bits over the last `window`
+ *                  codewords (ring buffer)
+ *   - fer_window : fraction of those codewords that failed to decode
+ *   - ber_total  : corrected bits / received bits since creation or reset
+ *
+ * An uncorrectable word hides its error count. It enters the estimates
+ * with t + 1 bits: the fewest symbol errors a failure implies, one bit
+ * each. Once words start failing the BER estimates are lower bounds;
+ * fer_window shows when.
+ *
+ * An object is bound to the code that was current when it was created.
+ * Updates and reads take an internal mutex, so a receive thread may update
+ * while another thread reads.
+ */
+
+#ifndef RS_STATS_H
+#define RS_STATS_H
+
+#include <stddef.h>
+
+typedef struct rs_chan_stats rs_chan_stats;
+
+typedef struct {
+  long long words;   /* Codewords seen since creation / reset */
+  long long failed;  /* ... of which uncorrectable (status < 0) */
+  double ber_ewma;   /* EWMA of per-codeword bit error fraction */
+  double ber_window; /* Bit error rate over the window */
+  double fer_window; /* Failed-codeword rate over the window */
+  double ber_total;  /* Bit error rate since creation / reset */
+} rs_chan_estimate;
+
+/**
+ * @brief Create an estimator for the current code.
+ *
+ * @param window Codewords in the sliding window (≥ 1).
+ * @param alpha  EWMA weight of the newest codeword, 0 < alpha ≤ 1.
+ *
+ * @return Estimator, or NULL on invalid arguments / allocation failure.
+ */
+rs_chan_stats *rs_chan_stats_create(int window, double alpha);
+
+/**
+ * @brief Release an estimator.
+ */
+void rs_chan_stats_destroy(rs_chan_stats *s);
+
+/**
+ * @brief Forget all codewords seen so far.
+ */
+void rs_chan_stats_reset(rs_chan_stats *s);
+
+/**
+ * @brief Account one decoded codeword.
+ *
+ * @param status Decoder status (< 0: uncorrectable).
+ * @param bits   Corrected bits reported for the word (ignored if status < 0).
+ */
+void rs_chan_stats_add(rs_chan_stats *s, int status, int bits);
+
+/**
+ * @brief Account n codewords, e.g. the outputs of rs_decode_batch_bits().
+ */
+void rs_chan_stats_add_batch(rs_chan_stats *s, const int *status,
+                             const int *bits, size_t n);
+
+/**
+ * @brief Snapshot of the current estimates.
+ */
+void rs_chan_stats_read(rs_chan_stats *s, rs_chan_estimate *est);
+
+#endif /* RS_STATS_H */
@@ -0,0 +1,65 @@
+/**
+ * @file rs_table.h
+ * @brief Precomputed GF/code table files with read-only mmap loading.
+ *
+ * rs_table_save() serialises every table rs_gf_init() derives for the
+ * current code (exp/log, generator polynomial with its logarithms and
+ * split rows, symbol bit table, dual-basis maps) into one file;
+ * rs_table_load() maps such a file read-only and points the codec's table
+ * views (rs_gf.h) into the mapping. Processes using the same file skip
+ * table construction and share the physical pages through the page cache
+ * instead of each holding private copies (4.6 MB for m = 16 in the
+ * default profile).
+ *
+ * File layout (host byte order; written by mains/rs_tablegen.c):
+ *
+ *   header   magic "RST1", format version, build parameters (RS_M_MAX,
+ *            sizeof(rs_sym_t), profile flags), code (m, N, K, T),
+ *            code options (polynomial, fcr, spacing, basis),
+ *            section offsets/lengths, file size, checksum
+ *   sections exp, log, generator, generator logarithms, generator split
+ *            rows (m > 8 and T ≤ RS_GEN_SPLIT_T_MAX only), symbol bits
+ *            (absent in the compact profile), dual ↔ conventional maps
+ *            (dual-basis codes only), each 64-byte aligned
+ *
+ * Loading checks the code options as rs_gf_init_params() does (degree-m
+ * polynomial, root spacing coprime to 2^m - 1, dual basis only for the
+ * CCSDS field) and derives no table of its own.
+ *
+ * The checksum (Fletcher-64 over 32-bit words) covers every byte after the
+ * header. A file is rejected unless it was written by a build with the same
+ * RS_M_MAX, symbol type and profile.
+ *
+ * Like rs_gf_init(), loading must not run concurrently with encoding or
+ * decoding. A later rs_gf_init() switches back to the process's own
+ * tables; the mapping stays valid until the next rs_table_load().
+ */
+
+#ifndef RS_TABLE_H
+#define RS_TABLE_H
+
+#define RS_TABLE_MAGIC 0x31545352u /* "RST1" */
+#define RS_TABLE_VERSION 3
+
+/**
+ * @brief Write the tables of the current code (rs_gf_init()) to a file.
+ *
+ * The file is written under a temporary name and renamed into place, so
+ * processes that have the previous version mapped are not disturbed.
+ *
+ * @return 0 on success, negative on failure.
+ */
+int rs_table_save(const char *path);
+
+/**
+ * @brief Map a table file read-only and make its code the current one.
+ *
+ * Equivalent to rs_gf_init_params() with the file's parameters
+ * (rs_code_gen is advanced, so workspaces must be re-created).
+ *
+ * @return 0 on success, negative if the file is missing, truncated,
+ *         corrupted or built for a different configuration.
+ */
+int rs_table_load(const char *path);
+
+#endif /* RS_TABLE_H */
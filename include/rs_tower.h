@@ -0,0 +1,129 @@
+/**
+ * @file rs_tower.h
+ * @brief Composite (tower) field GF((2^4)^2) for table-free GF(256)
+ *        arithmetic in bit-sliced and SIMD kernels.
+ *
+ * GF(256) is the field of the codec's m = 8 default polynomial
+ * (0x11D, primitive_poly[8] in rs_gf.c). The tower representation builds
+ * the same field in two steps:
+ *
+ *     GF(16)  = GF(2)[x] / (x^4 + x + 1)
+ *     GF(256) = GF(16)[y] / (y^2 + y + λ),  λ = x^3 (0x8)
+ *
+ * and stores an element a1·y + a0 as the byte (a1 << 4) | a0. A GF(2)-linear
+ * isomorphism (an 8 × 8 bit matrix) maps the polynomial basis α^i to
+ * β^i, β = 0x21 being a root of 0x11D in the tower; its inverse maps back.
+ * Both are applied as two 16-entry nibble lookups.
+ *
+ * In the tower a product costs three GF(16) products (Karatsuba) and an
+ * inverse one GF(16) inverse:
+ *
+ *     (a1 y + a0)(b1 y + b0) = ((a0 + a1)(b0 + b1) + a0 b0) y
+ *                              + a0 b0 + λ a1 b1
+ *     (a1 y + a0)^-1         = (a1 y + a0 + a1) / (a0 (a0 + a1) + λ a1^2)
+ *
+ * GF(16) operations fit in a register: SSSE3/AVX2 kernels keep the GF(16)
+ * log/exp/inverse tables in PSHUFB operands (16 or 32 lanes, no memory
+ * lookups), and the bit-sliced kernel evaluates them as AND/XOR networks on
+ * 64 symbols at once (planes of a uint64_t per bit).
+ *
+ * The vector functions take and return polynomial-basis bytes, i.e. the
+ * codec's symbols for rs_gf_init(8, ...) with the default polynomial. The
+ * kernel is chosen once at run time from the CPU's features
+ * (rs_tower_kernel()); all kernels give identical results. The module
+ * keeps no per-code state and needs no rs_gf_init().
+ */
+
+#ifndef RS_TOWER_H
+#define RS_TOWER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Field polynomial whose GF(256) the tower represents */
+#define RS_TOWER_POLY 0x11D
+
+/* -------------------------------------------------------------------------
+ * Scalar
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Polynomial basis → tower representation.
+ */
+uint8_t rs_tower_to(uint8_t x);
+
+/**
+ * @brief Tower representation → polynomial basis.
+ */
+uint8_t rs_tower_from(uint8_t t);
+
+/**
+ * @brief Product of two tower elements.
+ */
+uint8_t rs_tower_mul(uint8_t a, uint8_t b);
+
+/**
+ * @brief Inverse of a tower element (0 maps to 0).
+ */
+uint8_t rs_tower_inv(uint8_t a);
+
+/* -------------------------------------------------------------------------
+ * Bit-sliced (64 symbols, plane j holds bit j of every symbol)
+ * ------------------------------------------------------------------------- */
+
+/* Planes 0..3: a0 (low nibble), planes 4..7: a1; bit k = symbol k */
+typedef struct {
+  uint64_t p[8];
+} rs_tower_bs;
+
+/**
+ * @brief Transpose 64 polynomial-basis bytes into tower planes.
+ */
+void rs_tower_bs_load(const uint8_t *x, rs_tower_bs *s);
+
+/**
+ * @brief Tower planes → 64 polynomial-basis bytes.
+ */
+void rs_tower_bs_store(const rs_tower_bs *s, uint8_t *x);
+
+/**
+ * @brief c = a·b, 64 products (c may alias a or b).
+ */
+void rs_tower_bs_mul(const rs_tower_bs *a, const rs_tower_bs *b,
+                     rs_tower_bs *c);
+
+/**
+ * @brief c = 1 / a, 64 inverses (0 maps to 0; c may alias a).
+ */
+void rs_tower_bs_inv(const rs_tower_bs *a, rs_tower_bs *c);
+
+/* -------------------------------------------------------------------------
+ * Vector kernels on polynomial-basis bytes
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief c[i] = a[i]·b[i], i < n (c may alias a or b).
+ */
+void rs_tower_mul_vec(const uint8_t *a, const uint8_t *b, uint8_t *c,
+                      size_t n);
+
+/**
+ * @brief c[i] = 1 / a[i], i < n (0 maps to 0; c may alias a).
+ */
+void rs_tower_inv_vec(const uint8_t *a, uint8_t *c, size_t n);
+
+/**
+ * @brief Name of the active kernel: "avx2", "ssse3", "bitslice" or
+ *        "scalar".
+ */
+const char *rs_tower_kernel(void);
+
+/**
+ * @brief Force a kernel by name (NULL: automatic choice), for benchmarks
+ *        and tests. Not thread-safe against running kernels.
+ *
+ * @return 0, or -1 if the name is unknown or the CPU lacks the feature.
+ */
+int rs_tower_set_kernel(const char *name);
+
+#endif /* RS_TOWER_H */
@@ -0,0 +1,155 @@
+/**
+ * @file rs_trace.h
+ * @brief Binary traces of received codewords: capture and mmap replay.
+ *
+ * A trace records what a receiver handed to the decoder, so real error
+ * statistics can be replayed through the codec (mains/rs_replay.c).
+ *
+ * File layout (host byte order):
+ *
+ *   header   magic "RSTR", format version, flags, code (m, N, K, T), code
+ *            options (polynomial, fcr, spacing, basis), wire format (bit
+ *            order, packing; rs_pack.h), record size — 64 bytes
+ *   records  fixed size, back to back until the end of the file:
+ *              [timestamp]  uint64_t ns        (RS_TRACE_TIMESTAMPS)
+ *              codeword     rs_packed_bytes(N) in the trace's wire format
+ *              [erasures]   ceil(N / 8) bytes, bit n (LSB first) flags
+ *                           symbol n as erased (RS_TRACE_ERASURES)
+ *
+ * The record count follows from the file size, so a trace cut short by a
+ * crashed writer still replays up to its last complete record (a partial
+ * one is reported and skipped). rs_trace_map() checks record_bytes
+ * against the flags, N and wire format in the header, so every record
+ * accessor stays inside the mapping. Because the
+ * codeword is stored in the packed format, the mapped records can be fed to
+ * rs_decode_batch() directly with a stride of record_bytes.
+ *
+ * Capture: rs_trace_capture(w) makes every decode that goes through
+ * rs_decode_sym_ws() (symbol, bit, packed and packed batch decoding) or the
+ * errors-and-erasures decoder append its received word to w before it is
+ * corrected. The split, fixed-schedule, pipeline and FFT decoders are not
+ * captured. Install and remove the hook only while no other thread is
+ * decoding; writes from concurrent decoders are serialised by the writer.
+ */
+
+#ifndef RS_TRACE_H
+#define RS_TRACE_H
+
+#include "rs_gf.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define RS_TRACE_MAGIC 0x52545352u /* "RSTR" */
+#define RS_TRACE_VERSION 1
+
+/* Optional record fields */
+#define RS_TRACE_TIMESTAMPS 1u
+#define RS_TRACE_ERASURES 2u
+
+/* -------------------------------------------------------------------------
+ * Writing
+ * ------------------------------------------------------------------------- */
+typedef struct rs_trace_writer rs_trace_writer;
+
+/* Writer the capture hook appends to, NULL when capture is off */
+extern rs_trace_writer *rs_trace_active;
+
+/**
+ * @brief Create a trace for the current code and wire format.
+ *
+ * @param flags RS_TRACE_TIMESTAMPS and/or RS_TRACE_ERASURES.
+ *
+ * @return Writer, or NULL if the file cannot be created.
+ */
+rs_trace_writer *rs_trace_create(const char *path, unsigned flags);
+
+/**
+ * @brief Append one packed received codeword (rs_packed_bytes(N) bytes).
+ *
+ * @param eras_pos Erased positions 0..N-1 (ignored without
+ *                 RS_TRACE_ERASURES; NULL if n_eras = 0).
+ * @param t_ns     Timestamp in ns, 0 = now (CLOCK_REALTIME).
+ *
+ * @return 0 on success, -1 on a write error.
+ */
+int rs_trace_write(rs_trace_writer *w, const uint8_t *code_pack,
+                   const int *eras_pos, int n_eras, uint64_t t_ns);
+
+/**
+ * @brief rs_trace_write() for a codeword given as N symbols.
+ */
+int rs_trace_write_sym(rs_trace_writer *w, const rs_sym_t *code_sym,
+                       const int *eras_pos, int n_eras, uint64_t t_ns);
+
+/**
+ * @brief Flush and close a writer (stops capture first if it is active).
+ *
+ * @return 0 if every record was written, -1 otherwise.
+ */
+int rs_trace_close(rs_trace_writer *w);
+
+/**
+ * @brief Start (w) or stop (NULL) capturing decoder input.
+ */
+void rs_trace_capture(rs_trace_writer *w);
+
+/* -------------------------------------------------------------------------
+ * Reading
+ * ------------------------------------------------------------------------- */
+typedef struct {
+  unsigned flags;        /* RS_TRACE_TIMESTAMPS | RS_TRACE_ERASURES */
+  int m, N, K, T;        /* Code of the trace */
+  rs_code_params params; /* Code options of the trace */
+  int bit_order;         /* Wire format of the codewords (rs_pack.h) */
+  int packing;
+  size_t record_bytes; /* Record stride */
+  size_t code_offset;  /* Codeword offset within a record */
+  size_t eras_offset;  /* Erasure bitmap offset (RS_TRACE_ERASURES) */
+  size_t n_records;
+  const uint8_t *records; /* First record (read-only mapping) */
+
+  void *base; /* Mapping, for rs_trace_unmap() */
+  size_t bytes;
+} rs_trace;
+
+/**
+ * @brief Map a trace read-only.
+ *
+ * @return 0 on success, negative if the file is missing or not a trace.
+ */
+int rs_trace_map(const char *path, rs_trace *t);
+
+/**
+ * @brief Release a mapping from rs_trace_map().
+ */
+void rs_trace_unmap(rs_trace *t);
+
+/**
+ * @brief Make the trace's code and wire format the current ones
+ *        (rs_gf_init_params() and rs_io_set_format()).
+ *
+ * @return 0 on success, negative on failure.
+ */
+int rs_trace_select(const rs_trace *t);
+
+/**
+ * @brief Packed codeword of record i.
+ */
+const uint8_t *rs_trace_codeword(const rs_trace *t, size_t i);
+
+/**
+ * @brief Timestamp of record i in ns (0 without RS_TRACE_TIMESTAMPS).
+ */
+uint64_t rs_trace_time(const rs_trace *t, size_t i);
+
+/**
+ * @brief Erased positions of record i.
+ *
+ * @param eras_pos Output, room for N positions (bitmap padding bits at and
+ *                 above N are ignored).
+ *
+ * @return Number of erasures (0 without RS_TRACE_ERASURES).
+ */
+int rs_trace_erasures(const rs_trace *t, size_t i, int *eras_pos);
+
+#endif /* RS_TRACE_H */
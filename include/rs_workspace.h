@@ -0,0 +1,108 @@
+/**
+ * @file rs_workspace.h
+ * @brief Per-code scratch memory for the Reed–Solomon encoder/decoder.
+ *
+ * Every temporary buffer used by rs_encode() / rs_decode() lives in a
+ * workspace that is sized once for the current code (rs_gf_init()), so the
+ * hot paths perform no allocation and keep nothing large on the stack.
+ *
+ * Memory use for a code with N symbols and T = 2t parity symbols:
+ *
+ *   rs_sym_t : N          symbol buffer
+ *              T          syndromes
+ *              3 (T + 1)  Berlekamp–Massey polynomials
+ *              t + 1      error-locator σ(x)
+ *              t (t + 1)  error-magnitude linear system
+ *   int      : T + 1      error positions (errata with erasures)
+ *
+ * (rs_workspace_size() returns the exact byte count, including alignment.)
+ * For RS(255,223) this is below 2 KB (about 1 KB with 8-bit rs_sym_t).
+ *
+ * Usage:
+ *   - Caller-provided arena : rs_workspace_init(&ws, mem, rs_workspace_size())
+ *   - Heap                  : ws = rs_workspace_create() ... destroy
+ *   - Implicit              : rs_encode()/rs_decode() use a per-thread
+ *                             workspace (rs_workspace_default()) that is
+ *                             allocated on first use and re-sized after
+ *                             rs_gf_init() selects a different code.
+ *
+ * A workspace must not be used by two threads at the same time. One sized
+ * for another code is rejected (rs_workspace_check()), not overrun.
+ */
+
+#ifndef RS_WORKSPACE_H
+#define RS_WORKSPACE_H
+
+#include "rs_gf.h"
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct rs_workspace {
+  int N;        /* Code length the workspace was sized for */
+  int T;        /* Parity symbols the workspace was sized for */
+  unsigned gen; /* rs_code_gen at sizing time */
+  int corr_bits; /* Bits flipped by the last decode (rs_decode_last_bits) */
+
+  rs_sym_t *sym;    /* [N]     codeword symbols */
+  rs_sym_t *synd;   /* [T]     syndromes */
+  rs_sym_t *bm_C;   /* [T + 1] BM current polynomial */
+  rs_sym_t *bm_B;   /* [T + 1] BM previous polynomial */
+  rs_sym_t *bm_tmp; /* [T + 1] BM copy of C(x) */
+  rs_sym_t *sigma;  /* [t + 1] error-locator polynomial */
+  rs_sym_t *mat;    /* [t * t] magnitude system matrix */
+  rs_sym_t *rhs;    /* [t]     magnitude system right-hand side */
+  int *error_pos;   /* [T + 1] Chien search roots */
+
+  void *owned; /* Allocation to release in rs_workspace_destroy() */
+} rs_workspace;
+
+/**
+ * @brief Bytes of arena memory needed for the current code.
+ */
+size_t rs_workspace_size(void);
+
+/**
+ * @brief Lay out a workspace in caller-provided memory.
+ *
+ * @param ws    Workspace descriptor to fill.
+ * @param mem   Arena (suitably aligned for int).
+ * @param bytes Arena size, at least rs_workspace_size().
+ *
+ * @return 0 on success, negative if the arena is too small.
+ */
+int rs_workspace_init(rs_workspace *ws, void *mem, size_t bytes);
+
+/**
+ * @brief Check that a workspace can serve the current code.
+ *
+ * It can if it was laid out since the last rs_gf_init(), or for a code
+ * with at least as many symbols and parity symbols. Every public *_ws
+ * entry point runs this check and returns -1 without touching the
+ * workspace when it fails.
+ *
+ * @return 0 if usable, -1 otherwise (including ws == NULL).
+ */
+int rs_workspace_check(const rs_workspace *ws);
+
+/**
+ * @brief Allocate a workspace for the current code on the heap.
+ *
+ * @return Workspace, or NULL on allocation failure.
+ */
+rs_workspace *rs_workspace_create(void);
+
+/**
+ * @brief Release a workspace returned by rs_workspace_create().
+ */
+void rs_workspace_destroy(rs_workspace *ws);
+
+/**
+ * @brief The calling thread's implicit workspace, sized for the current code.
+ *
+ * Released automatically when the thread exits.
+ *
+ * @return Workspace, or NULL on allocation failure.
+ */
+rs_workspace *rs_workspace_default(void);
+
+#endif /* RS_WORKSPACE_H */
@@ -0,0 +1,163 @@
+/**
+ * @file rs_bench_fft.c
+ * @brief Crossover benchmark: additive-FFT path vs. quadratic codec.
+ *
+ * For a fixed field and code length the number of parity symbols T is
+ * swept; for every code the program times
+ *
+ *   encode  : rs_encode_sym()       vs. rs_fft_encode_sym()
+ *   synd    : rs_decode_syndromes() vs. rs_fft_syndromes()
+ *   decode  : rs_decode_sym()       vs. rs_fft_decode_sym()
+ *             (codewords with a fixed number of symbol errors)
+ *
+ * and prints microseconds per codeword for both paths plus the speedup
+ * (quadratic / FFT; > 1 means the FFT path wins). Both paths must produce
+ * identical codewords, syndromes and corrections.
+ *
+ * Usage:
+ *   rs_bench_fft [m] [N] [errors] [T ...]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "rs_decoder.h"
+#include "rs_encoder.h"
+#include "rs_fft.h"
+#include "rs_gf.h"
+
+#define MIN_SEC 0.2 /* measure each kernel for at least this long */
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+typedef enum { OP_ENCODE, OP_SYND, OP_DECODE } bench_op;
+
+/* Run one kernel repeatedly; returns microseconds per codeword */
+static double time_op(bench_op op, rs_fft *f, const rs_sym_t *info,
+                      const rs_sym_t *rx, rs_sym_t *work, rs_sym_t *synd) {
+  int N = rs_N;
+  long iters = 0;
+  double t0 = now_sec(), t;
+
+  do {
+    switch (op) {
+    case OP_ENCODE:
+      if (f)
+        rs_fft_encode_sym(f, info, work);
+      else
+        rs_encode_sym(info, work);
+      break;
+    case OP_SYND:
+      if (f)
+        rs_fft_syndromes(f, rx, synd);
+      else
+        rs_decode_syndromes(rx, synd);
+      break;
+    case OP_DECODE:
+      memcpy(work, rx, N * sizeof(rs_sym_t));
+      if (f)
+        rs_fft_decode_sym(f, work);
+      else
+        rs_decode_sym(work);
+      break;
+    }
+    iters++;
+    t = now_sec() - t0;
+  } while (t < MIN_SEC);
+
+  return t * 1e6 / iters;
+}
+
+/* ======================================================================== */
+/* MAIN                                                                      */
+/* ======================================================================== */
+int main(int argc, char **argv) {
+  int m = (argc > 1) ? atoi(argv[1]) : 16;
+  int N = (argc > 2) ? atoi(argv[2]) : (1 << m) - 1;
+  int n_err = (argc > 3) ? atoi(argv[3]) : 8;
+
+  static const int default_T[] = {16, 32, 64, 128, 256, 512, 1024, 2048};
+  int n_T = (argc > 4) ? argc - 4 : 8;
+
+  printf("Additive-FFT vs. quadratic codec, GF(2^%d), N = %d, %d errors\n",
+         m, N, n_err);
+  printf("(us per codeword; speedup = quadratic / FFT)\n\n");
+  printf("     T   setup_ms  |  encode: quad      fft    x  |"
+         "  synd: quad      fft    x  |  decode: quad      fft    x\n");
+
+  for (int c = 0; c < n_T; c++) {
+    int T = (argc > 4) ? atoi(argv[4 + c]) : default_T[c];
+    if (rs_gf_init(m, N, N - T, T) != 0)
+      return 1;
+    int K = rs_K;
+
+    double t0 = now_sec();
+    rs_fft *f = rs_fft_create();
+    double setup_ms = (now_sec() - t0) * 1e3;
+    rs_sym_t *info = (rs_sym_t *)malloc(K * sizeof(rs_sym_t));
+    rs_sym_t *tx = (rs_sym_t *)malloc(N * sizeof(rs_sym_t));
+    rs_sym_t *rx = (rs_sym_t *)malloc(N * sizeof(rs_sym_t));
+    rs_sym_t *work = (rs_sym_t *)malloc(N * sizeof(rs_sym_t));
+    rs_sym_t *synd = (rs_sym_t *)malloc(T * sizeof(rs_sym_t));
+    rs_sym_t *synd2 = (rs_sym_t *)malloc(T * sizeof(rs_sym_t));
+    if (!f || !info || !tx || !rx || !work || !synd || !synd2) {
+      fprintf(stderr, "Memory allocation failed.\n");
+      return 1;
+    }
+
+    srand(1);
+    for (int i = 0; i < K; i++)
+      info[i] = (rs_sym_t)(rand() & rs_Np);
+    rs_encode_sym(info, tx);
+    memcpy(rx, tx, N * sizeof(rs_sym_t));
+    int e = (n_err < T / 2) ? n_err : T / 2;
+    for (int i = 0; i < e; i++)
+      rx[rand() % N] ^= (rs_sym_t)(1 + rand() % rs_Np);
+
+    /* Cross-check both paths before timing */
+    int ok = 1;
+    rs_fft_encode_sym(f, info, work);
+    ok &= (memcmp(work, tx, N * sizeof(rs_sym_t)) == 0);
+    rs_decode_syndromes(rx, synd);
+    rs_fft_syndromes(f, rx, synd2);
+    ok &= (memcmp(synd, synd2, T * sizeof(rs_sym_t)) == 0);
+    memcpy(work, rx, N * sizeof(rs_sym_t));
+    ok &= (rs_fft_decode_sym(f, work) >= 0);
+    ok &= (memcmp(work, tx, N * sizeof(rs_sym_t)) == 0);
+    if (!ok) {
+      fprintf(stderr, "T = %d: FFT path disagrees with the quadratic codec\n",
+              T);
+      return 1;
+    }
+
+    double q[3], a[3];
+    for (int op = 0; op < 3; op++) {
+      q[op] = time_op((bench_op)op, NULL, info, rx, work, synd);
+      a[op] = time_op((bench_op)op, f, info, rx, work, synd);
+    }
+
+    printf("%6d  %9.1f  | %12.1f %8.1f %5.2f | %10.1f %8.1f %5.2f |"
+           " %12.1f %8.1f %5.2f\n",
+           T, setup_ms, q[0], a[0], q[0] / a[0], q[1], a[1], q[1] / a[1],
+           q[2], a[2], q[2] / a[2]);
+    fflush(stdout);
+
+    rs_fft_destroy(f);
+    free(info);
+    free(tx);
+    free(rx);
+    free(work);
+    free(synd);
+    free(synd2);
+  }
+
+  return 0;
+}
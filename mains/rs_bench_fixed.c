@@ -0,0 +1,151 @@
+/**
+ * @file rs_bench_fixed.c
+ * @brief Per-codeword latency spread: rs_decode_sym() vs.
+ *        rs_decode_sym_fixed().
+ *
+ * For a range of error counts (0 .. t + 1) the program decodes freshly
+ * generated received words one at a time, timing every call, and prints
+ * min / median / p99 / max latency in microseconds for both decoders. The
+ * last line gives each decoder's overall worst case and its ratio to the
+ * overall best case, i.e. the budget a slot scheduler has to reserve.
+ * Every decode is checked against the transmitted codeword.
+ *
+ * Usage:
+ *   rs_bench_fixed [m] [N] [K] [words per error count]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "rs_decoder.h"
+#include "rs_encoder.h"
+#include "rs_fixed.h"
+#include "rs_gf.h"
+
+static double now_us(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+static int cmp_double(const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+/* Random codeword in tx, and rx = tx with n_err errors at distinct spots */
+static void make_word(rs_sym_t *tx, rs_sym_t *rx, int n_err) {
+  int N = rs_N;
+  for (int i = 0; i < rs_K; i++)
+    tx[i] = (rs_sym_t)(rand() & rs_Np);
+  rs_encode_sym(tx, tx);
+  memcpy(rx, tx, N * sizeof(rs_sym_t));
+  for (int e = 0; e < n_err;) {
+    int pos = rand() % N;
+    if (rx[pos] != tx[pos])
+      continue;
+    rx[pos] ^= (rs_sym_t)(1 + rand() % rs_Np);
+    e++;
+  }
+}
+
+/* ======================================================================== */
+/* MAIN                                                                      */
+/* ======================================================================== */
+int main(int argc, char **argv) {
+  int m = (argc > 1) ? atoi(argv[1]) : 8;
+  int N = (argc > 2) ? atoi(argv[2]) : 255;
+  int K = (argc > 3) ? atoi(argv[3]) : 223;
+  int words = (argc > 4) ? atoi(argv[4]) : 2000;
+
+  if (rs_gf_init(m, N, K, N - K) != 0 || words < 1)
+    return 1;
+  int t = rs_T / 2;
+
+  rs_sym_t *tx = (rs_sym_t *)malloc(N * sizeof(rs_sym_t));
+  rs_sym_t *rx = (rs_sym_t *)malloc(N * sizeof(rs_sym_t));
+  rs_sym_t *w1 = (rs_sym_t *)malloc(N * sizeof(rs_sym_t));
+  rs_sym_t *w2 = (rs_sym_t *)malloc(N * sizeof(rs_sym_t));
+  double *lat_a = (double *)malloc(words * sizeof(double));
+  double *lat_f = (double *)malloc(words * sizeof(double));
+  if (!tx || !rx || !w1 || !w2 || !lat_a || !lat_f) {
+    fprintf(stderr, "Memory allocation failed.\n");
+    return 1;
+  }
+
+  int errs[] = {0, 1, t / 4, t / 2, t, t + 1};
+  int n_cfg = (int)(sizeof(errs) / sizeof(errs[0]));
+
+  printf("RS(%d,%d) GF(2^%d), t = %d, %d words per row, latency in us\n\n",
+         N, K, m, t, words);
+  printf(" errors |   adaptive: min    median    p99      max |"
+         "      fixed: min    median    p99      max\n");
+
+  double best_a = 1e30, worst_a = 0, best_f = 1e30, worst_f = 0;
+  srand(1);
+  for (int c = 0; c < n_cfg; c++) {
+    if (c > 0 && errs[c] <= errs[c - 1])
+      continue;
+    int n_err = errs[c];
+
+    for (int w = 0; w < words; w++) {
+      make_word(tx, rx, n_err);
+      memcpy(w1, rx, N * sizeof(rs_sym_t));
+      memcpy(w2, rx, N * sizeof(rs_sym_t));
+
+      double t0 = now_us();
+      int st1 = rs_decode_sym(w1);
+      double t1 = now_us();
+      int st2 = rs_decode_sym_fixed(w2);
+      double t2 = now_us();
+      lat_a[w] = t1 - t0;
+      lat_f[w] = t2 - t1;
+
+      /* Correctable: both restore tx. Beyond t: statuses agree, and the
+       * fixed decoder leaves a failed word untouched */
+      int bad = (st1 != st2);
+      if (n_err <= t)
+        bad |= (st1 != n_err) || memcmp(w1, tx, N * sizeof(rs_sym_t)) ||
+               memcmp(w2, tx, N * sizeof(rs_sym_t));
+      else if (st2 < 0)
+        bad |= (memcmp(w2, rx, N * sizeof(rs_sym_t)) != 0);
+      if (bad) {
+        fprintf(stderr, "%d errors: decoder results differ\n", n_err);
+        return 1;
+      }
+    }
+
+    qsort(lat_a, words, sizeof(double), cmp_double);
+    qsort(lat_f, words, sizeof(double), cmp_double);
+    int p50 = words / 2, p99 = (int)((long long)words * 99 / 100);
+    printf(" %6d | %15.2f %9.2f %8.2f %8.2f | %15.2f %9.2f %8.2f %8.2f\n",
+           n_err, lat_a[0], lat_a[p50], lat_a[p99], lat_a[words - 1],
+           lat_f[0], lat_f[p50], lat_f[p99], lat_f[words - 1]);
+    fflush(stdout);
+
+    if (lat_a[0] < best_a)
+      best_a = lat_a[0];
+    if (lat_a[p99] > worst_a)
+      worst_a = lat_a[p99];
+    if (lat_f[0] < best_f)
+      best_f = lat_f[0];
+    if (lat_f[p99] > worst_f)
+      worst_f = lat_f[p99];
+  }
+
+  printf("\np99 worst case: adaptive %.2f us (%.1fx its best), "
+         "fixed %.2f us (%.2fx its best)\n",
+         worst_a, worst_a / best_a, worst_f, worst_f / best_f);
+
+  free(tx);
+  free(rx);
+  free(w1);
+  free(w2);
+  free(lat_a);
+  free(lat_f);
+  return 0;
+}
@@ -0,0 +1,276 @@
+/**
+ * @file rs_bench_gf16.c
+ * @brief GF(2^16) vector kernels (rs_gf16.h) vs. log/exp tables.
+ *
+ * The program first checks every kernel the CPU supports against
+ * rs_gf_mul() in GF(2^m) (multiply by constants, Horner and geometric
+ * blocks, element-wise products, odd lengths for the tails). It then times
+ *
+ *   const : dst[i] = c·a[i]
+ *   horner: the syndrome loop, acc ← c·acc + a (RS_GF16_LANES lanes)
+ *   mul   : c[i] = a[i]·b[i]   (kernels implementing it)
+ *
+ * in nanoseconds per symbol, marks the kernel the library measured as
+ * fastest at first use, and finally times the codec on RS(2^m - 1,
+ * 2^m - 33) with the tables ("table") and with the measured kernel.
+ *
+ * Usage:
+ *   rs_bench_gf16 [m] [symbols]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "rs_decoder.h"
+#include "rs_encoder.h"
+#include "rs_gf.h"
+#include "rs_gf16.h"
+#include "rs_workspace.h"
+
+#define MIN_SEC 0.2  /* measure each kernel for at least this long */
+#define CODEC_T 32   /* parity symbols of the codec test */
+#define CODEC_ERR 16 /* symbol errors per decoded word */
+
+static const char *const kernel_names[] = {"avx2", "ssse3", "clmul", "split",
+                                           "table"};
+#define N_KERNELS 5
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void random_syms(uint16_t *a, size_t n) {
+  for (size_t i = 0; i < n; i++)
+    a[i] = (uint16_t)(rand() & rs_Np);
+}
+
+/* ------------------------------------------------------------------------ */
+/* Check                                                                     */
+/* ------------------------------------------------------------------------ */
+static int check_kernel(const char *name, rs_gf16_op op, const uint16_t *a,
+                        const uint16_t *b, size_t n) {
+  uint16_t *c = (uint16_t *)malloc(n * sizeof(uint16_t));
+  uint16_t *ref = (uint16_t *)malloc(n * sizeof(uint16_t));
+  uint16_t acc[RS_GF16_LANES], acc_ref[RS_GF16_LANES];
+  size_t blocks = n / RS_GF16_LANES;
+  int ok = c && ref;
+
+  if (ok && op == RS_GF16_MUL) {
+    for (size_t i = 0; i < n; i++)
+      ref[i] = rs_gf_mul(a[i], b[i]);
+    rs_gf16_mul_vec(a, b, c, n);
+    ok = (memcmp(c, ref, n * sizeof(uint16_t)) == 0);
+  }
+
+  for (int trial = 0; ok && op == RS_GF16_CONST && trial < 8; trial++) {
+    uint16_t cst = (trial == 0) ? 0 : (trial == 1) ? 1 : b[trial];
+    rs_gf16_const k;
+    rs_gf16_const_init(&k, cst);
+
+    /* Multiply by a constant */
+    for (size_t i = 0; i < n; i++)
+      ref[i] = rs_gf_mul(cst, a[i]);
+    rs_gf16_mul_const(&k, a, c, n);
+    ok = (memcmp(c, ref, n * sizeof(uint16_t)) == 0);
+
+    /* Horner over the blocks */
+    for (int l = 0; l < RS_GF16_LANES; l++) {
+      acc[l] = acc_ref[l] = b[l];
+      for (size_t t = blocks; t-- > 0;)
+        acc_ref[l] = rs_gf_mul(acc_ref[l], cst) ^ a[t * RS_GF16_LANES + l];
+    }
+    rs_gf16_horner(&k, a, blocks, acc);
+    ok = ok && (memcmp(acc, acc_ref, sizeof(acc)) == 0);
+
+    /* Geometric blocks */
+    memset(c, 0, n * sizeof(uint16_t));
+    memset(ref, 0, n * sizeof(uint16_t));
+    for (int l = 0; l < RS_GF16_LANES; l++) {
+      acc[l] = acc_ref[l] = a[l];
+      for (size_t t = 0; t < blocks; t++) {
+        ref[t * RS_GF16_LANES + l] = acc_ref[l];
+        acc_ref[l] = rs_gf_mul(acc_ref[l], cst);
+      }
+    }
+    rs_gf16_geom(&k, acc, c, blocks);
+    ok = ok && (memcmp(c, ref, n * sizeof(uint16_t)) == 0) &&
+         (memcmp(acc, acc_ref, sizeof(acc)) == 0);
+  }
+
+  if (!ok)
+    fprintf(stderr, "Kernel %s disagrees with rs_gf_mul()\n", name);
+  free(c);
+  free(ref);
+  return ok;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Timing                                                                    */
+/* ------------------------------------------------------------------------ */
+typedef enum { T_CONST, T_HORNER, T_MUL } bench_op;
+
+/* Nanoseconds per symbol with the active kernels */
+static double time_op(bench_op op, const uint16_t *a, const uint16_t *b,
+                      uint16_t *c, size_t n) {
+  rs_gf16_const k;
+  uint16_t acc[RS_GF16_LANES] = {0};
+  long iters = 0;
+  double t0 = now_sec(), t;
+
+  rs_gf16_const_init(&k, b[0] | 2);
+  do {
+    switch (op) {
+    case T_CONST:
+      rs_gf16_mul_const(&k, a, c, n);
+      break;
+    case T_HORNER:
+      rs_gf16_horner(&k, a, n / RS_GF16_LANES, acc);
+      break;
+    case T_MUL:
+      rs_gf16_mul_vec(a, b, c, n);
+      break;
+    }
+    iters++;
+    t = now_sec() - t0;
+  } while (t < MIN_SEC);
+
+  if (acc[0] == 0xFFFF) /* keep the Horner result alive */
+    printf(" ");
+  return t * 1e9 / ((double)iters * n);
+}
+
+/* Microseconds per codeword: encode, decode with CODEC_ERR errors, clean */
+static void time_codec(double *t_us) {
+  int N = rs_N, K = rs_K;
+  rs_workspace *ws = rs_workspace_create();
+  rs_sym_t *c = (rs_sym_t *)malloc((size_t)N * sizeof(rs_sym_t));
+  rs_sym_t *r = (rs_sym_t *)malloc((size_t)N * sizeof(rs_sym_t));
+  if (!ws || !c || !r) {
+    fprintf(stderr, "Memory allocation failed.\n");
+    exit(1);
+  }
+
+  long iters = 0;
+  double te = 0, td = 0, tc = 0, t0;
+  srand(2);
+  do {
+    for (int i = 0; i < K; i++)
+      c[i] = (rs_sym_t)(rand() & rs_Np);
+    t0 = now_sec();
+    rs_encode_sym(c, c);
+    te += now_sec() - t0;
+
+    memcpy(r, c, (size_t)N * sizeof(rs_sym_t));
+    for (int e = 0; e < CODEC_ERR; e++)
+      r[rand() % N] ^= (rs_sym_t)(1 + rand() % rs_Np);
+    t0 = now_sec();
+    rs_decode_sym_ws(ws, r);
+    td += now_sec() - t0;
+
+    memcpy(r, c, (size_t)N * sizeof(rs_sym_t));
+    t0 = now_sec();
+    rs_decode_sym_ws(ws, r);
+    tc += now_sec() - t0;
+    iters++;
+  } while (te + td + tc < 2 * MIN_SEC);
+
+  t_us[0] = te * 1e6 / iters;
+  t_us[1] = td * 1e6 / iters;
+  t_us[2] = tc * 1e6 / iters;
+  rs_workspace_destroy(ws);
+  free(c);
+  free(r);
+}
+
+/* ======================================================================== */
+/* MAIN                                                                      */
+/* ======================================================================== */
+int main(int argc, char **argv) {
+  int m = (argc > 1) ? atoi(argv[1]) : 16;
+  size_t n = (argc > 2) ? (size_t)atol(argv[2]) : 4096;
+
+  if (m < 9 || m > RS_M_MAX || n < RS_GF16_LANES) {
+    fprintf(stderr, "Usage: %s [m (9..%d)] [symbols (>= %d)]\n", argv[0],
+            RS_M_MAX, RS_GF16_LANES);
+    return 1;
+  }
+  if (rs_gf_init(m, (1 << m) - 1, (1 << m) - 1 - CODEC_T, CODEC_T) != 0)
+    return 1;
+
+  uint16_t *a = (uint16_t *)malloc(n * sizeof(uint16_t));
+  uint16_t *b = (uint16_t *)malloc(n * sizeof(uint16_t));
+  uint16_t *c = (uint16_t *)malloc(n * sizeof(uint16_t));
+  if (!a || !b || !c) {
+    fprintf(stderr, "Memory allocation failed.\n");
+    return 1;
+  }
+  srand(1);
+  random_syms(a, n);
+  random_syms(b, n);
+
+  /* Measured choice, before any kernel is forced */
+  const char *best[2] = {rs_gf16_kernel(RS_GF16_CONST),
+                         rs_gf16_kernel(RS_GF16_MUL)};
+
+  for (int op = RS_GF16_CONST; op <= RS_GF16_MUL; op++)
+    for (int k = 0; k < N_KERNELS; k++)
+      if (rs_gf16_set_kernel((rs_gf16_op)op, kernel_names[k]) == 0 &&
+          !check_kernel(kernel_names[k], (rs_gf16_op)op, a, b, n - 3))
+        return 1;
+
+  printf("GF(2^%d) kernels, %zu symbols (measured choice: const %s, "
+         "mul %s)\n",
+         m, n, best[0], best[1]);
+  printf("(ns per symbol; * = measured choice)\n\n");
+  printf("  kernel    |   const  horner |     mul\n");
+
+  for (int k = 0; k < N_KERNELS; k++) {
+    double t[3] = {0, 0, 0};
+    int has_const = (rs_gf16_set_kernel(RS_GF16_CONST, kernel_names[k]) == 0);
+    int has_mul = (rs_gf16_set_kernel(RS_GF16_MUL, kernel_names[k]) == 0);
+    if (!has_const && !has_mul) {
+      printf("  %-9s |   (not supported by this CPU)\n", kernel_names[k]);
+      continue;
+    }
+    if (has_const) {
+      t[0] = time_op(T_CONST, a, b, c, n);
+      t[1] = time_op(T_HORNER, a, b, c, n);
+      printf("  %-9s | %6.2f%c %6.2f  |", kernel_names[k], t[0],
+             strcmp(best[0], kernel_names[k]) ? ' ' : '*', t[1]);
+    } else {
+      printf("  %-9s |       -       -  |", kernel_names[k]);
+    }
+    if (has_mul) {
+      t[2] = time_op(T_MUL, a, b, c, n);
+      printf(" %6.2f%c\n", t[2], strcmp(best[1], kernel_names[k]) ? ' ' : '*');
+    } else {
+      printf("       -\n");
+    }
+    fflush(stdout);
+  }
+
+  /* Codec: tables vs. the measured kernel */
+  double t_tab[3], t_vec[3];
+  rs_gf16_set_kernel(RS_GF16_CONST, "table");
+  time_codec(t_tab);
+  rs_gf16_set_kernel(RS_GF16_CONST, NULL);
+  rs_gf16_set_kernel(RS_GF16_MUL, NULL);
+  time_codec(t_vec);
+
+  printf("\nRS(%d,%d), %d errors (us per codeword; syndromes and Chien on "
+         "table / %s)\n",
+         rs_N, rs_K, CODEC_ERR, rs_gf16_kernel(RS_GF16_CONST));
+  printf("  encode %.1f | decode %.1f / %.1f | clean decode %.1f / %.1f\n",
+         t_vec[0], t_tab[1], t_vec[1], t_tab[2], t_vec[2]);
+
+  free(a);
+  free(b);
+  free(c);
+  return 0;
+}
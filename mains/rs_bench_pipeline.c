@@ -0,0 +1,176 @@
+/**
+ * @file rs_bench_pipeline.c
+ * @brief Throughput benchmark: stage pipeline vs. thread-pool-per-codeword.
+ *
+ * A stream of RS codewords is generated, a fraction of them is corrupted
+ * with random symbol errors, and the same stream is decoded by:
+ *
+ *   1. single thread  : rs_decode_sym() per codeword
+ *   2. codeword pool  : P threads, each running the full decoder on the
+ *                       next codeword taken from a shared counter
+ *   3. stage pipeline : rs_pipeline with syndrome and solver stages
+ *
+ * Every method must reproduce the transmitted codewords; throughput is
+ * reported in codewords per second.
+ *
+ * Usage:
+ *   rs_bench_pipeline [frames] [dirty_percent] [errors] [synd_thr] [solve_thr]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "rs_decoder.h"
+#include "rs_encoder.h"
+#include "rs_gf.h"
+#include "rs_pipeline.h"
+
+/* ------------------------------------------------------------------------- */
+/* Benchmark parameters                                                       */
+/* ------------------------------------------------------------------------- */
+static const int RS_M = 8;
+static const int RS_N = 255;
+static const int RS_K = 223;
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Thread-pool-per-codeword baseline                                          */
+/* ------------------------------------------------------------------------- */
+typedef struct {
+  rs_sym_t *frames;
+  size_t n_frames;
+  atomic_size_t next;
+} pool_job;
+
+static void *pool_worker(void *arg) {
+  pool_job *job = (pool_job *)arg;
+  for (;;) {
+    size_t f = atomic_fetch_add(&job->next, 1);
+    if (f >= job->n_frames)
+      break;
+    rs_decode_sym(&job->frames[f * rs_N]);
+  }
+  return NULL;
+}
+
+static void decode_pool(rs_sym_t *frames, size_t n_frames, int n_threads) {
+  pthread_t tid[n_threads];
+  pool_job job;
+  job.frames = frames;
+  job.n_frames = n_frames;
+  atomic_init(&job.next, 0);
+
+  for (int i = 0; i < n_threads; i++)
+    pthread_create(&tid[i], NULL, pool_worker, &job);
+  for (int i = 0; i < n_threads; i++)
+    pthread_join(tid[i], NULL);
+}
+
+static size_t count_mismatch(const rs_sym_t *a, const rs_sym_t *b,
+                             size_t n_frames) {
+  size_t bad = 0;
+  for (size_t f = 0; f < n_frames; f++)
+    if (memcmp(&a[f * rs_N], &b[f * rs_N], rs_N * sizeof(rs_sym_t)) != 0)
+      bad++;
+  return bad;
+}
+
+static void report(const char *name, double sec, size_t n_frames,
+                   size_t bad) {
+  printf("  %-22s %8.3f s  %12.0f cw/s  mismatches=%zu\n", name, sec,
+         n_frames / sec, bad);
+}
+
+/* ======================================================================== */
+/* MAIN                                                                      */
+/* ======================================================================== */
+int main(int argc, char **argv) {
+  size_t n_frames = (argc > 1) ? (size_t)atol(argv[1]) : 200000;
+  int dirty_pct = (argc > 2) ? atoi(argv[2]) : 10;
+  int n_err = (argc > 3) ? atoi(argv[3]) : 8;
+  int n_synd = (argc > 4) ? atoi(argv[4]) : 1;
+  int n_solve = (argc > 5) ? atoi(argv[5]) : 1;
+
+  int N = RS_N;
+  int K = RS_K;
+
+  if (rs_gf_init(RS_M, N, K, N - K) != 0) {
+    fprintf(stderr, "rs_gf_init failed.\n");
+    return 1;
+  }
+
+  printf("RS(%d,%d) pipeline benchmark: %zu frames, %d%% dirty, %d errors\n",
+         N, K, n_frames, dirty_pct, n_err);
+
+  rs_sym_t *tx = (rs_sym_t *)malloc(n_frames * N * sizeof(rs_sym_t));
+  rs_sym_t *rx = (rs_sym_t *)malloc(n_frames * N * sizeof(rs_sym_t));
+  rs_sym_t *work = (rs_sym_t *)malloc(n_frames * N * sizeof(rs_sym_t));
+  rs_sym_t *info = (rs_sym_t *)malloc(K * sizeof(rs_sym_t));
+  if (!tx || !rx || !work || !info) {
+    fprintf(stderr, "Memory allocation failed.\n");
+    return 1;
+  }
+
+  srand(1);
+  for (size_t f = 0; f < n_frames; f++) {
+    for (int i = 0; i < K; i++)
+      info[i] = (rs_sym_t)(rand() & rs_Np);
+    rs_encode_sym(info, &tx[f * N]);
+  }
+
+  memcpy(rx, tx, n_frames * N * sizeof(rs_sym_t));
+  for (size_t f = 0; f < n_frames; f++) {
+    if (rand() % 100 >= dirty_pct)
+      continue;
+    for (int e = 0; e < n_err; e++)
+      rx[f * N + rand() % N] ^= (rs_sym_t)(1 + rand() % rs_Np);
+  }
+
+  /* 1) Single thread */
+  memcpy(work, rx, n_frames * N * sizeof(rs_sym_t));
+  double t0 = now_sec();
+  for (size_t f = 0; f < n_frames; f++)
+    rs_decode_sym(&work[f * N]);
+  report("single thread", now_sec() - t0, n_frames,
+         count_mismatch(work, tx, n_frames));
+
+  /* 2) Thread pool, one codeword per task */
+  int n_pool = n_synd + n_solve;
+  memcpy(work, rx, n_frames * N * sizeof(rs_sym_t));
+  t0 = now_sec();
+  decode_pool(work, n_frames, n_pool);
+  char name[64];
+  snprintf(name, sizeof(name), "codeword pool (%d)", n_pool);
+  report(name, now_sec() - t0, n_frames, count_mismatch(work, tx, n_frames));
+
+  /* 3) Stage pipeline */
+  rs_pipeline *p = rs_pipeline_create(n_synd, n_solve, 1024);
+  if (!p) {
+    fprintf(stderr, "rs_pipeline_create failed.\n");
+    return 1;
+  }
+  memcpy(work, rx, n_frames * N * sizeof(rs_sym_t));
+  t0 = now_sec();
+  rs_pipeline_decode(p, work, n_frames, NULL, NULL, NULL);
+  snprintf(name, sizeof(name), "pipeline (%d+%d)", n_synd, n_solve);
+  report(name, now_sec() - t0, n_frames, count_mismatch(work, tx, n_frames));
+  rs_pipeline_destroy(p);
+
+  free(tx);
+  free(rx);
+  free(work);
+  free(info);
+
+  return 0;
+}
@@ -0,0 +1,246 @@
+/**
+ * @file rs_bench_poly.c
+ * @brief Algorithm benchmark for the polynomial module (rs_poly.h).
+ *
+ * For each kernel the program times the reference algorithm against the
+ * fast one on random polynomials and checks that both agree:
+ *
+ *   mul   : rs_poly_mul_school() vs. rs_poly_mul() (Karatsuba), n × n
+ *   div   : rs_poly_divmod()     vs. rs_poly_divmod_pre(), 2n by n + 1
+ *   eval  : rs_poly_eval() per point vs. rs_poly_eval_geom(), T points
+ *           of a length-n polynomial (the syndrome shape)
+ *
+ * and prints microseconds per call plus the speedup (reference / fast).
+ * Finally the key equation is solved for one corrupted codeword by
+ * extended Euclid (rs_poly_xgcd()) and by Berlekamp–Massey
+ * (rs_decode_locator_ws()); both locators must coincide.
+ *
+ * Usage:
+ *   rs_bench_poly [m] [n ...]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "rs_decoder.h"
+#include "rs_encoder.h"
+#include "rs_gf.h"
+#include "rs_poly.h"
+#include "rs_workspace.h"
+
+#define MIN_SEC 0.1 /* measure each kernel for at least this long */
+#define EVAL_PTS 32 /* points per evaluation (T of a typical code) */
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+typedef enum {
+  OP_MUL_SCHOOL,
+  OP_MUL,
+  OP_DIV,
+  OP_DIV_PRE,
+  OP_EVAL,
+  OP_EVAL_GEOM
+} bench_op;
+
+typedef struct {
+  int n;
+  rs_sym_t *a, *b, *c, *q, *r, *w, *pts;
+  rs_poly_divisor div;
+} bench_data;
+
+/* Run one kernel repeatedly; returns microseconds per call */
+static double time_op(bench_op op, bench_data *d) {
+  int n = d->n;
+  long iters = 0;
+  double t0 = now_sec(), t;
+
+  do {
+    switch (op) {
+    case OP_MUL_SCHOOL:
+      rs_poly_mul_school(d->a, n, d->b, n, d->c);
+      break;
+    case OP_MUL:
+      rs_poly_mul(d->a, n, d->b, n, d->c, d->w);
+      break;
+    case OP_DIV:
+      rs_poly_divmod(d->a, 2 * n, d->b, n + 1, d->q, d->r);
+      break;
+    case OP_DIV_PRE:
+      rs_poly_divmod_pre(&d->div, d->a, 2 * n, d->q, d->r);
+      break;
+    case OP_EVAL:
+      rs_poly_eval_many(d->a, n, d->pts, EVAL_PTS, d->c);
+      break;
+    case OP_EVAL_GEOM:
+      rs_poly_eval_geom(d->a, n, 1, 1, EVAL_PTS, d->c);
+      break;
+    }
+    iters++;
+    t = now_sec() - t0;
+  } while (t < MIN_SEC);
+
+  return t * 1e6 / iters;
+}
+
+static void random_poly(rs_sym_t *a, int n) {
+  for (int i = 0; i < n; i++)
+    a[i] = (rs_sym_t)(rand() & rs_Np);
+}
+
+/* Both kernels of one pair must give the same result */
+static int check_size(bench_data *d) {
+  int n = d->n;
+  size_t bytes = (size_t)(2 * n + 1) * sizeof(rs_sym_t);
+  rs_sym_t *ref = (rs_sym_t *)malloc(bytes);
+  rs_sym_t *ref_r = (rs_sym_t *)malloc(bytes);
+  int ok = ref && ref_r;
+
+  if (ok) {
+    rs_poly_mul_school(d->a, n, d->b, n, ref);
+    rs_poly_mul(d->a, n, d->b, n, d->c, d->w);
+    ok &= (memcmp(ref, d->c, (size_t)(2 * n - 1) * sizeof(rs_sym_t)) == 0);
+
+    rs_poly_divmod(d->a, 2 * n, d->b, n + 1, ref, ref_r);
+    rs_poly_divmod_pre(&d->div, d->a, 2 * n, d->q, d->r);
+    ok &= (memcmp(ref, d->q, (size_t)n * sizeof(rs_sym_t)) == 0);
+    ok &= (memcmp(ref_r, d->r, (size_t)n * sizeof(rs_sym_t)) == 0);
+
+    rs_poly_eval_many(d->a, n, d->pts, EVAL_PTS, ref);
+    rs_poly_eval_geom(d->a, n, 1, 1, EVAL_PTS, d->c);
+    ok &= (memcmp(ref, d->c, EVAL_PTS * sizeof(rs_sym_t)) == 0);
+  }
+  free(ref);
+  free(ref_r);
+  return ok;
+}
+
+/* Key equation of one corrupted RS(Np, Np - 32) word, Euclid vs. BM */
+static int check_key_equation(int m) {
+  int T = 32, t = T / 2;
+  if (rs_gf_init(m, (1 << m) - 1, (1 << m) - 1 - T, T) != 0)
+    return 0;
+
+  int N = rs_N;
+  size_t n = (size_t)T + 1;
+  rs_workspace *ws = rs_workspace_create();
+  rs_sym_t *cw = (rs_sym_t *)malloc((size_t)N * sizeof(rs_sym_t));
+  rs_sym_t *buf = (rs_sym_t *)calloc(
+      5 * n + rs_poly_xgcd_scratch(T + 1, T), sizeof(rs_sym_t));
+  if (!ws || !cw || !buf) {
+    fprintf(stderr, "Memory allocation failed.\n");
+    exit(1);
+  }
+  rs_sym_t *xt = buf, *synd = xt + n, *sigma = synd + n, *omega = sigma + n;
+  rs_sym_t *loc = omega + n, *scratch = loc + n;
+
+  random_poly(cw, rs_K);
+  rs_encode_sym(cw, cw);
+  for (int i = 0; i < t; i++)
+    cw[rand() % N] ^= (rs_sym_t)(1 + rand() % rs_Np);
+  rs_decode_syndromes(cw, synd);
+  int L = rs_decode_locator_ws(ws, synd, sigma);
+
+  /* x^T = q·S + Ω, stopped at deg Ω < t: the cofactor of S is λ·σ */
+  xt[T] = 1;
+  rs_poly_xgcd(xt, T + 1, synd, T, t, omega, NULL, loc, scratch);
+  uint16_t inv = rs_gf_inv(loc[0]);
+  for (int i = 0; i <= T; i++)
+    loc[i] = (rs_sym_t)rs_gf_mul(loc[i], inv);
+
+  int ok = (L <= t) && rs_poly_deg(loc, T + 1) == L &&
+           memcmp(loc, sigma, (size_t)(L + 1) * sizeof(rs_sym_t)) == 0;
+  printf("Key equation, GF(2^%d) T = %d, <= %d errors: Euclid %s BM (L = %d)\n",
+         m, T, t, ok ? "=" : "!=", L);
+
+  rs_workspace_destroy(ws);
+  free(cw);
+  free(buf);
+  return ok;
+}
+
+/* ======================================================================== */
+/* MAIN                                                                      */
+/* ======================================================================== */
+int main(int argc, char **argv) {
+  int m = (argc > 1) ? atoi(argv[1]) : 16;
+
+  static const int default_n[] = {16, 32, 64, 128, 256, 512, 1024, 4096};
+  int n_sizes = (argc > 2) ? argc - 2 : 8;
+
+  if (rs_gf_init(m, (1 << m) - 1, (1 << m) - 3, 2) != 0)
+    return 1;
+
+  printf("Polynomial kernels over GF(2^%d)\n", m);
+  printf("(us per call; speedup = reference / fast)\n\n");
+  printf("     n  |  mul: school  karatsuba    x  |"
+         "  div: long   prepared    x  |  eval(%d): horner    geom    x\n",
+         EVAL_PTS);
+
+  for (int c = 0; c < n_sizes; c++) {
+    int n = (argc > 2) ? atoi(argv[2 + c]) : default_n[c];
+    if (n < 1)
+      continue;
+
+    bench_data d;
+    d.n = n;
+    d.a = (rs_sym_t *)malloc((size_t)(2 * n) * sizeof(rs_sym_t));
+    d.b = (rs_sym_t *)malloc((size_t)(n + 1) * sizeof(rs_sym_t));
+    d.c = (rs_sym_t *)malloc((size_t)(2 * n) * sizeof(rs_sym_t));
+    d.q = (rs_sym_t *)malloc((size_t)n * sizeof(rs_sym_t));
+    d.r = (rs_sym_t *)malloc((size_t)n * sizeof(rs_sym_t));
+    d.w = (rs_sym_t *)malloc((rs_poly_mul_scratch(n, n) + 1) *
+                             sizeof(rs_sym_t));
+    d.pts = (rs_sym_t *)malloc(EVAL_PTS * sizeof(rs_sym_t));
+    if (!d.a || !d.b || !d.c || !d.q || !d.r || !d.w || !d.pts) {
+      fprintf(stderr, "Memory allocation failed.\n");
+      return 1;
+    }
+
+    srand(1);
+    random_poly(d.a, 2 * n);
+    random_poly(d.b, n + 1);
+    d.b[n] |= 1;
+    for (int k = 0; k < EVAL_PTS; k++)
+      d.pts[k] = rs_gf_exp[(1 + k) % rs_Np];
+    if (rs_poly_divisor_init(&d.div, d.b, n + 1, 2 * n) != 0) {
+      fprintf(stderr, "n = %d: divisor preparation failed\n", n);
+      return 1;
+    }
+
+    if (!check_size(&d)) {
+      fprintf(stderr, "n = %d: fast kernels disagree with the reference\n",
+              n);
+      return 1;
+    }
+
+    double t[6];
+    for (int op = 0; op < 6; op++)
+      t[op] = time_op((bench_op)op, &d);
+
+    printf("%6d  | %12.1f %10.1f %5.2f | %10.1f %10.1f %5.2f |"
+           " %16.1f %7.1f %5.2f\n",
+           n, t[0], t[1], t[0] / t[1], t[2], t[3], t[2] / t[3], t[4], t[5],
+           t[4] / t[5]);
+    fflush(stdout);
+
+    rs_poly_divisor_free(&d.div);
+    free(d.a);
+    free(d.b);
+    free(d.c);
+    free(d.q);
+    free(d.r);
+    free(d.w);
+    free(d.pts);
+  }
+
+  printf("\n");
+  return check_key_equation(m > 12 ? 12 : m) ? 0 : 1;
+}
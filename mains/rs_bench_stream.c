@@ -0,0 +1,200 @@
+/**
+ * @file rs_bench_stream.c
+ * @brief Receive latency: buffered rs_decode_sym_ws() vs. the streaming
+ *        decoder (rs_decode_stream_*).
+ *
+ * Codewords arrive in chunks of C symbols. The buffered decoder starts
+ * when the last chunk is in; the streaming decoder pushes every chunk as
+ * it arrives and finishes after the last one. The program first checks
+ * that both give the same status and corrected word (clean words and 1..t
+ * symbol errors), then times per codeword
+ *
+ *   latency: last symbol in → word released (buffered: the whole decode;
+ *            streamed: the last push plus rs_decode_stream_finish())
+ *   pushes : streamed work spread over the arrival of the codeword
+ *
+ * for clean words and words with t / 2 symbol errors, in microseconds,
+ * plus the latency ratio (buffered / streamed).
+ *
+ * Usage:
+ *   rs_bench_stream [chunk]            (a set of codes, m = 8 to 16)
+ *   rs_bench_stream chunk m N K T      (one code)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "rs_decoder.h"
+#include "rs_encoder.h"
+#include "rs_gf.h"
+#include "rs_workspace.h"
+
+#define MIN_SEC 0.2    /* measure each case for at least this long */
+#define CHECK_WORDS 64 /* random words compared between the decoders */
+
+typedef struct {
+  int m, N, K, T;
+} code_params;
+
+static const code_params default_codes[] = {
+    {8, 255, 239, 16},   {8, 255, 223, 32},   {8, 204, 188, 16},
+#if RS_M_MAX > 8
+    {10, 1023, 991, 32}, {12, 4095, 4063, 32}, {16, 65535, 65503, 32},
+#endif
+};
+#define N_DEFAULT_CODES (int)(sizeof(default_codes) / sizeof(default_codes[0]))
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* Random codeword with "errors" symbol errors */
+static void random_word(rs_sym_t *c, int errors) {
+  for (int i = 0; i < rs_K; i++)
+    c[i] = (rs_sym_t)(rand() & rs_Np);
+  rs_encode_sym(c, c);
+  for (int e = 0; e < errors; e++)
+    c[rand() % rs_N] ^= (rs_sym_t)(1 + rand() % rs_Np);
+}
+
+/* Push the codeword in chunks; returns the seconds spent before the last
+ * chunk */
+static double push_chunks(rs_decode_stream *st, int chunk) {
+  double t0 = now_sec(), t = 0;
+  int pos = 0;
+
+  while (pos < rs_N) {
+    int n = (rs_N - pos < chunk) ? rs_N - pos : chunk;
+    if (pos + n == rs_N)
+      t = now_sec() - t0;
+    rs_decode_stream_push(st, n);
+    pos += n;
+  }
+  return t;
+}
+
+/* Streamed and buffered decodes of the same words must agree */
+static int check_code(rs_workspace *ws, rs_sym_t *c, rs_sym_t *r,
+                      int chunk) {
+  rs_decode_stream st;
+
+  for (int w = 0; w < CHECK_WORDS; w++) {
+    random_word(c, w % (rs_T / 2 + 2));
+    memcpy(r, c, (size_t)rs_N * sizeof(rs_sym_t));
+    int ref = rs_decode_sym_ws(ws, c);
+
+    rs_decode_stream_begin(&st, ws, r);
+    push_chunks(&st, chunk);
+    int status = rs_decode_stream_finish(&st);
+    if (status != ref ||
+        memcmp(r, c, (size_t)rs_N * sizeof(rs_sym_t)) != 0) {
+      fprintf(stderr, "RS(%d,%d): streamed decode disagrees\n", rs_N, rs_K);
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/* Microseconds per codeword: t[0] buffered latency, t[1] streamed
+ * latency, t[2] streamed push work */
+static void time_case(rs_workspace *ws, const rs_sym_t *word, rs_sym_t *r,
+                      int chunk, double *t) {
+  size_t bytes = (size_t)rs_N * sizeof(rs_sym_t);
+  rs_decode_stream st;
+  long iters = 0;
+  double tb = 0, tl = 0, tp = 0, t0, t_last;
+
+  do {
+    memcpy(r, word, bytes);
+    t0 = now_sec();
+    rs_decode_sym_ws(ws, r);
+    tb += now_sec() - t0;
+
+    memcpy(r, word, bytes);
+    rs_decode_stream_begin(&st, ws, r);
+    t0 = now_sec();
+    t_last = push_chunks(&st, chunk);
+    rs_decode_stream_finish(&st);
+    double t1 = now_sec() - t0;
+    tl += t1 - t_last;
+    tp += t1;
+    iters++;
+  } while (tb + tp < 2 * MIN_SEC);
+
+  t[0] = tb * 1e6 / iters;
+  t[1] = tl * 1e6 / iters;
+  t[2] = tp * 1e6 / iters;
+}
+
+static int bench_code(const code_params *p, int chunk) {
+  if (rs_gf_init(p->m, p->N, p->K, p->T) != 0)
+    return 0;
+
+  rs_workspace *ws = rs_workspace_create();
+  rs_sym_t *c = (rs_sym_t *)malloc((size_t)rs_N * sizeof(rs_sym_t));
+  rs_sym_t *r = (rs_sym_t *)malloc((size_t)rs_N * sizeof(rs_sym_t));
+  if (!ws || !c || !r) {
+    fprintf(stderr, "Memory allocation failed.\n");
+    exit(1);
+  }
+
+  srand(1);
+  int ok = check_code(ws, c, r, chunk);
+  if (ok) {
+    double tc[3], td[3];
+    random_word(c, 0);
+    time_case(ws, c, r, chunk, tc);
+    random_word(c, rs_T / 4);
+    time_case(ws, c, r, chunk, td);
+    printf("  RS(%5d,%5d) m=%2d | %8.2f %8.2f %6.1f %8.2f  |"
+           " %8.2f %8.2f %6.1f %8.2f\n",
+           rs_N, rs_K, rs_m, tc[0], tc[1], tc[0] / tc[1], tc[2], td[0],
+           td[1], td[0] / td[1], td[2]);
+    fflush(stdout);
+  }
+
+  rs_workspace_destroy(ws);
+  free(c);
+  free(r);
+  return ok;
+}
+
+/* ======================================================================== */
+/* MAIN                                                                      */
+/* ======================================================================== */
+int main(int argc, char **argv) {
+  code_params one;
+  const code_params *codes = default_codes;
+  int n_codes = N_DEFAULT_CODES;
+  int chunk = (argc > 1) ? atoi(argv[1]) : 16;
+
+  if (argc == 6) {
+    one.m = atoi(argv[2]);
+    one.N = atoi(argv[3]);
+    one.K = atoi(argv[4]);
+    one.T = atoi(argv[5]);
+    codes = &one;
+    n_codes = 1;
+  } else if (argc > 2 || chunk < 1) {
+    fprintf(stderr, "Usage: %s [chunk [m N K T]]\n", argv[0]);
+    return 1;
+  }
+
+  printf("Receive latency, %d-symbol chunks (us per codeword; "
+         "x = buffered / streamed latency)\n\n",
+         chunk);
+  printf("                       |  clean: latency            pushes  |"
+         "  dirty (t/2 errors): latency pushes\n");
+  printf("  code                 | buffered streamed      x  streamed  |"
+         " buffered streamed      x streamed\n");
+  for (int i = 0; i < n_codes; i++)
+    if (!bench_code(&codes[i], chunk))
+      return 1;
+  return 0;
+}
@@ -0,0 +1,181 @@
+/**
+ * @file rs_bench_syndromes.c
+ * @brief Direct vs. remainder syndrome backends (rs_decode_set_syndrome_
+ *        method()).
+ *
+ * For each code the program first checks that both backends return the
+ * same syndromes and clean/dirty status on random words (clean ones and
+ * ones with 1..t symbol errors). It then times rs_decode_syndromes() per
+ * codeword with each backend:
+ *
+ *   dirty: received words with t / 2 symbol errors
+ *   clean: valid codewords (the remainder backend stops at a zero
+ *          remainder)
+ *
+ * and prints microseconds per codeword plus the speedup (direct /
+ * remainder; > 1 means the remainder backend wins).
+ *
+ * Usage:
+ *   rs_bench_syndromes            (a set of codes, m = 8 to 16)
+ *   rs_bench_syndromes m N K T    (one code)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "rs_decoder.h"
+#include "rs_encoder.h"
+#include "rs_gf.h"
+
+#define MIN_SEC 0.2   /* measure each backend for at least this long */
+#define CHECK_WORDS 64 /* random words compared between the backends */
+#define WORDS 8       /* codewords cycled through while timing */
+
+typedef struct {
+  int m, N, K, T;
+} code_params;
+
+static const code_params default_codes[] = {
+    {8, 255, 239, 16},     {8, 255, 223, 32},     {8, 204, 188, 16},
+#if RS_M_MAX > 8
+    {10, 1023, 991, 32},   {12, 4095, 4063, 32},  {16, 65535, 65503, 32},
+    {16, 65535, 65279, 256},
+#endif
+};
+#define N_DEFAULT_CODES (int)(sizeof(default_codes) / sizeof(default_codes[0]))
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* Random codeword with "errors" symbol errors */
+static void random_word(rs_sym_t *c, int errors) {
+  for (int i = 0; i < rs_K; i++)
+    c[i] = (rs_sym_t)(rand() & rs_Np);
+  rs_encode_sym(c, c);
+  for (int e = 0; e < errors; e++)
+    c[rand() % rs_N] ^= (rs_sym_t)(1 + rand() % rs_Np);
+}
+
+/* Both backends on the same words */
+static int check_code(rs_sym_t *c, rs_sym_t *s_dir, rs_sym_t *s_rem) {
+  for (int w = 0; w < CHECK_WORDS; w++) {
+    random_word(c, w % (rs_T / 2 + 1));
+    rs_decode_set_syndrome_method(RS_SYND_DIRECT);
+    int d_dir = rs_decode_syndromes(c, s_dir);
+    rs_decode_set_syndrome_method(RS_SYND_REMAINDER);
+    int d_rem = rs_decode_syndromes(c, s_rem);
+    if (d_dir != d_rem ||
+        memcmp(s_dir, s_rem, (size_t)rs_T * sizeof(rs_sym_t)) != 0) {
+      fprintf(stderr, "RS(%d,%d): remainder syndromes disagree\n", rs_N,
+              rs_K);
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/* Microseconds per codeword with the active backend */
+static double time_syndromes(const rs_sym_t *words, rs_sym_t *synd) {
+  long iters = 0;
+  int dirty = 0;
+  double t0 = now_sec(), t;
+
+  do {
+    dirty += rs_decode_syndromes(words + (size_t)(iters % WORDS) * rs_N, synd);
+    iters++;
+    t = now_sec() - t0;
+  } while (t < MIN_SEC);
+
+  if (dirty < 0) /* keep the calls alive */
+    printf(" ");
+  return t * 1e6 / iters;
+}
+
+static int bench_code(const code_params *p) {
+  if (rs_gf_init(p->m, p->N, p->K, p->T) != 0)
+    return 0;
+
+  size_t N = (size_t)rs_N;
+  rs_sym_t *c = (rs_sym_t *)malloc(N * sizeof(rs_sym_t));
+  rs_sym_t *dirty = (rs_sym_t *)malloc(WORDS * N * sizeof(rs_sym_t));
+  rs_sym_t *clean = (rs_sym_t *)malloc(WORDS * N * sizeof(rs_sym_t));
+  rs_sym_t *s_dir = (rs_sym_t *)malloc((size_t)rs_T * sizeof(rs_sym_t));
+  rs_sym_t *s_rem = (rs_sym_t *)malloc((size_t)rs_T * sizeof(rs_sym_t));
+  if (!c || !dirty || !clean || !s_dir || !s_rem) {
+    fprintf(stderr, "Memory allocation failed.\n");
+    exit(1);
+  }
+
+  srand(1);
+  int ok = check_code(c, s_dir, s_rem);
+  if (ok) {
+    for (int w = 0; w < WORDS; w++) {
+      random_word(dirty + w * N, rs_T / 4);
+      random_word(clean + w * N, 0);
+    }
+
+    double t[2][2];
+    for (int b = 0; b < 2; b++) {
+      rs_decode_set_syndrome_method(b ? RS_SYND_REMAINDER : RS_SYND_DIRECT);
+      t[b][0] = time_syndromes(dirty, s_dir);
+      t[b][1] = time_syndromes(clean, s_dir);
+    }
+    printf("  RS(%5d,%5d) m=%2d | %9.2f %9.2f %6.2f  | %9.2f %9.2f %6.2f\n",
+           rs_N, rs_K, rs_m, t[0][0], t[1][0], t[0][0] / t[1][0], t[0][1],
+           t[1][1], t[0][1] / t[1][1]);
+    fflush(stdout);
+  }
+  rs_decode_set_syndrome_method(RS_SYND_DIRECT);
+
+  free(c);
+  free(dirty);
+  free(clean);
+  free(s_dir);
+  free(s_rem);
+  return ok;
+}
+
+/* ======================================================================== */
+/* MAIN                                                                      */
+/* ======================================================================== */
+int main(int argc, char **argv) {
+  code_params one;
+  const code_params *codes = default_codes;
+  int n_codes = N_DEFAULT_CODES;
+
+  if (argc == 5) {
+    one.m = atoi(argv[1]);
+    one.N = atoi(argv[2]);
+    one.K = atoi(argv[3]);
+    one.T = atoi(argv[4]);
+    codes = &one;
+    n_codes = 1;
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: %s [m N K T]\n", argv[0]);
+    return 1;
+  }
+
+  printf("Syndromes: direct vs. remainder (us per codeword; "
+         "speedup = direct / remainder)\n\n");
+  printf("                       |  dirty (t/2 errors)          |"
+         "  clean\n");
+  printf("  code                 |    direct remainder      x  |"
+         "    direct remainder      x\n");
+  for (int i = 0; i < n_codes; i++) {
+    if (codes[i].T > RS_SYND_REM_T_MAX) {
+      fprintf(stderr, "T = %d exceeds RS_SYND_REM_T_MAX (%d)\n", codes[i].T,
+              RS_SYND_REM_T_MAX);
+      return 1;
+    }
+    if (!bench_code(&codes[i]))
+      return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,194 @@
+/**
+ * @file rs_bench_tower.c
+ * @brief Tower-field GF((2^4)^2) kernels vs. log/exp tables in GF(256).
+ *
+ * The program first checks the tower representation (rs_tower.h) against
+ * the codec's field for rs_gf_init(8, ...) with the default polynomial:
+ * every product and inverse, through the scalar functions, the bit-sliced
+ * planes and each vector kernel the CPU supports. It then times
+ *
+ *   mul : c[i] = a[i]·b[i]   (rs_gf_mul() loop vs. rs_tower_mul_vec())
+ *   inv : c[i] = 1 / a[i]    (rs_gf_inv() loop vs. rs_tower_inv_vec())
+ *
+ * on random byte arrays and prints nanoseconds per symbol plus the speedup
+ * (log/exp / kernel; > 1 means the kernel wins).
+ *
+ * Usage:
+ *   rs_bench_tower [symbols]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "rs_gf.h"
+#include "rs_tower.h"
+
+#define MIN_SEC 0.2 /* measure each kernel for at least this long */
+
+static const char *const kernel_names[] = {"scalar", "bitslice", "ssse3",
+                                           "avx2"};
+#define N_KERNELS 4
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* 0: log/exp tables, 1: active tower kernel; op 0 = mul, 1 = inv */
+static void run_op(int tower, int op, const uint8_t *a, const uint8_t *b,
+                   uint8_t *c, size_t n) {
+  if (tower) {
+    if (op == 0)
+      rs_tower_mul_vec(a, b, c, n);
+    else
+      rs_tower_inv_vec(a, c, n);
+    return;
+  }
+  if (op == 0)
+    for (size_t i = 0; i < n; i++)
+      c[i] = (uint8_t)rs_gf_mul(a[i], b[i]);
+  else
+    for (size_t i = 0; i < n; i++)
+      c[i] = a[i] ? (uint8_t)rs_gf_inv(a[i]) : 0;
+}
+
+/* Nanoseconds per symbol */
+static double time_op(int tower, int op, const uint8_t *a, const uint8_t *b,
+                      uint8_t *c, size_t n) {
+  long iters = 0;
+  double t0 = now_sec(), t;
+
+  do {
+    run_op(tower, op, a, b, c, n);
+    iters++;
+    t = now_sec() - t0;
+  } while (t < MIN_SEC);
+
+  return t * 1e9 / ((double)iters * n);
+}
+
+/* Every product and inverse, against rs_gf_mul() / rs_gf_inv() */
+static int check_field(void) {
+  enum { PAIRS = 256 * 256 };
+  static uint8_t a[PAIRS], b[PAIRS], c[PAIRS], ref[PAIRS];
+  static uint8_t inv_ref[256], inv[256];
+  int ok = 1;
+
+  for (int i = 0; i < PAIRS; i++) {
+    a[i] = (uint8_t)(i >> 8);
+    b[i] = (uint8_t)i;
+    ref[i] = (uint8_t)rs_gf_mul(a[i], b[i]);
+  }
+  for (int x = 0; x < 256; x++)
+    inv_ref[x] = x ? (uint8_t)rs_gf_inv((uint16_t)x) : 0;
+
+  /* Scalar tower arithmetic and the isomorphism */
+  for (int i = 0; i < PAIRS && ok; i++)
+    ok = rs_tower_from(rs_tower_mul(rs_tower_to(a[i]), rs_tower_to(b[i]))) ==
+         ref[i];
+  for (int x = 0; x < 256 && ok; x++)
+    ok = rs_tower_from(rs_tower_to((uint8_t)x)) == x &&
+         rs_tower_from(rs_tower_inv(rs_tower_to((uint8_t)x))) == inv_ref[x];
+
+  /* Bit-sliced planes: round trip, products and inverses */
+  for (int i = 0; i < PAIRS && ok; i += 64) {
+    rs_tower_bs x, y;
+    uint8_t out[64];
+    rs_tower_bs_load(a + i, &x);
+    rs_tower_bs_store(&x, out);
+    ok = (memcmp(out, a + i, 64) == 0);
+    rs_tower_bs_load(b + i, &y);
+    rs_tower_bs_mul(&x, &y, &y);
+    rs_tower_bs_store(&y, out);
+    ok = ok && (memcmp(out, ref + i, 64) == 0);
+  }
+  for (int i = 0; i < 256 && ok; i += 64) {
+    rs_tower_bs x;
+    rs_tower_bs_load(b + i, &x);
+    rs_tower_bs_inv(&x, &x);
+    rs_tower_bs_store(&x, inv + i);
+    ok = (memcmp(inv + i, inv_ref + i, 64) == 0);
+  }
+  if (!ok) {
+    fprintf(stderr, "Tower arithmetic disagrees with rs_gf_mul()\n");
+    return 0;
+  }
+
+  /* Each vector kernel, odd length for the scalar tail */
+  for (int k = 0; k < N_KERNELS; k++) {
+    if (rs_tower_set_kernel(kernel_names[k]) != 0)
+      continue;
+    rs_tower_mul_vec(a, b, c, PAIRS - 3);
+    ok = (memcmp(c, ref, PAIRS - 3) == 0);
+    rs_tower_inv_vec(b, inv, 255);
+    ok = ok && (memcmp(inv, inv_ref, 255) == 0);
+    if (!ok) {
+      fprintf(stderr, "Kernel %s disagrees with rs_gf_mul()\n",
+              kernel_names[k]);
+      return 0;
+    }
+  }
+  rs_tower_set_kernel(NULL);
+  return 1;
+}
+
+/* ======================================================================== */
+/* MAIN                                                                      */
+/* ======================================================================== */
+int main(int argc, char **argv) {
+  size_t n = (argc > 1) ? (size_t)atol(argv[1]) : 4096;
+
+  if (rs_gf_init(8, 255, 223, 32) != 0)
+    return 1;
+  if (!check_field())
+    return 1;
+
+  uint8_t *a = (uint8_t *)malloc(n);
+  uint8_t *b = (uint8_t *)malloc(n);
+  uint8_t *c = (uint8_t *)malloc(n);
+  if (!a || !b || !c) {
+    fprintf(stderr, "Memory allocation failed.\n");
+    return 1;
+  }
+  srand(1);
+  for (size_t i = 0; i < n; i++) {
+    a[i] = (uint8_t)rand();
+    b[i] = (uint8_t)rand();
+  }
+
+  printf("GF(256) tower kernels vs. log/exp tables, %zu symbols "
+         "(default kernel: %s)\n",
+         n, rs_tower_kernel());
+  printf("(ns per symbol; speedup = log/exp / kernel)\n\n");
+  printf("  kernel    |   mul: log/exp   tower      x  |"
+         "   inv: log/exp   tower      x\n");
+
+  double ref[2];
+  for (int op = 0; op < 2; op++)
+    ref[op] = time_op(0, op, a, b, c, n);
+
+  for (int k = 0; k < N_KERNELS; k++) {
+    if (rs_tower_set_kernel(kernel_names[k]) != 0) {
+      printf("  %-9s |   (not supported by this CPU)\n", kernel_names[k]);
+      continue;
+    }
+    double t[2];
+    for (int op = 0; op < 2; op++)
+      t[op] = time_op(1, op, a, b, c, n);
+    printf("  %-9s | %14.2f %7.2f %6.2f  | %14.2f %7.2f %6.2f\n",
+           kernel_names[k], ref[0], t[0], ref[0] / t[0], ref[1], t[1],
+           ref[1] / t[1]);
+    fflush(stdout);
+  }
+  rs_tower_set_kernel(NULL);
+
+  free(a);
+  free(b);
+  free(c);
+  return 0;
+}
@@ -8,21 +8,72 @@
  *
  * Output (with parameters auto-embedded in filenames):
  *   results/rs_ber_m<M>_N<N>_K<K>_data.csv
+ *     EbN0_dB, BER_RS, BER_bpsk, BER_est
  *   results/rs_bler_m<M>_N<N>_K<K>_data.csv
+ *     EbN0_dB, BLER_RS, BLER_bpsk, enc_cw_per_s, dec_cw_per_s,
+ *     enc_ns_per_cw, dec_ns_per_cw
+ *   BER_est is the receiver's own pre-FEC BER estimate, corrected bits per
+ *   received bit (rs_stats.h). Channel bits see Es/N0 = R·Eb/N0, so it
+ *   sits above BER_bpsk, the uncoded reference at the same Eb/N0.
+ *   The throughput columns time rs_encode() and rs_decode() alone (wall
+ *   clock, channel generation excluded); decoding slows down as the error
+ *   rate rises.
+ *
+ * Concatenated mode (rs_ber_bler -c [depth] [frames]):
+ *   The CCSDS/DVB chain RS outer code → symbol block interleaver of
+ *   <depth> codewords → rate-1/2 K = 7 convolutional inner code (rs_conv.h)
+ *   → BPSK/AWGN → 8-bit soft-decision Viterbi → deinterleaver → RS. Eb/N0
+ *   is per information bit of the whole chain. Output:
+ *     results/rs_cc_ber_m<M>_N<N>_K<K>_I<depth>_data.csv
+ *       EbN0_dB, BER_RS, BER_viterbi, BER_bpsk
+ *     results/rs_cc_bler_m<M>_N<N>_K<K>_I<depth>_data.csv
+ *       EbN0_dB, BLER_RS, SER_viterbi, burst_bits, max_symerr
+ *   SER_viterbi is the symbol error rate the RS decoder sees, burst_bits the
+ *   mean length of a Viterbi error burst (errors closer than K bits are one
+ *   burst) and max_symerr the most symbol errors in one RS codeword.
+ *
+ * Block-fading mode (rs_ber_bler -f [q] [block] [Kf] [fdT] [erase_dB]
+ *                    [frames] [threads]):
+ *   RS → Gray BPSK / QPSK / 16-QAM / 64-QAM (q = 1, 2, 4, 6 bits per
+ *   channel symbol) → flat fading h, constant over <block> channel symbols
+ *   (1 = per-symbol fading), Rayleigh or Rician with K-factor Kf → AWGN →
+ *   coherent detection with perfect CSI. fdT = 0 draws i.i.d. blocks,
+ *   fdT > 0 a Jakes process (Doppler × block duration) within each
+ *   codeword. RS symbols whose weakest |h|^2·Es/N0 is below erase_dB are
+ *   marked as erasures (the T weakest at most). Every codeword is decoded
+ *   both errors-only and with the erasures, on <threads> worker threads
+ *   (0 = one per CPU). Output:
+ *     results/rs_fade_m<M>_N<N>_K<K>_Q<q>_B<block>_R<Kf>_D<fdT>_data.csv
+ *       EbN0_dB, BER_raw, BER_RS, BLER_RS, BER_RS_eras, BLER_RS_eras,
+ *       eras_per_cw, eras_wrong
+ *   eras_wrong is the fraction of erased symbols that were in error.
  *
  * Assumptions:
  *   - RS code is over GF(2^m)
  *   - BPSK: 0 → -1, 1 → +1
  *   - Hard decision before RS decoding
- *   - Uses the shortened RS model internally through rs_decode()
  *
- * Required API:
- *   void rs_gf_init(int m, int N, int K, int T);
- *   void rs_encode(const int *u_bits, int *c_bits);
- *   void rs_decode(const int *r_bits, int *c_hat_bits, int *u_hat_bits);
+ * The AWGN path works on blocks of FRAME_BLOCK packed frames (rs_pack.h)
+ * held in one 64-byte aligned arena: random information symbols are
+ * packed, encoded with rs_encode_batch(), passed through the equivalent
+ * binary symmetric channel (BPSK + AWGN + hard decision flips each code
+ * bit with p = Q(sqrt(2 R Eb/N0)); flips are drawn by geometric skips, so
+ * the channel costs O(errors), not O(bits)) and decoded with
+ * rs_decode_batch_bits() on all CPUs.
+ *
+ * The fading path runs one worker per CPU, each on blocks of FRAME_BLOCK
+ * symbol frames: rs_encode_batch_sym(), a per-codeword channel over
+ * flat buffers (constellation table, branch-free slicer, Jakes
+ * oscillators advanced by phasor rotation, polar-method noise), and
+ * rs_decode_batch_sym() for errors-only decoding. Erasure lists differ
+ * per codeword, so errors-and-erasures decoding stays word by word.
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <math.h>
+#include <pthread.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -35,9 +86,14 @@
 #include <sys/types.h>
 #endif
 
+#include "rs_batch.h"
+#include "rs_conv.h"
 #include "rs_decoder.h"
 #include "rs_encoder.h"
 #include "rs_gf.h"
+#include "rs_pack.h"
+#include "rs_stats.h"
+#include "rs_workspace.h"
 
 #define PI 3.141592653589793
 
@@ -49,10 +105,29 @@ static const int RS_N = 255; /* Codeword length (symbols)               */
 static const int RS_K = 223; /* Information length (symbols)            */
 
 static const int N_TRIALS = 100000; /* Frames per SNR point              */
+static const int FRAME_BLOCK = 256; /* Frames per batch encode/decode    */
 static const double EbN0_MIN_dB = 0.0;
 static const double EbN0_MAX_dB = 14.0;
 static const double EbN0_STEP_dB = 0.5;
 
+/* Concatenated chain (-c) */
+static const int CC_DEPTH = 4;     /* Interleaving depth (codewords)     */
+static const int CC_FRAMES = 2000; /* Interleaved frames per SNR point   */
+static const double CC_EbN0_MIN_dB = 0.0;
+static const double CC_EbN0_MAX_dB = 4.0;
+static const double CC_EbN0_STEP_dB = 0.25;
+static const double CC_SOFT_SCALE = 64.0; /* soft value = 128 + 64 · y */
+
+/* Block-fading channel (-f) */
+static const int FD_BITS = 1;         /* Bits per channel symbol (BPSK)   */
+static const int FD_BLOCK = 16;       /* Channel symbols per fading block */
+static const double FD_ERASE_dB = 0.0;  /* Erase below |h|^2·Es/N0   */
+static const int FD_FRAMES = 20000;   /* Codewords per SNR point          */
+static const double FD_EbN0_MIN_dB = 0.0;
+static const double FD_EbN0_MAX_dB = 30.0;
+static const double FD_EbN0_STEP_dB = 2.0;
+#define FADE_OSC 16 /* Jakes sinusoids per quadrature component */
+
 /* ------------------------------------------------------------------------- */
 /* Utilities: Gaussian noise (Box–Muller)                                     */
 /* ------------------------------------------------------------------------- */
@@ -71,10 +146,727 @@ static double bpsk_ber(double EbN0_linear) {
   return 0.5 * erfc(sqrt(EbN0_linear));
 }
 
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void make_results_dir(void) {
+#ifdef _WIN32
+  _mkdir("results");
+#else
+  mkdir("results", 0777);
+#endif
+}
+
+/* ------------------------------------------------------------------------- */
+/* Block simulation helpers                                                  */
+/* ------------------------------------------------------------------------- */
+#define ARENA_ALIGN 64
+
+static size_t arena_size(size_t bytes) {
+  return (bytes + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+}
+
+/* Next ARENA_ALIGN-aligned piece of an arena */
+static void *arena_take(uint8_t **next, size_t bytes) {
+  void *p = *next;
+  *next += arena_size(bytes);
+  return p;
+}
+
+/* xorshift64*: one private generator per thread */
+static uint64_t sim_rng(uint64_t *s) {
+  *s ^= *s >> 12;
+  *s ^= *s << 25;
+  *s ^= *s >> 27;
+  return *s * 0x2545F4914F6CDD1Dull;
+}
+
+/* Uniform in (0, 1), never 0 or 1 */
+static double sim_unit(uint64_t *s) {
+  return ((sim_rng(s) >> 11) + 0.5) * 0x1.0p-53;
+}
+
+/* Failures before the next success, success probability 1 - exp(log_q) */
+static long long geometric(uint64_t *s, double log_q) {
+  double g = log(sim_unit(s)) / log_q;
+  return g < 4e18 ? (long long)g : (long long)4e18;
+}
+
+/* Differing bits among the first n_bits of two packed buffers */
+static int packed_bit_errors(const uint8_t *a, const uint8_t *b, int n_bits) {
+  int e = 0, i = 0;
+  for (; i < n_bits / 8; i++)
+    e += __builtin_popcount((unsigned)(a[i] ^ b[i]));
+  if (n_bits % 8)
+    e += __builtin_popcount((unsigned)(a[i] ^ b[i]) &
+                            ((1u << (n_bits % 8)) - 1));
+  return e;
+}
+
+/* ======================================================================== */
+/* Concatenated chain: RS → interleaver → K = 7 code → AWGN → Viterbi → RS  */
+/* ======================================================================== */
+static int run_concatenated(int depth, int frames) {
+  int m = RS_M, N = RS_N, K = RS_K, T = N - K;
+
+  if (rs_gf_init(m, N, K, T) != 0) {
+    fprintf(stderr, "rs_gf_init failed.\n");
+    return 1;
+  }
+
+  int n_sym = N * depth;               /* interleaved frame, symbols */
+  int n_bits = n_sym * m;              /* inner code information bits */
+  int n_coded = RS_CONV_CODED(n_bits); /* channel bits */
+  double R = (double)(K * depth * m) / n_coded;
+
+  printf("Concatenated chain:\n");
+  printf("  Outer   : RS(%d, %d) over GF(2^%d)\n", N, K, m);
+  printf("  Interlv : depth %d (symbol block interleaver)\n", depth);
+  printf("  Inner   : rate 1/2, K = %d (171, 133), Viterbi kernel %s\n",
+         RS_CONV_K, rs_viterbi_kernel());
+  printf("  Rate    : %.4f, %d frames per SNR point\n\n", R, frames);
+
+  make_results_dir();
+  char fname_ber[256], fname_bler[256];
+  sprintf(fname_ber, "results/rs_cc_ber_m%d_N%d_K%d_I%d_data.csv", m, N, K,
+          depth);
+  sprintf(fname_bler, "results/rs_cc_bler_m%d_N%d_K%d_I%d_data.csv", m, N,
+          K, depth);
+  FILE *fp = fopen(fname_ber, "w");
+  FILE *fp_bler = fopen(fname_bler, "w");
+  if (!fp || !fp_bler) {
+    fprintf(stderr, "Cannot open results CSV files\n");
+    return 1;
+  }
+  fprintf(fp, "EbN0_dB,BER_RS,BER_viterbi,BER_bpsk\n");
+  fprintf(fp_bler, "EbN0_dB,BLER_RS,SER_viterbi,burst_bits,max_symerr\n");
+
+  rs_sym_t *cw = (rs_sym_t *)malloc((size_t)n_sym * sizeof(rs_sym_t));
+  rs_sym_t *rcw = (rs_sym_t *)malloc((size_t)n_sym * sizeof(rs_sym_t));
+  uint8_t *bits = (uint8_t *)malloc((size_t)n_bits);
+  uint8_t *bits_hat = (uint8_t *)malloc((size_t)n_bits);
+  uint8_t *coded = (uint8_t *)malloc((size_t)n_coded);
+  uint8_t *soft = (uint8_t *)malloc((size_t)n_coded);
+  rs_viterbi *vit = rs_viterbi_create(n_bits);
+  if (!cw || !rcw || !bits || !bits_hat || !coded || !soft || !vit) {
+    fprintf(stderr, "Memory allocation failed.\n");
+    return 1;
+  }
+
+  srand((unsigned int)time(NULL));
+  double vit_sec = 0;
+  long long vit_bits = 0;
+
+  printf("EbN0_dB, BER_RS, BER_viterbi, BER_bpsk, BLER_RS, SER_viterbi, "
+         "burst_bits, max_symerr\n");
+
+  for (double EbN0_dB = CC_EbN0_MIN_dB; EbN0_dB <= CC_EbN0_MAX_dB + 1e-9;
+       EbN0_dB += CC_EbN0_STEP_dB) {
+    double EbN0 = pow(10.0, EbN0_dB / 10.0);
+    double sigma = sqrt(1.0 / (2.0 * R * EbN0));
+
+    long long err_info = 0, err_vit = 0, err_sym = 0, cw_err = 0;
+    long long bursts = 0, burst_len = 0;
+    int max_symerr = 0;
+
+    for (int f = 0; f < frames; f++) {
+      /* Outer code: codeword j occupies cw[j*N .. j*N + N) */
+      for (int j = 0; j < depth; j++) {
+        for (int i = 0; i < K; i++)
+          cw[j * N + i] = (rs_sym_t)(rand() & rs_Np);
+        rs_encode_sym(&cw[j * N], &cw[j * N]);
+      }
+
+      /* Interleave (symbol n of every codeword, then n + 1, ...) and
+       * serialise LSB first */
+      for (int n = 0; n < N; n++)
+        for (int j = 0; j < depth; j++) {
+          rs_sym_t v = cw[j * N + n];
+          uint8_t *b = &bits[(n * depth + j) * m];
+          for (int k = 0; k < m; k++)
+            b[k] = (uint8_t)((v >> k) & 1);
+        }
+
+      /* Inner code, BPSK, AWGN, soft quantisation */
+      rs_conv_encode(bits, n_bits, coded);
+      for (int i = 0; i < n_coded; i++) {
+        double y = (coded[i] ? 1.0 : -1.0) + sigma * randn();
+        double q = 128.0 + CC_SOFT_SCALE * y;
+        soft[i] = (uint8_t)(q < 0.0 ? 0 : q > 255.0 ? 255 : (int)(q + 0.5));
+      }
+
+      clock_t c0 = clock();
+      rs_viterbi_decode(vit, soft, n_bits, bits_hat);
+      vit_sec += (double)(clock() - c0) / CLOCKS_PER_SEC;
+      vit_bits += n_bits;
+
+      /* Viterbi error bursts (gaps shorter than K bits merge) */
+      int last = -RS_CONV_K - 1, start = 0;
+      for (int i = 0; i < n_bits; i++) {
+        if (bits[i] == bits_hat[i])
+          continue;
+        err_vit++;
+        if (i - last > RS_CONV_K) {
+          if (last >= 0)
+            burst_len += last - start + 1;
+          bursts++;
+          start = i;
+        }
+        last = i;
+      }
+      if (last >= 0)
+        burst_len += last - start + 1;
+
+      /* Deinterleave, outer decode */
+      for (int n = 0; n < N; n++)
+        for (int j = 0; j < depth; j++) {
+          const uint8_t *b = &bits_hat[(n * depth + j) * m];
+          rs_sym_t v = 0;
+          for (int k = 0; k < m; k++)
+            v |= (rs_sym_t)(b[k] << k);
+          rcw[j * N + n] = v;
+        }
+
+      for (int j = 0; j < depth; j++) {
+        rs_sym_t *r = &rcw[j * N];
+        const rs_sym_t *c = &cw[j * N];
+        int symerr = 0;
+        for (int n = 0; n < N; n++)
+          symerr += (r[n] != c[n]);
+        err_sym += symerr;
+        if (symerr > max_symerr)
+          max_symerr = symerr;
+
+        rs_decode_sym(r);
+
+        int info_err_bits = 0;
+        for (int i = 0; i < K; i++)
+          for (int k = 0; k < m; k++)
+            info_err_bits += ((r[i] ^ c[i]) >> k) & 1;
+        err_info += info_err_bits;
+        cw_err += (info_err_bits > 0);
+      }
+    }
+
+    double BER_RS = (double)err_info / ((double)frames * depth * K * m);
+    double BER_VIT = (double)err_vit / ((double)frames * n_bits);
+    double BER_BPSK = bpsk_ber(EbN0);
+    double BLER_RS = (double)cw_err / ((double)frames * depth);
+    double SER_VIT = (double)err_sym / ((double)frames * n_sym);
+    double BURST = bursts ? (double)burst_len / bursts : 0.0;
+
+    printf("%5.2f, %.6e, %.6e, %.6e, %.6e, %.6e, %.2f, %d\n", EbN0_dB,
+           BER_RS, BER_VIT, BER_BPSK, BLER_RS, SER_VIT, BURST, max_symerr);
+    fflush(stdout);
+
+    fprintf(fp, "%5.2f,%.10e,%.10e,%.10e\n", EbN0_dB, BER_RS, BER_VIT,
+            BER_BPSK);
+    fprintf(fp_bler, "%5.2f,%.10e,%.10e,%.4f,%d\n", EbN0_dB, BLER_RS,
+            SER_VIT, BURST, max_symerr);
+  }
+
+  fclose(fp);
+  fclose(fp_bler);
+
+  printf("\nViterbi: %.1f Mbit/s (%s)\n",
+         vit_sec > 0 ? vit_bits / vit_sec / 1e6 : 0.0, rs_viterbi_kernel());
+  printf("Results saved to:\n  %s\n  %s\n", fname_ber, fname_bler);
+
+  free(cw);
+  free(rcw);
+  free(bits);
+  free(bits_hat);
+  free(coded);
+  free(soft);
+  rs_viterbi_destroy(vit);
+  return 0;
+}
+
+/* ======================================================================== */
+/* Block fading: RS → Gray QAM → Rayleigh/Rician → coherent detection → RS  */
+/* ======================================================================== */
+typedef struct {
+  int q;            /* Bits per channel symbol: 1 (BPSK), 2, 4, 6 (QAM) */
+  int block;        /* Channel symbols per fading coefficient (1 = per symbol) */
+  double rice_K;    /* Rician K-factor (linear), 0 = Rayleigh */
+  double fdT;       /* Doppler × block duration; 0 = i.i.d. blocks */
+  double erase_snr; /* Erase below this |h|^2·Es/N0 (linear), 0 = never */
+  int n_ch;         /* Channel symbols per codeword */
+  int n_blk;        /* Fading blocks per codeword */
+} fade_cfg;
+
+typedef struct {
+  const fade_cfg *cfg;
+  double sigma;      /* Noise std per real dimension (Es = 1) */
+  double erase_gain; /* Erase symbols under |h|^2 < erase_gain */
+  int frames;
+  uint64_t seed;
+  int failed; /* Allocation failure */
+
+  long long raw_err;            /* Detected bit errors before RS */
+  long long err, cw_err;        /* Errors-only decoding */
+  long long err_ee, cw_err_ee;  /* Errors-and-erasures decoding */
+  long long n_eras, eras_wrong; /* Erasures marked, ... on wrong symbols */
+} fade_job;
+
+/* Per-worker channel buffers of one codeword */
+typedef struct {
+  double cre[64], cim[64]; /* Constellation, by q-bit index */
+  double amp;              /* PAM step amplitude */
+  double *nre, *nim;       /* Noise, per channel symbol */
+  double *hre, *him;       /* Fading coefficient, per block */
+  double *gblk;            /* |h|^2, per block */
+  double *gain;            /* Weakest |h|^2, per RS symbol */
+  uint8_t *tx, *rx;        /* Sent and detected q-bit indices */
+} fade_buf;
+
+/* n samples of N(0, 1): Marsaglia's polar method, one log and one sqrt per
+ * pair and no trigonometry (sim_unit() never returns 0.5, so r > 0) */
+static void fade_randn(uint64_t *s, double *out, int n) {
+  for (int i = 0; i < n; i += 2) {
+    double u, v, r;
+    do {
+      u = 2.0 * sim_unit(s) - 1.0;
+      v = 2.0 * sim_unit(s) - 1.0;
+      r = u * u + v * v;
+    } while (r >= 1.0);
+    double f = sqrt(-2.0 * log(r) / r);
+    out[i] = u * f;
+    if (i + 1 < n)
+      out[i + 1] = v * f;
+  }
+}
+
+/* Fading coefficients of one codeword, E|h|^2 = 1. Jakes: Zheng–Xiao sum
+ * of FADE_OSC sinusoids with angles drawn per codeword (correlated within
+ * a codeword, independent between codewords). Each sinusoid is the real
+ * part of a phasor advanced by one rotation per block, so the block loop
+ * is multiply-adds only. */
+static void fade_gains(const fade_cfg *c, uint64_t *s, double *hre,
+                       double *him) {
+  if (c->fdT > 0.0) {
+    /* in-phase (a) and quadrature (b) phasors, per-block rotations (e, f) */
+    double ar[FADE_OSC], ai[FADE_OSC], er[FADE_OSC], ei[FADE_OSC];
+    double br[FADE_OSC], bi[FADE_OSC], fr[FADE_OSC], fi[FADE_OSC];
+    double th = 2.0 * PI * sim_unit(s) - PI;
+    for (int n = 0; n < FADE_OSC; n++) {
+      double a = (2.0 * PI * (n + 1) - PI + th) / (4.0 * FADE_OSC);
+      double wc = 2.0 * PI * c->fdT * cos(a);
+      double ws = 2.0 * PI * c->fdT * sin(a);
+      double pc = 2.0 * PI * sim_unit(s);
+      double ps = 2.0 * PI * sim_unit(s);
+      ar[n] = cos(pc);
+      ai[n] = sin(pc);
+      er[n] = cos(wc);
+      ei[n] = sin(wc);
+      br[n] = cos(ps);
+      bi[n] = sin(ps);
+      fr[n] = cos(ws);
+      fi[n] = sin(ws);
+    }
+    double g = sqrt(1.0 / FADE_OSC);
+    for (int b = 0; b < c->n_blk; b++) {
+      double xr = 0.0, xi = 0.0;
+      for (int n = 0; n < FADE_OSC; n++) {
+        xr += ar[n];
+        xi += br[n];
+        double t = ar[n] * er[n] - ai[n] * ei[n];
+        ai[n] = ar[n] * ei[n] + ai[n] * er[n];
+        ar[n] = t;
+        t = br[n] * fr[n] - bi[n] * fi[n];
+        bi[n] = br[n] * fi[n] + bi[n] * fr[n];
+        br[n] = t;
+      }
+      hre[b] = g * xr;
+      him[b] = g * xi;
+    }
+  } else {
+    fade_randn(s, hre, c->n_blk);
+    fade_randn(s, him, c->n_blk);
+    for (int b = 0; b < c->n_blk; b++) {
+      hre[b] *= sqrt(0.5);
+      him[b] *= sqrt(0.5);
+    }
+  }
+
+  if (c->rice_K > 0.0) {
+    double sc = sqrt(1.0 / (c->rice_K + 1.0));
+    double ph = 2.0 * PI * sim_unit(s);
+    double lr = sqrt(c->rice_K / (c->rice_K + 1.0)) * cos(ph);
+    double li = sqrt(c->rice_K / (c->rice_K + 1.0)) * sin(ph);
+    for (int b = 0; b < c->n_blk; b++) {
+      hre[b] = lr + sc * hre[b];
+      him[b] = li + sc * him[b];
+    }
+  }
+}
+
+/* Gray-coded constellation: the q code bits of a channel symbol (LSB
+ * first; q / 2 per dimension for QAM) → point, Es = 1. Returns the
+ * amplitude of one PAM step. */
+static double fade_constellation(int q, double *cre, double *cim) {
+  int nb = (q == 1) ? 1 : q / 2;
+  int L = 1 << nb;
+  double amp = (q == 1) ? 1.0 : sqrt(3.0 / (2.0 * (L * L - 1)));
+
+  for (int v = 0; v < (1 << q); v++) {
+    int lvl[2];
+    for (int d = 0; d < 2; d++) {
+      int idx = 0;
+      for (int k = nb - 1; k >= 0; k--)
+        idx = (idx << 1) | (((v >> (d * nb + k)) & 1) ^ (idx & 1));
+      lvl[d] = 2 * idx - (L - 1);
+    }
+    cre[v] = amp * lvl[0];
+    cim[v] = (q == 1) ? 0.0 : amp * lvl[1];
+  }
+  return amp;
+}
+
+/* Hard slicer of one 2^nb-PAM dimension (z already divided by the
+ * amplitude): level index clamped to 0..L-1, returned Gray-coded */
+static inline int pam_slice(double z, int L) {
+  double d = 0.5 * (z + L);
+  d = d < 0.0 ? 0.0 : d > L - 1 ? L - 1 : d;
+  int idx = (int)d;
+  return idx ^ (idx >> 1);
+}
+
+static int info_bit_errors(const rs_sym_t *a, const rs_sym_t *b, int K) {
+  int e = 0;
+  for (int i = 0; i < K; i++)
+    e += __builtin_popcount((unsigned)(a[i] ^ b[i]));
+  return e;
+}
+
+/* Channel of one codeword: cw → r, the weakest |h|^2 under each received
+ * symbol in gain[] and the CSI erasures in eras[]; returns their number */
+static int fade_frame(fade_job *j, const fade_buf *fb, uint64_t *s,
+                      const rs_sym_t *cw, rs_sym_t *r, int *eras) {
+  const fade_cfg *c = j->cfg;
+  int m = rs_m, N = rs_N, T = rs_T, q = c->q;
+  int nb = (q == 1) ? 1 : q / 2;
+  int L = 1 << nb, n_ch = c->n_ch;
+  double inv_amp = 1.0 / fb->amp;
+
+  /* Code bits → constellation indices, q bits at a time (zero padded) */
+  uint32_t acc = 0;
+  int have = 0, i = 0;
+  for (int t = 0; t < n_ch; t++) {
+    while (have < q && i < N) {
+      acc |= (uint32_t)cw[i++] << have;
+      have += m;
+    }
+    fb->tx[t] = (uint8_t)(acc & ((1u << q) - 1));
+    acc >>= q;
+    have = have > q ? have - q : 0;
+  }
+
+  fade_gains(c, s, fb->hre, fb->him);
+  fade_randn(s, fb->nre, n_ch);
+  fade_randn(s, fb->nim, n_ch);
+
+  /* y = h·x + n, coherent detection on z = conj(h)·y / |h|^2 */
+  for (int b = 0; b < c->n_blk; b++) {
+    double hr = fb->hre[b], hi = fb->him[b];
+    double g = hr * hr + hi * hi;
+    double dr = hr / (g + 1e-300), di = hi / (g + 1e-300);
+    int t0 = b * c->block;
+    int t1 = t0 + c->block < n_ch ? t0 + c->block : n_ch;
+    fb->gblk[b] = g;
+    for (int t = t0; t < t1; t++) {
+      double xr = fb->cre[fb->tx[t]], xi = fb->cim[fb->tx[t]];
+      double yr = hr * xr - hi * xi + j->sigma * fb->nre[t];
+      double yi = hr * xi + hi * xr + j->sigma * fb->nim[t];
+      double zr = (dr * yr + di * yi) * inv_amp;
+      double zi = (dr * yi - di * yr) * inv_amp;
+      int v = pam_slice(zr, L);
+      if (q > 1)
+        v |= pam_slice(zi, L) << nb;
+      fb->rx[t] = (uint8_t)v;
+    }
+  }
+
+  /* Received symbols and the weakest |h|^2 under each of them */
+  int span = q * c->block; /* code bits per fading block */
+  acc = 0;
+  have = 0;
+  int t = 0;
+  for (i = 0; i < N; i++) {
+    while (have < m) {
+      acc |= (uint32_t)fb->rx[t++] << have;
+      have += q;
+    }
+    r[i] = (rs_sym_t)(acc & rs_Np);
+    acc >>= m;
+    have -= m;
+    j->raw_err += __builtin_popcount((unsigned)(r[i] ^ cw[i]));
+
+    double gmin = 1e300;
+    for (int b = i * m / span; b <= (i * m + m - 1) / span; b++)
+      gmin = fb->gblk[b] < gmin ? fb->gblk[b] : gmin;
+    fb->gain[i] = gmin;
+  }
+
+  /* CSI erasures: symbols below the threshold, the T weakest at most */
+  const double *gain = fb->gain;
+  int ne = 0;
+  for (i = 0; i < N; i++) {
+    if (gain[i] >= j->erase_gain)
+      continue;
+    int p = ne < T ? ne++ : T;
+    if (p == T && gain[i] >= gain[eras[T - 1]])
+      continue;
+    while (p > 0 && gain[eras[p - 1]] > gain[i]) {
+      if (p < T)
+        eras[p] = eras[p - 1];
+      p--;
+    }
+    eras[p] = i;
+  }
+  j->n_eras += ne;
+  for (int e = 0; e < ne; e++)
+    j->eras_wrong += (r[eras[e]] != cw[eras[e]]);
+  return ne;
+}
+
+/* One worker: blocks of FRAME_BLOCK codewords, encoded and decoded
+ * errors-only through the batch codec on this thread; the erasure lists
+ * differ per codeword, so errors-and-erasures decoding goes word by word */
+static void *fade_worker(void *arg) {
+  fade_job *j = (fade_job *)arg;
+  const fade_cfg *c = j->cfg;
+  int N = rs_N, K = rs_K, T = rs_T;
+  size_t B = FRAME_BLOCK, NB = B * N;
+
+  rs_workspace *ws = rs_workspace_create();
+  size_t arena_bytes = 3 * arena_size(NB * sizeof(rs_sym_t)) +
+                       arena_size(B * T * sizeof(int)) +
+                       arena_size(B * sizeof(int)) +
+                       4 * arena_size(c->n_ch * sizeof(double)) +
+                       3 * arena_size(c->n_blk * sizeof(double)) +
+                       arena_size(N * sizeof(double)) +
+                       2 * arena_size(c->n_ch);
+  uint8_t *arena = (uint8_t *)aligned_alloc(ARENA_ALIGN, arena_bytes);
+  if (!ws || !arena) {
+    j->failed = 1;
+    goto out;
+  }
+
+  uint8_t *next = arena;
+  rs_sym_t *cw = (rs_sym_t *)arena_take(&next, NB * sizeof(rs_sym_t));
+  rs_sym_t *r = (rs_sym_t *)arena_take(&next, NB * sizeof(rs_sym_t));
+  rs_sym_t *r2 = (rs_sym_t *)arena_take(&next, NB * sizeof(rs_sym_t));
+  int *eras = (int *)arena_take(&next, B * T * sizeof(int));
+  int *ne = (int *)arena_take(&next, B * sizeof(int));
+  fade_buf fb;
+  fb.nre = (double *)arena_take(&next, c->n_ch * sizeof(double));
+  fb.nim = (double *)arena_take(&next, c->n_ch * sizeof(double));
+  fb.hre = (double *)arena_take(&next, c->n_blk * sizeof(double));
+  fb.him = (double *)arena_take(&next, c->n_blk * sizeof(double));
+  fb.gblk = (double *)arena_take(&next, c->n_blk * sizeof(double));
+  fb.gain = (double *)arena_take(&next, N * sizeof(double));
+  fb.tx = arena_take(&next, c->n_ch);
+  fb.rx = arena_take(&next, c->n_ch);
+  fb.amp = fade_constellation(c->q, fb.cre, fb.cim);
+
+  uint64_t s = j->seed;
+  for (int f0 = 0; f0 < j->frames; f0 += FRAME_BLOCK) {
+    size_t nb = (size_t)(j->frames - f0 < FRAME_BLOCK ? j->frames - f0
+                                                      : FRAME_BLOCK);
+
+    for (size_t f = 0; f < nb; f++)
+      for (int i = 0; i < K; i++)
+        cw[f * N + i] = (rs_sym_t)(sim_rng(&s) & rs_Np);
+    if (rs_encode_batch_sym(cw, N, 1, nb, 1) != 0) {
+      j->failed = 1;
+      break;
+    }
+
+    for (size_t f = 0; f < nb; f++)
+      ne[f] = fade_frame(j, &fb, &s, &cw[f * N], &r[f * N], &eras[f * T]);
+    memcpy(r2, r, nb * N * sizeof(rs_sym_t));
+
+    if (rs_decode_batch_sym(r, N, 1, NULL, 0, NULL, nb, 1) != 0) {
+      j->failed = 1;
+      break;
+    }
+    for (size_t f = 0; f < nb; f++)
+      rs_decode_sym_erasures_ws(ws, &r2[f * N], &eras[f * T], ne[f]);
+
+    for (size_t f = 0; f < nb; f++) {
+      int e1 = info_bit_errors(&r[f * N], &cw[f * N], K);
+      j->err += e1;
+      j->cw_err += (e1 > 0);
+      int e2 = info_bit_errors(&r2[f * N], &cw[f * N], K);
+      j->err_ee += e2;
+      j->cw_err_ee += (e2 > 0);
+    }
+  }
+
+out:
+  rs_workspace_destroy(ws);
+  free(arena);
+  return NULL;
+}
+
+static int run_fading(int q, int block, double rice_K, double fdT,
+                      double erase_dB, int frames, int threads) {
+  int m = RS_M, N = RS_N, K = RS_K, T = N - K;
+
+  if (rs_gf_init(m, N, K, T) != 0) {
+    fprintf(stderr, "rs_gf_init failed.\n");
+    return 1;
+  }
+  if (threads <= 0)
+    threads = rs_batch_default_threads();
+  if (threads > RS_BATCH_MAX_THREADS)
+    threads = RS_BATCH_MAX_THREADS;
+  if (threads > frames)
+    threads = frames;
+
+  fade_cfg cfg;
+  cfg.q = q;
+  cfg.block = block;
+  cfg.rice_K = rice_K;
+  cfg.fdT = fdT;
+  cfg.erase_snr = pow(10.0, erase_dB / 10.0);
+  cfg.n_ch = (N * m + q - 1) / q;
+  cfg.n_blk = (cfg.n_ch + block - 1) / block;
+  double R = (double)K / N;
+
+  printf("Block-fading channel:\n");
+  printf("  Code    : RS(%d, %d) over GF(2^%d)\n", N, K, m);
+  printf("  Mod     : %s, coherent detection\n",
+         q == 1 ? "BPSK" : q == 2 ? "QPSK" : q == 4 ? "16-QAM" : "64-QAM");
+  printf("  Fading  : %s, K-factor %g, %d channel symbols per block, %s\n",
+         rice_K > 0 ? "Rician" : "Rayleigh", rice_K, block,
+         fdT > 0 ? "Jakes" : "i.i.d. blocks");
+  if (fdT > 0)
+    printf("  Doppler : fd·Tblock = %g\n", fdT);
+  printf("  Erasure : |h|^2·Es/N0 < %g dB (at most %d per codeword)\n",
+         erase_dB, T);
+  printf("  Frames  : %d per SNR point on %d threads\n\n", frames, threads);
+
+  make_results_dir();
+  char fname[256];
+  sprintf(fname, "results/rs_fade_m%d_N%d_K%d_Q%d_B%d_R%g_D%g_data.csv", m,
+          N, K, q, block, rice_K, fdT);
+  FILE *fp = fopen(fname, "w");
+  if (!fp) {
+    fprintf(stderr, "Cannot open results CSV file\n");
+    return 1;
+  }
+  fprintf(fp, "EbN0_dB,BER_raw,BER_RS,BLER_RS,BER_RS_eras,BLER_RS_eras,"
+              "eras_per_cw,eras_wrong\n");
+  printf("EbN0_dB, BER_raw, BER_RS, BLER_RS, BER_RS_eras, BLER_RS_eras, "
+         "eras/cw, eras_wrong\n");
+
+  fade_job job[RS_BATCH_MAX_THREADS];
+  pthread_t tid[RS_BATCH_MAX_THREADS];
+  int started[RS_BATCH_MAX_THREADS];
+  uint64_t seed = (uint64_t)time(NULL) * 0x9E3779B97F4A7C15ull | 1;
+  double sec = 0.0;
+  long long words = 0;
+
+  for (double EbN0_dB = FD_EbN0_MIN_dB; EbN0_dB <= FD_EbN0_MAX_dB + 1e-9;
+       EbN0_dB += FD_EbN0_STEP_dB) {
+    double EbN0 = pow(10.0, EbN0_dB / 10.0);
+    double sigma = sqrt(1.0 / (2.0 * R * q * EbN0));
+
+    double t0 = now_sec();
+    for (int w = 0; w < threads; w++) {
+      memset(&job[w], 0, sizeof(job[w]));
+      job[w].cfg = &cfg;
+      job[w].sigma = sigma;
+      job[w].erase_gain = cfg.erase_snr / (R * q * EbN0);
+      job[w].frames = frames / threads + (w < frames % threads);
+      job[w].seed = sim_rng(&seed) | 1;
+    }
+    for (int w = 1; w < threads; w++) {
+      started[w] = (pthread_create(&tid[w], NULL, fade_worker, &job[w]) == 0);
+      if (!started[w])
+        fade_worker(&job[w]);
+    }
+    fade_worker(&job[0]);
+    for (int w = 1; w < threads; w++)
+      if (started[w])
+        pthread_join(tid[w], NULL);
+
+    fade_job sum;
+    memset(&sum, 0, sizeof(sum));
+    for (int w = 0; w < threads; w++) {
+      sum.failed |= job[w].failed;
+      sum.raw_err += job[w].raw_err;
+      sum.err += job[w].err;
+      sum.cw_err += job[w].cw_err;
+      sum.err_ee += job[w].err_ee;
+      sum.cw_err_ee += job[w].cw_err_ee;
+      sum.n_eras += job[w].n_eras;
+      sum.eras_wrong += job[w].eras_wrong;
+    }
+    sec += now_sec() - t0;
+    words += frames;
+    if (sum.failed) {
+      fprintf(stderr, "Memory allocation failed.\n");
+      return 1;
+    }
+
+    double info_bits = (double)frames * K * m;
+    double BER_RAW = (double)sum.raw_err / ((double)frames * N * m);
+    double BER_RS = sum.err / info_bits;
+    double BLER_RS = (double)sum.cw_err / frames;
+    double BER_EE = sum.err_ee / info_bits;
+    double BLER_EE = (double)sum.cw_err_ee / frames;
+    double ERAS = (double)sum.n_eras / frames;
+    double WRONG = sum.n_eras ? (double)sum.eras_wrong / sum.n_eras : 0.0;
+
+    printf("%5.1f, %.6e, %.6e, %.6e, %.6e, %.6e, %.2f, %.3f\n", EbN0_dB,
+           BER_RAW, BER_RS, BLER_RS, BER_EE, BLER_EE, ERAS, WRONG);
+    fflush(stdout);
+    fprintf(fp, "%5.1f,%.10e,%.10e,%.10e,%.10e,%.10e,%.4f,%.4f\n", EbN0_dB,
+            BER_RAW, BER_RS, BLER_RS, BER_EE, BLER_EE, ERAS, WRONG);
+  }
+
+  fclose(fp);
+  printf("\nThroughput: %.0f codewords/s (channel + both decoders)\n",
+         sec > 0 ? words / sec : 0.0);
+  printf("Results saved to:\n  %s\n", fname);
+  return 0;
+}
+
 /* ======================================================================== */
 /* MAIN                                                                      */
 /* ======================================================================== */
-int main(void) {
+int main(int argc, char **argv) {
+  if (argc > 1 && strcmp(argv[1], "-c") == 0) {
+    int depth = (argc > 2) ? atoi(argv[2]) : CC_DEPTH;
+    int frames = (argc > 3) ? atoi(argv[3]) : CC_FRAMES;
+    if (depth < 1 || frames < 1) {
+      fprintf(stderr, "Usage: rs_ber_bler -c [depth] [frames]\n");
+      return 1;
+    }
+    return run_concatenated(depth, frames);
+  }
+  if (argc > 1 && strcmp(argv[1], "-f") == 0) {
+    int q = (argc > 2) ? atoi(argv[2]) : FD_BITS;
+    int block = (argc > 3) ? atoi(argv[3]) : FD_BLOCK;
+    double rice_K = (argc > 4) ? atof(argv[4]) : 0.0;
+    double fdT = (argc > 5) ? atof(argv[5]) : 0.0;
+    double erase_dB = (argc > 6) ? atof(argv[6]) : FD_ERASE_dB;
+    int frames = (argc > 7) ? atoi(argv[7]) : FD_FRAMES;
+    int threads = (argc > 8) ? atoi(argv[8]) : 0;
+    if ((q != 1 && q != 2 && q != 4 && q != 6) || block < 1 || rice_K < 0 ||
+        fdT < 0 || frames < 1) {
+      fprintf(stderr, "Usage: rs_ber_bler -f [bits/symbol 1|2|4|6] [block] "
+                      "[K-factor] [fd·T] [erase dB] [frames] [threads]\n");
+      return 1;
+    }
+    return run_fading(q, block, rice_K, fdT, erase_dB, frames, threads);
+  }
 
   printf("=====================================================\n");
   printf("  Reed–Solomon BER/BLER Simulation over AWGN (BPSK)  \n");
@@ -84,6 +876,7 @@ int main(void) {
   int N = RS_N;
   int K = RS_K;
   int T = N - K;
+  int threads = rs_batch_default_threads();
 
   int code_bits_len = N * m;
   int info_bits_len = K * m;
@@ -91,7 +884,8 @@ int main(void) {
   printf("RS parameters:\n");
   printf("  GF(2^m) : m = %d\n", m);
   printf("  Code    : RS(%d, %d), T = %d parity symbols\n", N, K, T);
-  printf("  Trials  : %d frames per SNR point\n\n", N_TRIALS);
+  printf("  Trials  : %d frames per SNR point, blocks of %d on %d threads\n\n",
+         N_TRIALS, FRAME_BLOCK, threads);
 
   /* Initialize GF(2^m) and generator polynomial */
   if (rs_gf_init(m, N, K, T) != 0) {
@@ -102,11 +896,7 @@ int main(void) {
   /* ---------------------------------------------------------------------
    * Prepare result directory
    * ------------------------------------------------------------------- */
-#ifdef _WIN32
-  _mkdir("results");
-#else
-  mkdir("results", 0777);
-#endif
+  make_results_dir();
 
   /* ---------------------------------------------------------------------
    * Construct output file names with parameters m,N,K
@@ -123,28 +913,42 @@ int main(void) {
     return 1;
   }
 
-  fprintf(fp, "EbN0_dB,BER_RS,BER_bpsk\n");
-  fprintf(fp_bler, "EbN0_dB,BLER_RS,BLER_bpsk\n");
+  fprintf(fp, "EbN0_dB,BER_RS,BER_bpsk,BER_est\n");
+  fprintf(fp_bler, "EbN0_dB,BLER_RS,BLER_bpsk,enc_cw_per_s,dec_cw_per_s,"
+                   "enc_ns_per_cw,dec_ns_per_cw\n");
 
   /* ---------------------------------------------------------------------
-   * Allocate buffers
+   * Buffers: one block of packed frames, carved from a single arena
    * ------------------------------------------------------------------- */
-  int *u_bits = (int *)malloc(info_bits_len * sizeof(int));
-  int *c_bits = (int *)malloc(code_bits_len * sizeof(int));
-  int *r_bits = (int *)malloc(code_bits_len * sizeof(int));
-  int *c_hat = (int *)malloc(code_bits_len * sizeof(int));
-  int *u_hat = (int *)malloc(info_bits_len * sizeof(int));
-  double *tx = (double *)malloc(code_bits_len * sizeof(double));
-  double *rx = (double *)malloc(code_bits_len * sizeof(double));
-
-  if (!u_bits || !c_bits || !r_bits || !c_hat || !u_hat || !tx || !rx) {
+  size_t ib = rs_packed_bytes(K);
+  size_t cb = rs_packed_bytes(N);
+  size_t B = FRAME_BLOCK;
+  size_t arena_bytes = arena_size(B * ib) + 3 * arena_size(B * cb) +
+                       2 * arena_size(B * sizeof(int)) +
+                       arena_size(K * sizeof(rs_sym_t));
+  uint8_t *arena = (uint8_t *)aligned_alloc(ARENA_ALIGN, arena_bytes);
+  uint8_t *next = arena;
+
+  uint8_t *info = arena_take(&next, B * ib);  /* transmitted information */
+  uint8_t *code = arena_take(&next, B * cb);  /* encoded frames */
+  uint8_t *recv = arena_take(&next, B * cb);  /* after the channel */
+  uint8_t *dec = arena_take(&next, B * cb);   /* decoded frames */
+  int *status = (int *)arena_take(&next, B * sizeof(int));
+  int *bits = (int *)arena_take(&next, B * sizeof(int));
+  rs_sym_t *sym = (rs_sym_t *)arena_take(&next, K * sizeof(rs_sym_t));
+
+  /* Pre-FEC BER estimator fed by the decoder's corrected-bit counts */
+  rs_chan_stats *chan = rs_chan_stats_create(1000, 0.01);
+
+  if (!arena || !chan) {
     fprintf(stderr, "Memory allocation failed.\n");
     return 1;
   }
 
-  srand((unsigned int)time(NULL));
+  uint64_t seed = (uint64_t)time(NULL) * 0x9E3779B97F4A7C15ull | 1;
 
-  printf("EbN0_dB, BER_RS, BER_bpsk, BLER_RS, BLER_bpsk\n");
+  printf("EbN0_dB, BER_RS, BER_bpsk, BER_est, BLER_RS, BLER_bpsk, "
+         "enc ns/cw, dec ns/cw\n");
 
   /* ====================================================================
    * SNR Loop
@@ -154,48 +958,62 @@ int main(void) {
 
     double EbN0 = pow(10.0, EbN0_dB / 10.0);
     double R = (double)K / (double)N;
-    double sigma2 = 1.0 / (2.0 * R * EbN0);
-    double sigma = sqrt(sigma2);
+
+    /* BPSK + AWGN + hard decision = binary symmetric channel: a code bit
+     * flips with p = Q(sqrt(2 R Eb/N0)); flips are placed by geometric
+     * skips over the block's bit stream */
+    double p = bpsk_ber(R * EbN0);
+    double log_q = log1p(-p);
 
     long long total_info_bits = (long long)N_TRIALS * info_bits_len;
     long long err_info = 0;
     long long sum_frame_errors = 0;
+    double enc_sec = 0.0, dec_sec = 0.0;
+    rs_chan_stats_reset(chan);
 
     /* ===============================================================
-     * Monte Carlo trials per SNR
+     * Monte Carlo trials per SNR, one block of frames at a time
      * ============================================================= */
-    for (int t = 0; t < N_TRIALS; t++) {
+    for (int t0 = 0; t0 < N_TRIALS; t0 += FRAME_BLOCK) {
+      size_t nb = (size_t)(N_TRIALS - t0 < FRAME_BLOCK ? N_TRIALS - t0
+                                                      : FRAME_BLOCK);
 
-      /* Generate random info bits */
-      for (int i = 0; i < info_bits_len; i++)
-        u_bits[i] = rand() & 1;
+      /* Random information symbols, packed */
+      for (size_t f = 0; f < nb; f++) {
+        for (int i = 0; i < K; i++)
+          sym[i] = (rs_sym_t)(sim_rng(&seed) & rs_Np);
+        rs_pack_symbols(sym, &info[f * ib], K);
+      }
 
       /* Encode */
-      rs_encode(u_bits, c_bits);
-
-      /* BPSK: 1 → +1, 0 → -1 */
-      for (int i = 0; i < code_bits_len; i++)
-        tx[i] = (c_bits[i] == 1) ? +1.0 : -1.0;
+      double c0 = now_sec();
+      rs_encode_batch(info, ib, code, cb, nb, threads);
+      enc_sec += now_sec() - c0;
 
-      /* Add AWGN */
-      for (int i = 0; i < code_bits_len; i++)
-        rx[i] = tx[i] + sigma * randn();
-
-      /* Hard decision */
-      for (int i = 0; i < code_bits_len; i++)
-        r_bits[i] = (rx[i] >= 0) ? 1 : 0;
+      /* Channel: bit b of frame f is bit b % 8 of byte b / 8 */
+      memcpy(recv, code, nb * cb);
+      if (p > 0.0) {
+        long long n_bits = (long long)nb * code_bits_len;
+        for (long long g = geometric(&seed, log_q); g < n_bits;
+             g += 1 + geometric(&seed, log_q)) {
+          long long f = g / code_bits_len, b = g % code_bits_len;
+          recv[f * cb + b / 8] ^= (uint8_t)(1u << (b % 8));
+        }
+      }
 
       /* Decode */
-      rs_decode(r_bits, c_hat, u_hat);
-
-      /* Count bit errors */
-      int info_err_bits = 0;
-      for (int i = 0; i < info_bits_len; i++)
-        if (u_bits[i] != u_hat[i])
-          info_err_bits++;
+      c0 = now_sec();
+      rs_decode_batch_bits(recv, cb, dec, cb, status, bits, nb, threads);
+      dec_sec += now_sec() - c0;
+      rs_chan_stats_add_batch(chan, status, bits, nb);
 
-      err_info += info_err_bits;
-      sum_frame_errors += (info_err_bits > 0);
+      /* Count information bit errors */
+      for (size_t f = 0; f < nb; f++) {
+        int info_err_bits =
+            packed_bit_errors(&info[f * ib], &dec[f * cb], info_bits_len);
+        err_info += info_err_bits;
+        sum_frame_errors += (info_err_bits > 0);
+      }
     }
 
     /* BER & BLER results */
@@ -203,24 +1021,26 @@ int main(void) {
     double BER_BPSK = bpsk_ber(EbN0);
     double BLER_RS = (double)sum_frame_errors / (double)N_TRIALS;
     double BLER_BPSK = 1.0 - pow(1.0 - BER_BPSK, code_bits_len);
+    double ENC_NS = enc_sec * 1e9 / N_TRIALS;
+    double DEC_NS = dec_sec * 1e9 / N_TRIALS;
+    rs_chan_estimate est;
+    rs_chan_stats_read(chan, &est);
 
-    printf("%4.1f, %.10e, %.10e, %.10e, %.10e\n", EbN0_dB, BER_RS, BER_BPSK,
-           BLER_RS, BLER_BPSK);
+    printf("%4.1f, %.10e, %.10e, %.10e, %.10e, %.10e, %.0f, %.0f\n",
+           EbN0_dB, BER_RS, BER_BPSK, est.ber_total, BLER_RS, BLER_BPSK,
+           ENC_NS, DEC_NS);
 
-    fprintf(fp, "%4.1f,%.10e,%.10e\n", EbN0_dB, BER_RS, BER_BPSK);
-    fprintf(fp_bler, "%4.1f,%.10e,%.10e\n", EbN0_dB, BLER_RS, BLER_BPSK);
+    fprintf(fp, "%4.1f,%.10e,%.10e,%.10e\n", EbN0_dB, BER_RS, BER_BPSK,
+            est.ber_total);
+    fprintf(fp_bler, "%4.1f,%.10e,%.10e,%.1f,%.1f,%.1f,%.1f\n", EbN0_dB,
+            BLER_RS, BLER_BPSK, 1e9 / ENC_NS, 1e9 / DEC_NS, ENC_NS, DEC_NS);
   }
 
   fclose(fp);
   fclose(fp_bler);
 
-  free(u_bits);
-  free(c_bits);
-  free(r_bits);
-  free(c_hat);
-  free(u_hat);
-  free(tx);
-  free(rx);
+  free(arena);
+  rs_chan_stats_destroy(chan);
 
   printf("\nResults saved to:\n  %s\n  %s\n", fname_ber, fname_bler);
 
@@ -0,0 +1,234 @@
+/**
+ * @file rs_loadgen.c
+ * @brief Load generator for rs_server: throughput/latency vs. batch window.
+ *
+ * C client threads each keep one decode request outstanding (closed loop)
+ * against a running rs_server. For every coalescing window given on the
+ * command line the server is reconfigured (RS_SVC_SET_WINDOW) and the
+ * clients send R requests each; the program reports
+ *
+ *   window_us, throughput (codewords/s), mean / p50 / p99 latency (us)
+ *
+ * and checks every reply against the transmitted codeword.
+ *
+ * Usage:
+ *   rs_server &                                   (start the service)
+ *   rs_loadgen [socket] [clients] [requests] [window_us ...]
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+int main(void) {
+  fprintf(stderr, "rs_loadgen requires Unix domain sockets.\n");
+  return 1;
+}
+#else
+
+#include <pthread.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "rs_encoder.h"
+#include "rs_gf.h"
+#include "rs_pack.h"
+#include "rs_service.h"
+
+#define N_CODEWORDS 64 /* distinct test codewords per client */
+#define N_ERRORS 8     /* symbol errors per request */
+
+static const char *sock_path;
+static int n_requests;
+static size_t code_bytes;
+
+/* Shared test vectors: clean codewords and their corrupted versions */
+static uint8_t *tx_code, *rx_code;
+
+static double now_us(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Client connection                                                          */
+/* ------------------------------------------------------------------------- */
+static int connect_server(void) {
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", sock_path);
+  if (fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+    perror("rs_loadgen: connect");
+    exit(1);
+  }
+  return fd;
+}
+
+static int io_all(int fd, void *buf, size_t len, int do_write) {
+  uint8_t *p = (uint8_t *)buf;
+  while (len > 0) {
+    ssize_t n = do_write ? send(fd, p, len, MSG_NOSIGNAL) : read(fd, p, len);
+    if (n <= 0)
+      return -1;
+    p += n;
+    len -= (size_t)n;
+  }
+  return 0;
+}
+
+/* One request/response round trip; returns the response status */
+static int call(int fd, uint32_t op, uint32_t id, const void *payload,
+                uint32_t len, void *reply, uint32_t reply_cap) {
+  rs_svc_req req = {RS_SVC_MAGIC, op, id, len};
+  rs_svc_resp resp;
+
+  if (io_all(fd, &req, sizeof(req), 1) != 0 ||
+      (len && io_all(fd, (void *)payload, len, 1) != 0) ||
+      io_all(fd, &resp, sizeof(resp), 0) != 0 || resp.magic != RS_SVC_MAGIC ||
+      resp.id != id || resp.len > reply_cap ||
+      (resp.len && io_all(fd, reply, resp.len, 0) != 0)) {
+    fprintf(stderr, "rs_loadgen: protocol error\n");
+    exit(1);
+  }
+  return resp.status;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Client thread: closed loop of decode requests                              */
+/* ------------------------------------------------------------------------- */
+typedef struct {
+  int id;
+  double *lat_us; /* [n_requests] */
+  long errors;
+} client_arg;
+
+static pthread_barrier_t start_barrier;
+
+static void *client_main(void *arg) {
+  client_arg *c = (client_arg *)arg;
+  int fd = connect_server();
+  uint8_t *reply = (uint8_t *)malloc(code_bytes);
+
+  pthread_barrier_wait(&start_barrier);
+
+  for (int r = 0; r < n_requests; r++) {
+    int k = (c->id + r) % N_CODEWORDS;
+    double t0 = now_us();
+    int st = call(fd, RS_SVC_DECODE, (uint32_t)r, &rx_code[k * code_bytes],
+                  (uint32_t)code_bytes, reply, (uint32_t)code_bytes);
+    c->lat_us[r] = now_us() - t0;
+    if (st < 0 || memcmp(reply, &tx_code[k * code_bytes], code_bytes) != 0)
+      c->errors++;
+  }
+
+  free(reply);
+  close(fd);
+  return NULL;
+}
+
+static int cmp_double(const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+/* ======================================================================== */
+/* MAIN                                                                      */
+/* ======================================================================== */
+int main(int argc, char **argv) {
+  sock_path = (argc > 1) ? argv[1] : RS_SVC_DEFAULT_PATH;
+  int n_clients = (argc > 2) ? atoi(argv[2]) : 16;
+  n_requests = (argc > 3) ? atoi(argv[3]) : 2000;
+
+  static const long default_windows[] = {0, 50, 100, 200, 500, 1000};
+  int n_windows = (argc > 4) ? argc - 4 : 6;
+
+  /* Learn the served code and build the same tables locally */
+  int ctl = connect_server();
+  int32_t info[3];
+  call(ctl, RS_SVC_INFO, 0, NULL, 0, info, sizeof(info));
+  int m = info[0], N = info[1], K = info[2];
+  if (rs_gf_init(m, N, K, N - K) != 0)
+    return 1;
+  code_bytes = rs_packed_bytes(N);
+
+  printf("rs_loadgen: RS(%d,%d) GF(2^%d), %d clients x %d requests, "
+         "%d symbol errors\n",
+         N, K, m, n_clients, n_requests, N_ERRORS);
+
+  /* Test vectors */
+  rs_sym_t *sym = (rs_sym_t *)malloc(N * sizeof(rs_sym_t));
+  tx_code = (uint8_t *)malloc(N_CODEWORDS * code_bytes);
+  rx_code = (uint8_t *)malloc(N_CODEWORDS * code_bytes);
+  srand(1);
+  for (int k = 0; k < N_CODEWORDS; k++) {
+    for (int i = 0; i < K; i++)
+      sym[i] = (rs_sym_t)(rand() & rs_Np);
+    rs_encode_sym(sym, sym);
+    rs_pack_symbols(sym, &tx_code[k * code_bytes], N);
+    for (int e = 0; e < N_ERRORS; e++)
+      sym[rand() % N] ^= (rs_sym_t)(1 + rand() % rs_Np);
+    rs_pack_symbols(sym, &rx_code[k * code_bytes], N);
+  }
+  free(sym);
+
+  pthread_t tid[n_clients];
+  client_arg args[n_clients];
+  double *all_lat = (double *)malloc((size_t)n_clients * n_requests *
+                                     sizeof(double));
+  for (int c = 0; c < n_clients; c++)
+    args[c].lat_us = &all_lat[(size_t)c * n_requests];
+
+  printf("\n window_us   throughput_cw/s   mean_us    p50_us    p99_us"
+         "  errors\n");
+
+  for (int w = 0; w < n_windows; w++) {
+    uint32_t window = (argc > 4) ? (uint32_t)atol(argv[4 + w])
+                                 : (uint32_t)default_windows[w];
+    call(ctl, RS_SVC_SET_WINDOW, 0, &window, sizeof(window), NULL, 0);
+
+    pthread_barrier_init(&start_barrier, NULL, n_clients + 1);
+    for (int c = 0; c < n_clients; c++) {
+      args[c].id = c;
+      args[c].errors = 0;
+      pthread_create(&tid[c], NULL, client_main, &args[c]);
+    }
+
+    pthread_barrier_wait(&start_barrier);
+    double t0 = now_us();
+    long errors = 0;
+    for (int c = 0; c < n_clients; c++) {
+      pthread_join(tid[c], NULL);
+      errors += args[c].errors;
+    }
+    double wall_us = now_us() - t0;
+    pthread_barrier_destroy(&start_barrier);
+
+    size_t total = (size_t)n_clients * n_requests;
+    double sum = 0.0;
+    for (size_t i = 0; i < total; i++)
+      sum += all_lat[i];
+    qsort(all_lat, total, sizeof(double), cmp_double);
+
+    printf("%10u   %15.0f  %8.1f  %8.1f  %8.1f  %6ld\n", window,
+           total / (wall_us * 1e-6), sum / total, all_lat[total / 2],
+           all_lat[(size_t)(total * 0.99)], errors);
+    fflush(stdout);
+  }
+
+  close(ctl);
+  free(all_lat);
+  free(tx_code);
+  free(rx_code);
+
+  return 0;
+}
+
+#endif /* _WIN32 */
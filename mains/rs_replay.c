@@ -0,0 +1,306 @@
+/**
+ * @file rs_replay.c
+ * @brief Replay a captured received-codeword trace through the decoder.
+ *
+ * The trace (rs_trace.h) is mapped read-only and decoded three ways, each
+ * over every record:
+ *
+ *   single   : one rs_decode_packed_ws() call per record, erasures taken
+ *              from the trace (rs_decode_sym_erasures_ws()) when present;
+ *              latency per codeword
+ *   batch    : rs_decode_batch_bits() on one thread, <batch> records per
+ *              call straight from the mapping (stride = record size);
+ *              latency per call
+ *   threaded : the same with <threads> threads and <batch> · <threads>
+ *              records per call
+ *
+ * The batch paths decode errors only; with an erasure-flagged trace their
+ * outcomes may differ from the single path. For each path the program
+ * prints codewords/s, MB/s of received data, latency percentiles and the
+ * decode outcomes (clean, corrected, failed, rejected by verification),
+ * plus the pre-FEC BER estimate from the corrected bits (rs_stats.h). With
+ * timestamps the trace's own codeword rate is shown for comparison.
+ *
+ * Usage:
+ *   rs_replay <trace> [threads] [batch]
+ *   rs_replay -g <trace> [frames] [p]   write a test trace through the
+ *                                       capture hook: RS(255,223), bursty
+ *                                       two-state channel, bad-state
+ *                                       symbols flagged as erasures
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "rs_batch.h"
+#include "rs_decoder.h"
+#include "rs_encoder.h"
+#include "rs_gf.h"
+#include "rs_pack.h"
+#include "rs_stats.h"
+#include "rs_trace.h"
+#include "rs_workspace.h"
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ull;
+
+static uint64_t rng(void) {
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 7;
+  rng_state ^= rng_state << 17;
+  return rng_state;
+}
+
+static double rng_unit(void) { return ((rng() >> 11) + 0.5) * 0x1.0p-53; }
+
+/* ------------------------------------------------------------------------ */
+/* Results                                                                   */
+/* ------------------------------------------------------------------------ */
+typedef struct {
+  double sec;
+  double *lat; /* seconds per codeword (single) or per call (batch) */
+  size_t n_lat;
+  long long clean, corrected, failed, rejected, symbols;
+  double ber_est;
+} replay_result;
+
+static int cmp_double(const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+static double percentile(const double *v, size_t n, double p) {
+  size_t i = (size_t)(p * (n - 1) + 0.5);
+  return v[i < n ? i : n - 1];
+}
+
+static void count_outcomes(replay_result *r, const int *status,
+                           const int *bits, size_t n, rs_chan_stats *chan) {
+  for (size_t i = 0; i < n; i++) {
+    if (status[i] == 0)
+      r->clean++;
+    else if (status[i] > 0) {
+      r->corrected++;
+      r->symbols += status[i];
+    } else if (status[i] == RS_DECODE_MISCORRECTED)
+      r->rejected++;
+    else
+      r->failed++;
+  }
+  rs_chan_stats_add_batch(chan, status, bits, n);
+}
+
+static void print_result(const char *name, const char *lat_unit,
+                         const replay_result *r, size_t n, double bytes) {
+  qsort(r->lat, r->n_lat, sizeof(double), cmp_double);
+  printf("%-9s %11.0f %8.1f  %8.2f %8.2f %8.2f %8.2f  %-9s %9lld %9lld "
+         "%7lld %7lld  %.3e\n",
+         name, n / r->sec, bytes / r->sec / 1e6,
+         percentile(r->lat, r->n_lat, 0.5) * 1e6,
+         percentile(r->lat, r->n_lat, 0.99) * 1e6,
+         percentile(r->lat, r->n_lat, 0.999) * 1e6,
+         r->lat[r->n_lat - 1] * 1e6, lat_unit, r->clean, r->corrected,
+         r->failed, r->rejected, r->ber_est);
+}
+
+/* ------------------------------------------------------------------------ */
+/* Decode paths                                                              */
+/* ------------------------------------------------------------------------ */
+static int replay_single(const rs_trace *t, replay_result *r,
+                         rs_chan_stats *chan) {
+  size_t n = t->n_records;
+  rs_workspace *ws = rs_workspace_create();
+  uint8_t *out = (uint8_t *)malloc(rs_packed_bytes(rs_N));
+  int *eras = (int *)malloc((size_t)rs_N * sizeof(int));
+  r->lat = (double *)malloc(n * sizeof(double));
+  if (!ws || !out || !eras || !r->lat)
+    return -1;
+  r->n_lat = n;
+
+  double t0 = now_sec();
+  for (size_t i = 0; i < n; i++) {
+    const uint8_t *rec = rs_trace_codeword(t, i);
+    double c0 = now_sec();
+    int ne = rs_trace_erasures(t, i, eras);
+    int st;
+    if (ne > 0) {
+      rs_unpack_symbols(rec, ws->sym, rs_N);
+      st = rs_decode_sym_erasures_ws(ws, ws->sym, eras, ne);
+    } else {
+      st = rs_decode_packed_ws(ws, rec, out, NULL);
+    }
+    r->lat[i] = now_sec() - c0;
+    count_outcomes(r, &st, &ws->corr_bits, 1, chan);
+  }
+  r->sec = now_sec() - t0;
+
+  rs_workspace_destroy(ws);
+  free(out);
+  free(eras);
+  return 0;
+}
+
+static int replay_batch(const rs_trace *t, int threads, size_t batch,
+                        replay_result *r, rs_chan_stats *chan) {
+  size_t n = t->n_records;
+  size_t cb = rs_packed_bytes(rs_N);
+  uint8_t *out = (uint8_t *)malloc(batch * cb);
+  int *status = (int *)malloc(batch * sizeof(int));
+  int *bits = (int *)malloc(batch * sizeof(int));
+  r->lat = (double *)malloc(((n + batch - 1) / batch) * sizeof(double));
+  if (!out || !status || !bits || !r->lat)
+    return -1;
+
+  double t0 = now_sec();
+  for (size_t i = 0; i < n; i += batch) {
+    size_t nb = (n - i < batch) ? n - i : batch;
+    double c0 = now_sec();
+    if (rs_decode_batch_bits(rs_trace_codeword(t, i), t->record_bytes, out,
+                             cb, status, bits, nb, threads) != 0)
+      return -1;
+    r->lat[r->n_lat++] = now_sec() - c0;
+    count_outcomes(r, status, bits, nb, chan);
+  }
+  r->sec = now_sec() - t0;
+
+  free(out);
+  free(status);
+  free(bits);
+  return 0;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Test trace through the capture hook                                       */
+/* ------------------------------------------------------------------------ */
+static int generate(const char *path, long frames, double p) {
+  int N = 255, K = 223;
+  if (rs_gf_init(8, N, K, N - K) != 0)
+    return 1;
+  rs_trace_writer *w =
+      rs_trace_create(path, RS_TRACE_TIMESTAMPS | RS_TRACE_ERASURES);
+  rs_workspace *ws = rs_workspace_create();
+  if (!w || !ws)
+    return 1;
+
+  /* Two-state channel: symbol error rate p in the good state, 0.5 in the
+   * bad one; bad runs last 8 symbols on average */
+  const double p_gb = p / 10, p_bg = 1.0 / 8;
+  int bad = 0;
+  rs_sym_t cw[255];
+  int eras[255];
+
+  rs_trace_capture(w);
+  for (long f = 0; f < frames; f++) {
+    for (int i = 0; i < K; i++)
+      cw[i] = (rs_sym_t)(rng() & 0xFF);
+    rs_encode_sym(cw, cw);
+
+    int ne = 0;
+    for (int i = 0; i < N; i++) {
+      bad = bad ? (rng_unit() >= p_bg) : (rng_unit() < p_gb);
+      if (rng_unit() < (bad ? 0.5 : p))
+        cw[i] ^= (rs_sym_t)(1 + rng() % 255);
+      if (bad && ne < N - K)
+        eras[ne++] = i;
+    }
+    rs_decode_sym_erasures_ws(ws, cw, eras, ne); /* captured */
+  }
+  rs_trace_capture(NULL);
+
+  rs_workspace_destroy(ws);
+  if (rs_trace_close(w) != 0)
+    return 1;
+  printf("Wrote %ld records to %s\n", frames, path);
+  return 0;
+}
+
+/* ======================================================================== */
+/* MAIN                                                                      */
+/* ======================================================================== */
+int main(int argc, char **argv) {
+  if (argc > 2 && strcmp(argv[1], "-g") == 0) {
+    long frames = (argc > 3) ? atol(argv[3]) : 100000;
+    double p = (argc > 4) ? atof(argv[4]) : 0.02;
+    return generate(argv[2], frames, p);
+  }
+  if (argc < 2) {
+    fprintf(stderr, "Usage: rs_replay <trace> [threads] [batch]\n"
+                    "       rs_replay -g <trace> [frames] [p]\n");
+    return 1;
+  }
+  int threads = (argc > 2) ? atoi(argv[2]) : 0;
+  size_t batch = (argc > 3) ? (size_t)atol(argv[3]) : 256;
+  if (threads <= 0)
+    threads = rs_batch_default_threads();
+  if (batch < 1)
+    batch = 1;
+
+  rs_trace t;
+  if (rs_trace_map(argv[1], &t) != 0)
+    return 1;
+  if (rs_trace_select(&t) != 0 || t.n_records == 0) {
+    fprintf(stderr, "ERROR: %s: unusable trace\n", argv[1]);
+    return 1;
+  }
+
+  double bytes = (double)t.n_records * rs_packed_bytes(rs_N);
+  printf("Trace %s: %zu codewords of RS(%d,%d) over GF(2^%d)%s%s\n",
+         argv[1], t.n_records, t.N, t.K, t.m,
+         (t.flags & RS_TRACE_ERASURES) ? ", erasure flags" : "",
+         (t.flags & RS_TRACE_TIMESTAMPS) ? ", timestamps" : "");
+  if ((t.flags & RS_TRACE_TIMESTAMPS) && t.n_records > 1) {
+    double span = (rs_trace_time(&t, t.n_records - 1) -
+                   rs_trace_time(&t, 0)) * 1e-9;
+    if (span > 0)
+      printf("Captured at %.0f codewords/s over %.3f s\n",
+             (t.n_records - 1) / span, span);
+  }
+  printf("\n%-9s %11s %8s  %8s %8s %8s %8s  %-9s %9s %9s %7s %7s  %s\n",
+         "path", "cw/s", "MB/s", "p50", "p99", "p99.9", "max", "latency",
+         "clean", "corrected", "failed", "reject", "BER est");
+
+  rs_chan_stats *chan = rs_chan_stats_create(1000, 0.01);
+  if (!chan)
+    return 1;
+
+  const char *names[3] = {"single", "batch", "threaded"};
+  char unit[3][32];
+  snprintf(unit[0], sizeof(unit[0]), "us/cw");
+  snprintf(unit[1], sizeof(unit[1]), "us/%zu", batch);
+  snprintf(unit[2], sizeof(unit[2]), "us/%zu", batch * threads);
+
+  for (int path = 0; path < 3; path++) {
+    replay_result r;
+    memset(&r, 0, sizeof(r));
+    rs_chan_stats_reset(chan);
+
+    int ret = (path == 0) ? replay_single(&t, &r, chan)
+              : (path == 1)
+                  ? replay_batch(&t, 1, batch, &r, chan)
+                  : replay_batch(&t, threads, batch * threads, &r, chan);
+    if (ret != 0) {
+      fprintf(stderr, "ERROR: %s replay failed\n", names[path]);
+      return 1;
+    }
+
+    rs_chan_estimate est;
+    rs_chan_stats_read(chan, &est);
+    r.ber_est = est.ber_total;
+    print_result(names[path], unit[path], &r, t.n_records, bytes);
+    free(r.lat);
+  }
+
+  rs_chan_stats_destroy(chan);
+  rs_trace_unmap(&t);
+  return 0;
+}
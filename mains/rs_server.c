@@ -0,0 +1,476 @@
+/**
+ * @file rs_server.c
+ * @brief Local RS encode/decode service with request coalescing.
+ *
+ * The daemon initializes the RS tables once and serves encode/decode
+ * requests from any number of local processes over a Unix domain socket
+ * (protocol in rs_service.h).
+ *
+ * Event loop (single thread):
+ *   - ppoll() on the listening socket and all clients
+ *   - complete requests are appended to the pending batch
+ *   - the batch is flushed through rs_encode_batch()/rs_decode_batch()
+ *     when the oldest pending request has waited `window` microseconds,
+ *     or when `max_batch` requests are pending
+ *   - responses are written back in arrival order; what a client's socket
+ *     does not take at once is queued for it and sent on POLLOUT, and a
+ *     client that leaves more than TX_BACKLOG responses unread is dropped
+ *
+ * The batch kernels themselves run on `threads` worker threads.
+ *
+ * The server refuses to start if another one answers on the socket path;
+ * a stale socket left by a dead server is replaced.
+ *
+ * Usage:
+ *   rs_server [socket] [m] [N] [K] [window_us] [max_batch] [threads]
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+int main(void) {
+  fprintf(stderr, "rs_server requires Unix domain sockets.\n");
+  return 1;
+}
+#else
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "rs_batch.h"
+#include "rs_gf.h"
+#include "rs_pack.h"
+#include "rs_service.h"
+
+#define MAX_CLIENTS 256
+#define TX_BACKLOG 64 /* unread responses per client before it is dropped */
+
+/* ------------------------------------------------------------------------- */
+/* Server state                                                               */
+/* ------------------------------------------------------------------------- */
+typedef struct {
+  int fd;
+  unsigned gen; /* bumped per connection, so a reused slot is detected */
+  uint8_t *rx;  /* partially received request */
+  size_t rx_len;
+  uint8_t *tx; /* responses the socket has not taken yet */
+  size_t tx_len, tx_cap;
+} client;
+
+typedef struct {
+  int client;
+  unsigned gen;
+  uint32_t op;
+  uint32_t id;
+  size_t row; /* row in the encode or decode batch buffer */
+} pending;
+
+static client clients[MAX_CLIENTS];
+static struct pollfd pfd[MAX_CLIENTS + 1];
+
+static pending *pend;
+static int n_pend;
+static struct timespec first_pend;
+
+static uint8_t *enc_in, *enc_out, *dec_buf;
+static int *dec_status;
+static size_t n_enc, n_dec;
+
+static size_t info_bytes, code_bytes, rx_cap, tx_max;
+static long window_us = 200;
+static int max_batch = 256;
+static int n_threads = 0;
+
+static long long n_batches, n_frames, n_dropped;
+
+static volatile sig_atomic_t stop;
+
+static void on_signal(int sig) {
+  (void)sig;
+  stop = 1;
+}
+
+static long long elapsed_us(const struct timespec *a,
+                            const struct timespec *b) {
+  return (b->tv_sec - a->tv_sec) * 1000000LL +
+         (b->tv_nsec - a->tv_nsec) / 1000;
+}
+
+/* ------------------------------------------------------------------------- */
+/* I/O helpers                                                                */
+/* ------------------------------------------------------------------------- */
+static void close_client(int c) {
+  close(clients[c].fd);
+  clients[c].fd = -1;
+  clients[c].tx_len = 0;
+}
+
+/* Send as much of the queued output as the socket takes; -1 on error */
+static int send_queued(int c) {
+  client *cl = &clients[c];
+  size_t off = 0;
+
+  while (off < cl->tx_len) {
+    ssize_t n = send(cl->fd, cl->tx + off, cl->tx_len - off, MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+        break;
+      return -1;
+    }
+    off += (size_t)n;
+  }
+  memmove(cl->tx, cl->tx + off, cl->tx_len - off);
+  cl->tx_len -= off;
+  return 0;
+}
+
+/* Append to the client's output queue, growing it up to tx_max */
+static int queue(int c, const void *buf, size_t len) {
+  client *cl = &clients[c];
+
+  if (cl->tx_len + len > tx_max)
+    return -1;
+  if (cl->tx_len + len > cl->tx_cap) {
+    size_t cap = cl->tx_cap ? cl->tx_cap : 4096;
+    while (cap < cl->tx_len + len)
+      cap *= 2;
+    if (cap > tx_max)
+      cap = tx_max;
+    uint8_t *tx = (uint8_t *)realloc(cl->tx, cap);
+    if (!tx)
+      return -1;
+    cl->tx = tx;
+    cl->tx_cap = cap;
+  }
+  memcpy(cl->tx + cl->tx_len, buf, len);
+  cl->tx_len += len;
+  return 0;
+}
+
+static void respond(int c, unsigned gen, int32_t status, uint32_t id,
+                    const void *payload, uint32_t len) {
+  if (clients[c].fd < 0 || clients[c].gen != gen)
+    return; /* client went away while its request was pending */
+
+  /* Queue, then send what the socket takes now; the rest goes out on
+   * POLLOUT. A client that stops reading is dropped, not waited for. */
+  rs_svc_resp r = {RS_SVC_MAGIC, status, id, len};
+  int was_idle = (clients[c].tx_len == 0);
+  if (queue(c, &r, sizeof(r)) != 0 ||
+      (len && queue(c, payload, len) != 0)) {
+    n_dropped++;
+    close_client(c);
+    return;
+  }
+  if (was_idle && send_queued(c) != 0)
+    close_client(c);
+}
+
+/* ------------------------------------------------------------------------- */
+/* Batching                                                                   */
+/* ------------------------------------------------------------------------- */
+static void flush_batch(void) {
+  if (n_pend == 0)
+    return;
+
+  if (n_enc)
+    rs_encode_batch(enc_in, info_bytes, enc_out, code_bytes, n_enc, n_threads);
+  if (n_dec)
+    rs_decode_batch(dec_buf, code_bytes, dec_buf, code_bytes, dec_status,
+                    n_dec, n_threads);
+
+  for (int i = 0; i < n_pend; i++) {
+    pending *p = &pend[i];
+    if (p->op == RS_SVC_ENCODE)
+      respond(p->client, p->gen, 0, p->id, &enc_out[p->row * code_bytes],
+              (uint32_t)code_bytes);
+    else
+      respond(p->client, p->gen, dec_status[p->row], p->id,
+              &dec_buf[p->row * code_bytes], (uint32_t)code_bytes);
+  }
+
+  n_batches++;
+  n_frames += n_pend;
+  n_pend = 0;
+  n_enc = 0;
+  n_dec = 0;
+}
+
+static void handle_request(int c, const rs_svc_req *req,
+                           const uint8_t *payload) {
+  int m = rs_m, N = rs_N, K = rs_K;
+  unsigned gen = clients[c].gen;
+
+  switch (req->op) {
+  case RS_SVC_ENCODE:
+  case RS_SVC_DECODE: {
+    int enc = (req->op == RS_SVC_ENCODE);
+    if (req->len != (enc ? info_bytes : code_bytes)) {
+      flush_batch(); /* keep per-client response order */
+      respond(c, gen, RS_SVC_EBADREQ, req->id, NULL, 0);
+      return;
+    }
+    if (n_pend == max_batch)
+      flush_batch();
+    if (n_pend == 0)
+      clock_gettime(CLOCK_MONOTONIC, &first_pend);
+
+    pending *p = &pend[n_pend++];
+    p->client = c;
+    p->gen = gen;
+    p->op = req->op;
+    p->id = req->id;
+    if (enc) {
+      p->row = n_enc++;
+      memcpy(&enc_in[p->row * info_bytes], payload, info_bytes);
+    } else {
+      p->row = n_dec++;
+      memcpy(&dec_buf[p->row * code_bytes], payload, code_bytes);
+    }
+    return;
+  }
+
+  case RS_SVC_INFO: {
+    int32_t info[3] = {m, N, K};
+    flush_batch();
+    respond(c, gen, 0, req->id, info, sizeof(info));
+    return;
+  }
+
+  case RS_SVC_SET_WINDOW:
+    flush_batch();
+    if (req->len != sizeof(uint32_t)) {
+      respond(c, gen, RS_SVC_EBADREQ, req->id, NULL, 0);
+      return;
+    }
+    uint32_t us;
+    memcpy(&us, payload, sizeof(us));
+    window_us = us;
+    respond(c, gen, 0, req->id, NULL, 0);
+    return;
+
+  default:
+    flush_batch();
+    respond(c, gen, RS_SVC_EBADREQ, req->id, NULL, 0);
+  }
+}
+
+/* Read what is available and handle every complete request */
+static void service_client(int c) {
+  client *cl = &clients[c];
+
+  for (;;) {
+    ssize_t n = read(cl->fd, cl->rx + cl->rx_len, rx_cap - cl->rx_len);
+    if (n > 0) {
+      cl->rx_len += (size_t)n;
+    } else if (n < 0 && errno == EINTR) {
+      continue;
+    } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      break;
+    } else {
+      close_client(c); /* EOF or error */
+      return;
+    }
+
+    size_t off = 0;
+    while (cl->rx_len - off >= sizeof(rs_svc_req)) {
+      rs_svc_req req;
+      memcpy(&req, cl->rx + off, sizeof(req));
+      if (req.magic != RS_SVC_MAGIC ||
+          req.len > rx_cap - sizeof(rs_svc_req)) {
+        close_client(c); /* protocol error: cannot resynchronize */
+        return;
+      }
+      if (cl->rx_len - off < sizeof(req) + req.len)
+        break;
+      handle_request(c, &req, cl->rx + off + sizeof(req));
+      if (cl->fd < 0)
+        return;
+      off += sizeof(req) + req.len;
+    }
+    memmove(cl->rx, cl->rx + off, cl->rx_len - off);
+    cl->rx_len -= off;
+  }
+}
+
+/* True if a server answers on the socket path. A stale socket file (no
+ * listener) is removed so that bind() can reuse the path; anything else
+ * at the path is left alone and bind() reports it. */
+static int socket_in_use(const struct sockaddr_un *addr) {
+  struct stat st;
+  if (lstat(addr->sun_path, &st) != 0 || !S_ISSOCK(st.st_mode))
+    return 0;
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0)
+    return 0;
+  int live = (connect(fd, (const struct sockaddr *)addr, sizeof(*addr)) == 0);
+  int refused = !live && errno == ECONNREFUSED;
+  close(fd);
+  if (refused)
+    unlink(addr->sun_path);
+  return live;
+}
+
+/* ======================================================================== */
+/* MAIN                                                                      */
+/* ======================================================================== */
+int main(int argc, char **argv) {
+  const char *path = (argc > 1) ? argv[1] : RS_SVC_DEFAULT_PATH;
+  int m = (argc > 2) ? atoi(argv[2]) : 8;
+  int N = (argc > 3) ? atoi(argv[3]) : 255;
+  int K = (argc > 4) ? atoi(argv[4]) : 223;
+  window_us = (argc > 5) ? atol(argv[5]) : 200;
+  max_batch = (argc > 6) ? atoi(argv[6]) : 256;
+  n_threads = (argc > 7) ? atoi(argv[7]) : 0;
+
+  if (max_batch < 1 || rs_gf_init(m, N, K, N - K) != 0) {
+    fprintf(stderr, "Invalid parameters.\n");
+    return 1;
+  }
+
+  info_bytes = rs_packed_bytes(K);
+  code_bytes = rs_packed_bytes(N);
+  rx_cap = sizeof(rs_svc_req) + code_bytes; /* largest valid request */
+  tx_max = TX_BACKLOG * (sizeof(rs_svc_resp) + code_bytes);
+
+  pend = (pending *)malloc(max_batch * sizeof(pending));
+  enc_in = (uint8_t *)malloc(max_batch * info_bytes);
+  enc_out = (uint8_t *)malloc(max_batch * code_bytes);
+  dec_buf = (uint8_t *)malloc(max_batch * code_bytes);
+  dec_status = (int *)malloc(max_batch * sizeof(int));
+  if (!pend || !enc_in || !enc_out || !dec_buf || !dec_status) {
+    fprintf(stderr, "Memory allocation failed.\n");
+    return 1;
+  }
+
+  int lfd = socket(AF_UNIX, SOCK_STREAM, 0);
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path);
+  if (socket_in_use(&addr)) {
+    fprintf(stderr, "ERROR: another rs_server is listening on %s\n", path);
+    return 1;
+  }
+  if (lfd < 0 || bind(lfd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+      listen(lfd, 64) != 0) {
+    perror("rs_server: socket");
+    return 1;
+  }
+  fcntl(lfd, F_SETFL, O_NONBLOCK);
+
+  signal(SIGINT, on_signal);
+  signal(SIGTERM, on_signal);
+
+  for (int i = 0; i < MAX_CLIENTS; i++) {
+    clients[i].fd = -1;
+    clients[i].gen = 0;
+    clients[i].rx = (uint8_t *)malloc(rx_cap);
+    clients[i].rx_len = 0;
+    clients[i].tx = NULL;
+    clients[i].tx_len = clients[i].tx_cap = 0;
+    if (!clients[i].rx) {
+      fprintf(stderr, "Memory allocation failed.\n");
+      return 1;
+    }
+  }
+
+  printf("rs_server: RS(%d,%d) over GF(2^%d) on %s, window %ld us, "
+         "max batch %d\n",
+         N, K, m, path, window_us, max_batch);
+  fflush(stdout);
+
+  while (!stop) {
+    /* Poll set: listener + connected clients */
+    int idx[MAX_CLIENTS];
+    int nfds = 1;
+    pfd[0] = (struct pollfd){lfd, POLLIN, 0};
+    for (int i = 0; i < MAX_CLIENTS; i++)
+      if (clients[i].fd >= 0) {
+        idx[nfds - 1] = i;
+        short ev = POLLIN | (clients[i].tx_len ? POLLOUT : 0);
+        pfd[nfds++] = (struct pollfd){clients[i].fd, ev, 0};
+      }
+
+    /* Wake up when the oldest pending request reaches the window */
+    struct timespec ts, *timeout = NULL;
+    if (n_pend > 0) {
+      struct timespec now;
+      clock_gettime(CLOCK_MONOTONIC, &now);
+      long long left = window_us - elapsed_us(&first_pend, &now);
+      if (left < 0)
+        left = 0;
+      ts.tv_sec = left / 1000000;
+      ts.tv_nsec = (left % 1000000) * 1000;
+      timeout = &ts;
+    }
+
+    if (ppoll(pfd, nfds, timeout, NULL) < 0 && errno != EINTR)
+      break;
+
+    if (pfd[0].revents & POLLIN) {
+      int cfd;
+      while ((cfd = accept(lfd, NULL, NULL)) >= 0) {
+        int slot = -1;
+        for (int i = 0; i < MAX_CLIENTS && slot < 0; i++)
+          if (clients[i].fd < 0)
+            slot = i;
+        if (slot < 0) {
+          close(cfd);
+          continue;
+        }
+        fcntl(cfd, F_SETFL, O_NONBLOCK);
+        clients[slot].fd = cfd;
+        clients[slot].gen++;
+        clients[slot].rx_len = 0;
+        clients[slot].tx_len = 0;
+      }
+    }
+
+    for (int k = 1; k < nfds; k++) {
+      int c = idx[k - 1];
+      if (clients[c].fd != pfd[k].fd)
+        continue; /* dropped while answering another client */
+      if ((pfd[k].revents & POLLOUT) && send_queued(c) != 0) {
+        close_client(c);
+        continue;
+      }
+      if (pfd[k].revents & (POLLIN | POLLHUP | POLLERR))
+        service_client(c);
+    }
+
+    if (n_pend > 0) {
+      struct timespec now;
+      clock_gettime(CLOCK_MONOTONIC, &now);
+      if (n_pend >= max_batch || elapsed_us(&first_pend, &now) >= window_us)
+        flush_batch();
+    }
+  }
+
+  flush_batch();
+  close(lfd);
+  unlink(path);
+
+  printf("rs_server: %lld frames in %lld batches (avg %.1f per batch), "
+         "%lld slow clients dropped\n",
+         n_frames, n_batches, n_batches ? (double)n_frames / n_batches : 0.0,
+         n_dropped);
+
+  return 0;
+}
+
+#endif /* _WIN32 */
@@ -0,0 +1,105 @@
+import threading
+
+import numpy as np
+
+import _rs_codec
+
+# =============================================================================
+#  NumPy front end for the `_rs_codec` extension
+#
+#  Frames are packed uint8 rows (see include/rs_pack.h; for m = 8 one byte
+#  per symbol). Arrays are passed to C without copies, and the GIL is
+#  released while the batch kernels run on `threads` threads (0 = all CPUs).
+#
+#  The C codec holds one code per process, so selecting a code and running
+#  a batch on it happen under one module lock: RSCodec objects may be used
+#  from several Python threads, their batches run one at a time.
+#
+#  Example:
+#      import numpy as np, rs_codec
+#      rs = rs_codec.RSCodec(8, 255, 223)
+#      info = np.random.randint(0, 256, (10000, 223), dtype=np.uint8)
+#      code = rs.encode(info)
+#      code[:, :8] ^= 0x5A                     # corrupt 8 symbols per frame
+#      status = rs.decode(code, out=code)      # in-place correction
+# =============================================================================
+
+
+class RSCodec:
+    """Shortened systematic RS(N, K) code over GF(2^m).
+
+    The C codec holds one code per process; each call re-selects this
+    code if another RSCodec was used in between, under a module lock
+    held until its batch is done.
+
+    verify=True turns on post-correction verification: a correction that
+    is not a codeword of the shortened code is rejected with status -2
+    (frame left as received) instead of being applied.
+
+    bit_order ('lsb' or 'msb') and packing ('dense' or 'aligned') select
+    the frame wire format (include/rs_pack.h), e.g. bit_order='msb' for
+    10-bit symbols packed big-endian across bytes, packing='aligned' for
+    one symbol per 16-bit word.
+    """
+
+    _current = None
+    _lock = threading.Lock()
+
+    def __init__(self, m, N, K, verify=False, bit_order="lsb",
+                 packing="dense"):
+        if bit_order not in ("lsb", "msb"):
+            raise ValueError("bit_order must be 'lsb' or 'msb'")
+        if packing not in ("dense", "aligned"):
+            raise ValueError("packing must be 'dense' or 'aligned'")
+        self.m, self.N, self.K = m, N, K
+        self.verify = bool(verify)
+        self.msb_first = bit_order == "msb"
+        self.aligned = packing == "aligned"
+        with RSCodec._lock:
+            self._select()
+        self.info_bytes = _rs_codec.packed_bytes(K)
+        self.code_bytes = _rs_codec.packed_bytes(N)
+
+    def _select(self):
+        # Caller holds RSCodec._lock
+        key = (self.m, self.N, self.K, self.verify, self.msb_first,
+               self.aligned)
+        if RSCodec._current != key:
+            _rs_codec.init(self.m, self.N, self.K)
+            _rs_codec.set_verify(self.verify)
+            _rs_codec.set_io_format(self.msb_first, self.aligned)
+            RSCodec._current = key
+
+    def encode(self, info, out=None, threads=0):
+        """Encode (n, info_bytes) uint8 frames → (n, code_bytes)."""
+        info = np.asarray(info, dtype=np.uint8)
+        if out is None:
+            out = np.empty(info.shape[:-1] + (self.code_bytes,), np.uint8)
+        with RSCodec._lock:
+            self._select()
+            _rs_codec.encode(info, out, threads=threads)
+        return out
+
+    def decode(self, recv, out=None, threads=0):
+        """Decode (n, code_bytes) uint8 frames.
+
+        Corrected frames are written to `out` (a new array by default;
+        pass `out=recv` to correct in place). Returns the per-frame int32
+        status: corrected symbol count, -1 if uncorrectable, or -2 if
+        verification rejected the correction.
+        """
+        recv = np.asarray(recv, dtype=np.uint8)
+        if out is None:
+            out = np.empty_like(recv)
+        n = 1 if recv.ndim == 1 else recv.shape[0]
+        status = np.empty(n, np.int32)
+        with RSCodec._lock:
+            self._select()
+            _rs_codec.decode(recv, out, status, threads=threads)
+        return status
+
+    def info(self, code):
+        """Information part of packed codewords (a view when m = 8)."""
+        if self.aligned or (self.K * self.m) % 8 == 0:
+            return code[..., : self.info_bytes]
+        raise ValueError("information part is not byte aligned for this m")
@@ -0,0 +1,284 @@
+/**
+ * @file rs_codec_module.c
+ * @brief CPython extension `_rs_codec`: batch RS encode/decode.
+ *
+ * All frame arguments are objects exporting the buffer protocol with
+ * 1-byte items (NumPy uint8 arrays, bytearray, memoryview, ...):
+ *
+ *   - 1-D : a single packed frame
+ *   - 2-D : one packed frame per row; rows must be contiguous, the row
+ *           stride may be anything (slices of larger arrays work)
+ *
+ * Buffers are used in place (no copies) and the GIL is released while the
+ * multi-threaded batch kernels (rs_batch.h) run.
+ *
+ * The RS code is process-global (rs_gf_init). init(), set_verify() and
+ * set_io_format() raise RuntimeError while another thread is inside
+ * encode()/decode(); rs_codec.py serialises selection and batches with a
+ * lock so that never happens through the wrapper.
+ *
+ * Python API (see rs_codec.py for the NumPy-friendly wrapper):
+ *   init(m, N, K)
+ *   set_verify(flag)
+ *   set_io_format(msb_first, aligned)
+ *   packed_bytes(n_sym) -> int
+ *   encode(info, code, threads=0)
+ *   decode(recv, code, status=None, threads=0)
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "rs_batch.h"
+#include "rs_decoder.h"
+#include "rs_gf.h"
+#include "rs_pack.h"
+
+/* -------------------------------------------------------------------------
+ * Buffer helpers
+ * ------------------------------------------------------------------------- */
+
+/* View a 1-D/2-D byte buffer as frames of at least `need` bytes. */
+static int frame_view(PyObject *obj, Py_buffer *view, int writable,
+                      size_t need, size_t *n_frames, size_t *stride) {
+  int flags = PyBUF_STRIDES | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+  if (PyObject_GetBuffer(obj, view, flags) != 0)
+    return -1;
+
+  if (view->itemsize != 1 || view->ndim < 1 || view->ndim > 2) {
+    PyErr_SetString(PyExc_ValueError, "expected a 1-D or 2-D uint8 buffer");
+    goto fail;
+  }
+
+  size_t row_len = (size_t)view->shape[view->ndim - 1];
+  if (view->strides[view->ndim - 1] != 1) {
+    PyErr_SetString(PyExc_ValueError, "frame bytes must be contiguous");
+    goto fail;
+  }
+  if (row_len < need) {
+    PyErr_Format(PyExc_ValueError, "frame needs %zu bytes, got %zu", need,
+                 row_len);
+    goto fail;
+  }
+
+  if (view->ndim == 1) {
+    *n_frames = 1;
+    *stride = row_len;
+  } else {
+    if (view->strides[0] < (Py_ssize_t)need) {
+      PyErr_SetString(PyExc_ValueError, "overlapping or negative row stride");
+      goto fail;
+    }
+    *n_frames = (size_t)view->shape[0];
+    *stride = (size_t)view->strides[0];
+  }
+  return 0;
+
+fail:
+  PyBuffer_Release(view);
+  return -1;
+}
+
+/* struct-module format of a native C int: "i", optionally with a native
+ * ("@", "=") or matching explicit byte-order prefix */
+static int is_int_format(const char *f) {
+  const uint16_t one = 1;
+  int little = *(const uint8_t *)&one;
+
+  if (!f)
+    return 0;
+  if (*f == '@' || *f == '=' || *f == (little ? '<' : '>'))
+    f++;
+  return strcmp(f, "i") == 0 && sizeof(int) == 4;
+}
+
+static int code_ready(void) {
+  if (rs_T <= 0) {
+    PyErr_SetString(PyExc_RuntimeError, "call init(m, N, K) first");
+    return 0;
+  }
+  return 1;
+}
+
+/* Batches running with the GIL released; only changed with the GIL held */
+static int batches_running;
+
+/* The code and the I/O format must not change under a running batch */
+static int codec_idle(void) {
+  if (batches_running > 0) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "codec in use by an encode()/decode() in another thread");
+    return 0;
+  }
+  return 1;
+}
+
+/* -------------------------------------------------------------------------
+ * Module functions
+ * ------------------------------------------------------------------------- */
+static PyObject *py_init(PyObject *self, PyObject *args) {
+  int m, N, K;
+  if (!PyArg_ParseTuple(args, "iii", &m, &N, &K) || !codec_idle())
+    return NULL;
+  if (rs_gf_init(m, N, K, N - K) != 0) {
+    PyErr_SetString(PyExc_ValueError, "invalid RS parameters");
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+static PyObject *py_set_verify(PyObject *self, PyObject *args) {
+  int flag;
+  if (!PyArg_ParseTuple(args, "p", &flag) || !codec_idle())
+    return NULL;
+  rs_decode_set_verify(flag);
+  Py_RETURN_NONE;
+}
+
+static PyObject *py_set_io_format(PyObject *self, PyObject *args) {
+  int msb, aligned;
+  if (!PyArg_ParseTuple(args, "pp", &msb, &aligned) || !codec_idle())
+    return NULL;
+  rs_io_set_format(msb ? RS_BIT_MSB_FIRST : RS_BIT_LSB_FIRST,
+                   aligned ? RS_PACK_ALIGNED : RS_PACK_DENSE);
+  Py_RETURN_NONE;
+}
+
+static PyObject *py_packed_bytes(PyObject *self, PyObject *args) {
+  int n_sym;
+  if (!PyArg_ParseTuple(args, "i", &n_sym) || !code_ready())
+    return NULL;
+  return PyLong_FromSize_t(rs_packed_bytes(n_sym));
+}
+
+static PyObject *py_encode(PyObject *self, PyObject *args, PyObject *kw) {
+  static char *kwlist[] = {"info", "code", "threads", NULL};
+  PyObject *info_obj, *code_obj;
+  int threads = 0;
+  if (!PyArg_ParseTupleAndKeywords(args, kw, "OO|i", kwlist, &info_obj,
+                                   &code_obj, &threads) ||
+      !code_ready())
+    return NULL;
+
+  Py_buffer info, code;
+  size_t n_info, n_code, s_info, s_code;
+  if (frame_view(info_obj, &info, 0, rs_packed_bytes(rs_K), &n_info,
+                 &s_info) != 0)
+    return NULL;
+  if (frame_view(code_obj, &code, 1, rs_packed_bytes(rs_N), &n_code,
+                 &s_code) != 0) {
+    PyBuffer_Release(&info);
+    return NULL;
+  }
+  if (n_info != n_code) {
+    PyErr_SetString(PyExc_ValueError, "info and code frame counts differ");
+    PyBuffer_Release(&info);
+    PyBuffer_Release(&code);
+    return NULL;
+  }
+
+  int ret;
+  batches_running++;
+  Py_BEGIN_ALLOW_THREADS
+  ret = rs_encode_batch((const uint8_t *)info.buf, s_info,
+                        (uint8_t *)code.buf, s_code, n_info, threads);
+  Py_END_ALLOW_THREADS
+  batches_running--;
+
+  PyBuffer_Release(&info);
+  PyBuffer_Release(&code);
+  if (ret != 0)
+    return PyErr_NoMemory();
+  Py_RETURN_NONE;
+}
+
+static PyObject *py_decode(PyObject *self, PyObject *args, PyObject *kw) {
+  static char *kwlist[] = {"recv", "code", "status", "threads", NULL};
+  PyObject *recv_obj, *code_obj, *status_obj = Py_None;
+  int threads = 0;
+  if (!PyArg_ParseTupleAndKeywords(args, kw, "OO|Oi", kwlist, &recv_obj,
+                                   &code_obj, &status_obj, &threads) ||
+      !code_ready())
+    return NULL;
+
+  size_t need = rs_packed_bytes(rs_N);
+  Py_buffer recv, code, status = {0};
+  size_t n_recv, n_code, s_recv, s_code;
+  if (frame_view(recv_obj, &recv, 0, need, &n_recv, &s_recv) != 0)
+    return NULL;
+  if (frame_view(code_obj, &code, 1, need, &n_code, &s_code) != 0) {
+    PyBuffer_Release(&recv);
+    return NULL;
+  }
+
+  int ok = (n_recv == n_code);
+  if (!ok)
+    PyErr_SetString(PyExc_ValueError, "recv and code frame counts differ");
+
+  if (ok && status_obj != Py_None) {
+    ok = (PyObject_GetBuffer(status_obj, &status,
+                             PyBUF_C_CONTIGUOUS | PyBUF_FORMAT |
+                                 PyBUF_WRITABLE) == 0);
+    if (ok && (status.itemsize != sizeof(int) ||
+               !is_int_format(status.format) ||
+               (size_t)(status.len / sizeof(int)) < n_recv)) {
+      PyErr_SetString(PyExc_ValueError,
+                      "status must be a contiguous int32 buffer per frame");
+      PyBuffer_Release(&status);
+      ok = 0;
+    }
+  }
+  if (!ok) {
+    PyBuffer_Release(&recv);
+    PyBuffer_Release(&code);
+    return NULL;
+  }
+
+  int ret;
+  batches_running++;
+  Py_BEGIN_ALLOW_THREADS
+  ret = rs_decode_batch((const uint8_t *)recv.buf, s_recv,
+                        (uint8_t *)code.buf, s_code, (int *)status.buf, n_recv,
+                        threads);
+  Py_END_ALLOW_THREADS
+  batches_running--;
+
+  PyBuffer_Release(&recv);
+  PyBuffer_Release(&code);
+  if (status.obj)
+    PyBuffer_Release(&status);
+  if (ret != 0)
+    return PyErr_NoMemory();
+  Py_RETURN_NONE;
+}
+
+/* -------------------------------------------------------------------------
+ * Module definition
+ * ------------------------------------------------------------------------- */
+static PyMethodDef rs_codec_methods[] = {
+    {"init", py_init, METH_VARARGS, "init(m, N, K): select the RS code."},
+    {"set_verify", py_set_verify, METH_VARARGS,
+     "set_verify(flag): post-correction verification on/off (status -2 "
+     "flags a rejected correction)."},
+    {"set_io_format", py_set_io_format, METH_VARARGS,
+     "set_io_format(msb_first, aligned): frame bit order and symbol "
+     "packing (rs_pack.h)."},
+    {"packed_bytes", py_packed_bytes, METH_VARARGS,
+     "packed_bytes(n_sym): bytes per packed frame of n_sym symbols."},
+    {"encode", (PyCFunction)(void (*)(void))py_encode,
+     METH_VARARGS | METH_KEYWORDS,
+     "encode(info, code, threads=0): batch-encode packed frames."},
+    {"decode", (PyCFunction)(void (*)(void))py_decode,
+     METH_VARARGS | METH_KEYWORDS,
+     "decode(recv, code, status=None, threads=0): batch-decode packed "
+     "frames; code may be recv for in-place decoding."},
+    {NULL, NULL, 0, NULL}};
+
+static struct PyModuleDef rs_codec_module = {
+    PyModuleDef_HEAD_INIT, "_rs_codec",
+    "Reed-Solomon batch codec on packed uint8 buffers.", -1,
+    rs_codec_methods};
+
+PyMODINIT_FUNC PyInit__rs_codec(void) {
+  return PyModule_Create(&rs_codec_module);
+}
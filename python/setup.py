@@ -0,0 +1,37 @@
+"""
+Build the `_rs_codec` CPython extension in place:
+
+    cd python
+    python setup.py build_ext --inplace
+
+(or `make python` from the repository root)
+"""
+
+from setuptools import Extension, setup
+
+CODEC_SRC = [
+    "../src/rs_gf.c",
+    "../src/rs_encoder.c",
+    "../src/rs_decoder.c",
+    "../src/rs_pack.c",
+    "../src/rs_workspace.c",
+    "../src/rs_batch.c",
+    "../src/rs_poly.c",
+    "../src/rs_gf16.c",
+    "../src/rs_trace.c",
+]
+
+setup(
+    name="rs_codec",
+    version="0.2.0",
+    py_modules=["rs_codec"],
+    ext_modules=[
+        Extension(
+            "_rs_codec",
+            sources=["rs_codec_module.c"] + CODEC_SRC,
+            include_dirs=["../include"],
+            extra_compile_args=["-O2", "-std=c11", "-pthread"],
+            extra_link_args=["-pthread"],
+        )
+    ],
+)
@@ -0,0 +1,307 @@
+/**
+ * @file rs_async.c
+ * @brief Asynchronous submit/complete encode and decode on a worker pool.
+ *
+ * Submitted jobs form a FIFO. A worker claims the next chunk of frames of
+ * the job at its head under the pool lock, and dequeues the job once all of
+ * its frames are claimed, so one large job spreads over every worker while
+ * small jobs still complete in submission order. Each worker owns a
+ * workspace; the worker that finishes a job's last frame completes it.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "rs_async.h"
+#include "rs_batch.h"
+#include "rs_decoder.h"
+#include "rs_encoder.h"
+#include "rs_gf.h"
+#include "rs_workspace.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <unistd.h>
+#elif !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+struct rs_async {
+  pthread_mutex_t lock;
+  pthread_cond_t work;      /* job queue non-empty or stopping */
+  pthread_cond_t completed; /* completion queue non-empty */
+
+  rs_async_job *head, *tail;           /* submitted, frames unclaimed */
+  rs_async_job *done_head, *done_tail; /* completed, not reaped */
+  int stop;
+
+  size_t chunk;
+  int n_threads;
+  pthread_t *tid;
+  rs_workspace **ws; /* one per worker */
+  int n_ws;
+  int fd[2]; /* completion signal: eventfd (fd[0] only) or pipe */
+};
+
+/* -------------------------------------------------------------------------
+ * Completion signal
+ * ------------------------------------------------------------------------- */
+static int signal_open(rs_async *a) {
+#if defined(__linux__)
+  a->fd[0] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  return (a->fd[0] >= 0) ? 0 : -1;
+#elif !defined(_WIN32)
+  if (pipe(a->fd) != 0)
+    return -1;
+  for (int i = 0; i < 2; i++) {
+    fcntl(a->fd[i], F_SETFL, O_NONBLOCK);
+    fcntl(a->fd[i], F_SETFD, FD_CLOEXEC);
+  }
+  return 0;
+#else
+  return 0;
+#endif
+}
+
+static void signal_close(rs_async *a) {
+#ifndef _WIN32
+  for (int i = 0; i < 2; i++)
+    if (a->fd[i] >= 0)
+      close(a->fd[i]);
+#endif
+}
+
+/* Make the descriptor readable; lock held, queue was empty */
+static void signal_raise(rs_async *a) {
+#if defined(__linux__)
+  uint64_t one = 1;
+  while (write(a->fd[0], &one, sizeof(one)) < 0 && errno == EINTR)
+    ;
+#elif !defined(_WIN32)
+  char one = 1;
+  while (write(a->fd[1], &one, 1) < 0 && errno == EINTR)
+    ;
+#else
+  (void)a;
+#endif
+}
+
+/* Make the descriptor unreadable; lock held, queue now empty */
+static void signal_clear(rs_async *a) {
+#if defined(__linux__)
+  uint64_t v;
+  while (read(a->fd[0], &v, sizeof(v)) < 0 && errno == EINTR)
+    ;
+#elif !defined(_WIN32)
+  char buf[64];
+  while (read(a->fd[0], buf, sizeof(buf)) > 0 || errno == EINTR)
+    ;
+#else
+  (void)a;
+#endif
+}
+
+/* -------------------------------------------------------------------------
+ * Workers
+ * ------------------------------------------------------------------------- */
+typedef struct {
+  rs_async *a;
+  rs_workspace *ws;
+} worker_arg;
+
+static void run_frames(rs_workspace *ws, rs_async_job *j, size_t begin,
+                       size_t end) {
+  for (size_t f = begin; f < end; f++) {
+    const uint8_t *in = j->in + f * j->in_stride;
+    uint8_t *out = j->out + f * j->out_stride;
+
+    if (j->op == RS_ASYNC_ENCODE) {
+      rs_encode_packed_ws(ws, in, out);
+      continue;
+    }
+    int st = rs_decode_packed_ws(ws, in, out, NULL);
+    if (j->status)
+      j->status[f] = st;
+    if (j->bits)
+      j->bits[f] = ws->corr_bits;
+  }
+}
+
+/* Job j has no frames left to process; lock held, released on return */
+static void complete_unlock(rs_async *a, rs_async_job *j) {
+  if (j->done) {
+    pthread_mutex_unlock(&a->lock);
+    j->done(j);
+    return;
+  }
+  j->next = NULL;
+  if (a->done_tail) {
+    a->done_tail->next = j;
+  } else {
+    a->done_head = j;
+    signal_raise(a);
+    pthread_cond_broadcast(&a->completed);
+  }
+  a->done_tail = j;
+  pthread_mutex_unlock(&a->lock);
+}
+
+static void *worker(void *arg) {
+  rs_async *a = ((worker_arg *)arg)->a;
+  rs_workspace *ws = ((worker_arg *)arg)->ws;
+  free(arg);
+
+  pthread_mutex_lock(&a->lock);
+  for (;;) {
+    while (!a->head && !a->stop)
+      pthread_cond_wait(&a->work, &a->lock);
+    if (!a->head)
+      break; /* stopping and drained */
+
+    /* Claim the next chunk of the head job */
+    rs_async_job *j = a->head;
+    size_t begin = j->next_frame;
+    size_t end = (j->n_frames - begin > a->chunk) ? begin + a->chunk
+                                                  : j->n_frames;
+    j->next_frame = end;
+    if (end == j->n_frames && !(a->head = j->next))
+      a->tail = NULL;
+    pthread_mutex_unlock(&a->lock);
+
+    run_frames(ws, j, begin, end);
+
+    pthread_mutex_lock(&a->lock);
+    j->frames_left -= end - begin;
+    if (j->frames_left == 0) {
+      complete_unlock(a, j);
+      pthread_mutex_lock(&a->lock);
+    }
+  }
+  pthread_mutex_unlock(&a->lock);
+  return NULL;
+}
+
+/* -------------------------------------------------------------------------
+ * Pool
+ * ------------------------------------------------------------------------- */
+rs_async *rs_async_create(int n_threads, size_t chunk) {
+  if (rs_N <= 0) {
+    fprintf(stderr, "ERROR: rs_async_create() needs rs_gf_init() first\n");
+    return NULL;
+  }
+  if (n_threads <= 0)
+    n_threads = rs_batch_default_threads();
+
+  rs_async *a = (rs_async *)calloc(1, sizeof(*a));
+  if (!a)
+    return NULL;
+  a->chunk = chunk ? chunk : RS_ASYNC_CHUNK;
+  a->fd[0] = a->fd[1] = -1;
+  a->tid = (pthread_t *)calloc((size_t)n_threads, sizeof(pthread_t));
+  a->ws = (rs_workspace **)calloc((size_t)n_threads, sizeof(rs_workspace *));
+  int ok = a->tid && a->ws && signal_open(a) == 0;
+  for (; ok && a->n_ws < n_threads; a->n_ws++)
+    ok = (a->ws[a->n_ws] = rs_workspace_create()) != NULL;
+  pthread_mutex_init(&a->lock, NULL);
+  pthread_cond_init(&a->work, NULL);
+  pthread_cond_init(&a->completed, NULL);
+
+  /* Fewer workers than asked for is fine, none is not */
+  for (; ok && a->n_threads < n_threads; a->n_threads++) {
+    worker_arg *w = (worker_arg *)malloc(sizeof(*w));
+    if (!w)
+      break;
+    w->a = a;
+    w->ws = a->ws[a->n_threads];
+    if (pthread_create(&a->tid[a->n_threads], NULL, worker, w) != 0) {
+      free(w);
+      break;
+    }
+  }
+  if (a->n_threads == 0) {
+    rs_async_destroy(a);
+    return NULL;
+  }
+  return a;
+}
+
+void rs_async_destroy(rs_async *a) {
+  if (!a)
+    return;
+  pthread_mutex_lock(&a->lock);
+  a->stop = 1;
+  pthread_cond_broadcast(&a->work);
+  pthread_mutex_unlock(&a->lock);
+  for (int i = 0; i < a->n_threads; i++)
+    pthread_join(a->tid[i], NULL);
+
+  pthread_mutex_destroy(&a->lock);
+  pthread_cond_destroy(&a->work);
+  pthread_cond_destroy(&a->completed);
+  signal_close(a);
+  for (int i = 0; i < a->n_ws; i++)
+    rs_workspace_destroy(a->ws[i]);
+  free(a->ws);
+  free(a->tid);
+  free(a);
+}
+
+int rs_async_submit(rs_async *a, rs_async_job *job) {
+  if ((job->op != RS_ASYNC_ENCODE && job->op != RS_ASYNC_DECODE) ||
+      (job->n_frames && (!job->in || !job->out)))
+    return -1;
+
+  job->next = NULL;
+  job->next_frame = 0;
+  job->frames_left = job->n_frames;
+
+  pthread_mutex_lock(&a->lock);
+  if (job->n_frames == 0) {
+    complete_unlock(a, job);
+    return 0;
+  }
+  if (a->tail)
+    a->tail->next = job;
+  else
+    a->head = job;
+  a->tail = job;
+  pthread_cond_broadcast(&a->work);
+  pthread_mutex_unlock(&a->lock);
+  return 0;
+}
+
+int rs_async_fd(const rs_async *a) { return a->fd[0]; }
+
+/* Pop the first completed job; lock held, queue non-empty */
+static rs_async_job *pop_done(rs_async *a) {
+  rs_async_job *j = a->done_head;
+  if (!(a->done_head = j->next)) {
+    a->done_tail = NULL;
+    signal_clear(a);
+  }
+  j->next = NULL;
+  return j;
+}
+
+size_t rs_async_reap(rs_async *a, rs_async_job **jobs, size_t max) {
+  size_t n = 0;
+  pthread_mutex_lock(&a->lock);
+  while (n < max && a->done_head)
+    jobs[n++] = pop_done(a);
+  pthread_mutex_unlock(&a->lock);
+  return n;
+}
+
+rs_async_job *rs_async_wait(rs_async *a) {
+  pthread_mutex_lock(&a->lock);
+  while (!a->done_head)
+    pthread_cond_wait(&a->completed, &a->lock);
+  rs_async_job *j = pop_done(a);
+  pthread_mutex_unlock(&a->lock);
+  return j;
+}
@@ -0,0 +1,254 @@
+/**
+ * @file rs_batch.c
+ * @brief Multi-threaded batch encode/decode on packed frames.
+ *
+ * The batch is cut into n_threads contiguous chunks of frames. The calling
+ * thread processes the first chunk itself (with its default workspace);
+ * every additional chunk runs on a short-lived worker thread that owns a
+ * private workspace for the duration of the call.
+ *
+ * Strided symbol frames (rs_*_batch_sym) are gathered into the workspace
+ * symbol buffer unless their symbols are contiguous, and only written back
+ * where the codec changed them.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "rs_batch.h"
+#include "rs_decoder.h"
+#include "rs_encoder.h"
+#include "rs_gf.h"
+#include "rs_workspace.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+typedef enum {
+  OP_ENCODE_PACKED,
+  OP_DECODE_PACKED,
+  OP_ENCODE_SYM,
+  OP_DECODE_SYM
+} batch_op;
+
+typedef struct {
+  batch_op op;
+  const uint8_t *in;
+  size_t in_stride;
+  uint8_t *out;
+  size_t out_stride;
+  rs_sym_t *sym; /* OP_*_SYM: frames, strides in symbols */
+  size_t frame_stride;
+  size_t sym_stride;
+  const int *eras_pos;
+  int n_eras;
+  int *status;
+  int *bits;
+  size_t begin;
+  size_t end;
+  int ret;
+} batch_chunk;
+
+/* -------------------------------------------------------------------------
+ * Per-chunk kernel
+ * ------------------------------------------------------------------------- */
+static void gather(const rs_sym_t *src, size_t stride, rs_sym_t *dst,
+                   int n) {
+  for (int i = 0; i < n; i++)
+    dst[i] = src[i * stride];
+}
+
+static void scatter(const rs_sym_t *src, rs_sym_t *dst, size_t stride,
+                    int n) {
+  for (int i = 0; i < n; i++)
+    dst[i * stride] = src[i];
+}
+
+static void run_sym_frame(batch_chunk *c, rs_workspace *ws, size_t f) {
+  rs_sym_t *frame = c->sym + f * c->frame_stride;
+  size_t ss = c->sym_stride;
+  int K = rs_K, N = rs_N;
+
+  if (c->op == OP_ENCODE_SYM) {
+    if (ss == 1) {
+      rs_encode_sym(frame, frame);
+      return;
+    }
+    gather(frame, ss, ws->sym, K);
+    rs_encode_sym(ws->sym, ws->sym);
+    scatter(ws->sym + K, frame + K * ss, ss, N - K);
+    return;
+  }
+
+  int st;
+  if (ss == 1) {
+    st = rs_decode_sym_erasures_ws(ws, frame, c->eras_pos, c->n_eras);
+  } else {
+    /* The decoder's own buffers do not include ws->sym */
+    gather(frame, ss, ws->sym, N);
+    st = rs_decode_sym_erasures_ws(ws, ws->sym, c->eras_pos, c->n_eras);
+    if (st > 0)
+      scatter(ws->sym, frame, ss, N);
+  }
+  if (c->status)
+    c->status[f] = st;
+  if (c->bits)
+    c->bits[f] = ws->corr_bits;
+}
+
+static void run_chunk(batch_chunk *c, rs_workspace *ws) {
+  for (size_t f = c->begin; f < c->end; f++) {
+    const uint8_t *in = c->in + f * c->in_stride;
+    uint8_t *out = c->out + f * c->out_stride;
+
+    switch (c->op) {
+    case OP_DECODE_PACKED: {
+      int st = rs_decode_packed_ws(ws, in, out, NULL);
+      if (c->status)
+        c->status[f] = st;
+      if (c->bits)
+        c->bits[f] = ws->corr_bits;
+      break;
+    }
+    case OP_ENCODE_PACKED:
+      rs_encode_packed_ws(ws, in, out);
+      break;
+    default:
+      run_sym_frame(c, ws, f);
+      break;
+    }
+  }
+}
+
+static void *chunk_worker(void *arg) {
+  batch_chunk *c = (batch_chunk *)arg;
+  rs_workspace *ws = rs_workspace_create();
+
+  if (!ws) {
+    c->ret = -1;
+    return NULL;
+  }
+  run_chunk(c, ws);
+  rs_workspace_destroy(ws);
+  return NULL;
+}
+
+int rs_batch_default_threads(void) {
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  if (n > RS_BATCH_MAX_THREADS)
+    return RS_BATCH_MAX_THREADS;
+  return (n > 0) ? (int)n : 1;
+}
+
+/* -------------------------------------------------------------------------
+ * Split the batch and run the chunks
+ * ------------------------------------------------------------------------- */
+static int run_batch(const batch_chunk *proto, size_t n_frames,
+                     int n_threads) {
+  if (n_frames == 0)
+    return 0;
+  int max_threads = rs_batch_default_threads();
+  if (n_threads <= 0 || n_threads > max_threads)
+    n_threads = max_threads;
+  if ((size_t)n_threads > n_frames)
+    n_threads = (int)n_frames;
+
+  batch_chunk chunk[RS_BATCH_MAX_THREADS];
+  pthread_t tid[RS_BATCH_MAX_THREADS];
+  int started[RS_BATCH_MAX_THREADS];
+
+  size_t per = n_frames / n_threads;
+  size_t extra = n_frames % n_threads;
+  size_t begin = 0;
+
+  for (int i = 0; i < n_threads; i++) {
+    size_t len = per + ((size_t)i < extra ? 1 : 0);
+    chunk[i] = *proto;
+    chunk[i].begin = begin;
+    chunk[i].end = begin + len;
+    chunk[i].ret = 0;
+    begin += len;
+  }
+
+  for (int i = 1; i < n_threads; i++)
+    started[i] = (pthread_create(&tid[i], NULL, chunk_worker, &chunk[i]) == 0);
+
+  /* Calling thread: first chunk, plus any chunk whose thread failed */
+  int ret = 0;
+  rs_workspace *ws = rs_workspace_default();
+  if (ws) {
+    run_chunk(&chunk[0], ws);
+    for (int i = 1; i < n_threads; i++)
+      if (!started[i])
+        run_chunk(&chunk[i], ws);
+  } else {
+    ret = -1;
+  }
+
+  for (int i = 1; i < n_threads; i++) {
+    if (started[i])
+      pthread_join(tid[i], NULL);
+    if (chunk[i].ret != 0)
+      ret = chunk[i].ret;
+  }
+
+  return ret;
+}
+
+int rs_encode_batch(const uint8_t *info_pack, size_t info_stride,
+                    uint8_t *code_pack, size_t code_stride, size_t n_frames,
+                    int n_threads) {
+  batch_chunk c = {.op = OP_ENCODE_PACKED,
+                   .in = info_pack,
+                   .in_stride = info_stride,
+                   .out = code_pack,
+                   .out_stride = code_stride};
+  return run_batch(&c, n_frames, n_threads);
+}
+
+int rs_decode_batch(const uint8_t *recv_pack, size_t recv_stride,
+                    uint8_t *code_pack, size_t code_stride, int *status,
+                    size_t n_frames, int n_threads) {
+  return rs_decode_batch_bits(recv_pack, recv_stride, code_pack, code_stride,
+                              status, NULL, n_frames, n_threads);
+}
+
+int rs_decode_batch_bits(const uint8_t *recv_pack, size_t recv_stride,
+                         uint8_t *code_pack, size_t code_stride, int *status,
+                         int *bits, size_t n_frames, int n_threads) {
+  batch_chunk c = {.op = OP_DECODE_PACKED,
+                   .in = recv_pack,
+                   .in_stride = recv_stride,
+                   .out = code_pack,
+                   .out_stride = code_stride,
+                   .status = status,
+                   .bits = bits};
+  return run_batch(&c, n_frames, n_threads);
+}
+
+/* -------------------------------------------------------------------------
+ * Strided symbol frames
+ * ------------------------------------------------------------------------- */
+int rs_encode_batch_sym(rs_sym_t *sym, size_t frame_stride,
+                        size_t sym_stride, size_t n_frames, int n_threads) {
+  batch_chunk c = {.op = OP_ENCODE_SYM,
+                   .sym = sym,
+                   .frame_stride = frame_stride,
+                   .sym_stride = sym_stride};
+  return run_batch(&c, n_frames, n_threads);
+}
+
+int rs_decode_batch_sym(rs_sym_t *sym, size_t frame_stride,
+                        size_t sym_stride, const int *eras_pos, int n_eras,
+                        int *status, size_t n_frames, int n_threads) {
+  if (n_eras < 0 || n_eras > rs_T)
+    return -1;
+  batch_chunk c = {.op = OP_DECODE_SYM,
+                   .sym = sym,
+                   .frame_stride = frame_stride,
+                   .sym_stride = sym_stride,
+                   .eras_pos = eras_pos,
+                   .n_eras = n_eras,
+                   .status = status};
+  return run_batch(&c, n_frames, n_threads);
+}
@@ -0,0 +1,301 @@
+/**
+ * @file rs_conv.c
+ * @brief Rate-1/2, K = 7 convolutional inner code and Viterbi decoder.
+ *
+ * Trellis:
+ *   The encoder register holds the last 7 input bits, newest in bit 0, so
+ *   the taps are the generators 171 / 133 (octal, current input first)
+ *   bit-reversed: 0x4F / 0x6D. A state is the newest 6 bits. Old state i
+ *   and i + 32 both lead to new states 2i (input 0) and 2i + 1 (input 1).
+ *   Both tap sets contain bits 0 and 6, so the branch i → 2i carries the
+ *   same code bits as i + 32 → 2i + 1, and the complement of i → 2i + 1:
+ *   one branch metric bm per butterfly, the other is 510 - bm.
+ *
+ * Branch metric (distance, minimised): for expected bit e and soft value
+ * s, s if e = 0 and 255 - s if e = 1, i.e. s ^ (e ? 255 : 0).
+ *
+ * Decisions: bit s of dec[k] is 1 when new state s at step k came from the
+ * upper predecessor (s >> 1) + 32. Ties go to the lower predecessor in
+ * every kernel. Metrics are renormalised (minimum subtracted) every 16
+ * steps, which keeps them below 2^14 in 16-bit lanes.
+ */
+
+#include "rs_conv.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RS_CONV_X86 1
+#include <immintrin.h>
+#endif
+
+#define TAPS_A 0x4F /* 0171 bit-reversed (bit 0 = current input) */
+#define TAPS_B 0x6D /* 0133 bit-reversed */
+#define N_STATES 64
+#define BM_MAX 510        /* two soft bits of distance 255 */
+#define INIT_METRIC 4096  /* start bias of states other than 0 */
+#define RENORM_PERIOD 16
+
+struct rs_viterbi {
+  int max_bits;
+  uint64_t *dec; /* [max_bits + RS_CONV_TAIL] decisions */
+  void (*acs)(const uint8_t *soft, int steps, uint64_t *dec);
+};
+
+static int parity(unsigned x) {
+  x ^= x >> 4;
+  x ^= x >> 2;
+  x ^= x >> 1;
+  return (int)(x & 1);
+}
+
+/* Expected code bits (0 / 255) of the branch i → 2i, i < 32 */
+static void branch_tables(int16_t e0[32], int16_t e1[32]) {
+  for (int i = 0; i < 32; i++) {
+    e0[i] = (int16_t)(parity((unsigned)(2 * i) & TAPS_A) ? 255 : 0);
+    e1[i] = (int16_t)(parity((unsigned)(2 * i) & TAPS_B) ? 255 : 0);
+  }
+}
+
+/* -------------------------------------------------------------------------
+ * Encoder
+ * ------------------------------------------------------------------------- */
+void rs_conv_encode(const uint8_t *bits, int n_bits, uint8_t *coded) {
+  unsigned sr = 0;
+  for (int k = 0; k < n_bits + RS_CONV_TAIL; k++) {
+    unsigned b = (k < n_bits) ? (bits[k] & 1u) : 0u;
+    sr = ((sr << 1) | b) & 0x7F;
+    coded[2 * k] = (uint8_t)parity(sr & TAPS_A);
+    coded[2 * k + 1] = (uint8_t)parity(sr & TAPS_B);
+  }
+}
+
+/* -------------------------------------------------------------------------
+ * Add-compare-select: scalar
+ * ------------------------------------------------------------------------- */
+static void acs_scalar(const uint8_t *soft, int steps, uint64_t *dec) {
+  int16_t e0[32], e1[32];
+  int m[N_STATES], nm[N_STATES];
+
+  branch_tables(e0, e1);
+  for (int s = 0; s < N_STATES; s++)
+    m[s] = s ? INIT_METRIC : 0;
+
+  for (int k = 0; k < steps; k++) {
+    int s0 = soft[2 * k], s1 = soft[2 * k + 1];
+    uint64_t d = 0;
+
+    for (int i = 0; i < 32; i++) {
+      int bm = (s0 ^ e0[i]) + (s1 ^ e1[i]);
+      int a0 = m[i] + bm, b0 = m[i + 32] + (BM_MAX - bm);
+      int a1 = m[i] + (BM_MAX - bm), b1 = m[i + 32] + bm;
+      int c0 = (b0 < a0), c1 = (b1 < a1);
+      nm[2 * i] = c0 ? b0 : a0;
+      nm[2 * i + 1] = c1 ? b1 : a1;
+      d |= ((uint64_t)c0 << (2 * i)) | ((uint64_t)c1 << (2 * i + 1));
+    }
+    dec[k] = d;
+    memcpy(m, nm, sizeof(m));
+
+    if (k % RENORM_PERIOD == RENORM_PERIOD - 1) {
+      int mn = m[0];
+      for (int s = 1; s < N_STATES; s++)
+        if (m[s] < mn)
+          mn = m[s];
+      for (int s = 0; s < N_STATES; s++)
+        m[s] -= mn;
+    }
+  }
+}
+
+#ifdef RS_CONV_X86
+/* -------------------------------------------------------------------------
+ * Add-compare-select: SSE2, states in 8 registers of 8 lanes
+ * ------------------------------------------------------------------------- */
+__attribute__((target("sse2"))) static void
+acs_sse2(const uint8_t *soft, int steps, uint64_t *dec) {
+  int16_t e0[32], e1[32];
+  branch_tables(e0, e1);
+
+  __m128i E0[4], E1[4], m[8], nm[8];
+  for (int q = 0; q < 4; q++) {
+    E0[q] = _mm_loadu_si128((const __m128i *)&e0[8 * q]);
+    E1[q] = _mm_loadu_si128((const __m128i *)&e1[8 * q]);
+  }
+  for (int r = 0; r < 8; r++)
+    m[r] = _mm_set1_epi16(INIT_METRIC);
+  m[0] = _mm_insert_epi16(m[0], 0, 0);
+  const __m128i bm_max = _mm_set1_epi16(BM_MAX);
+
+  for (int k = 0; k < steps; k++) {
+    __m128i s0 = _mm_set1_epi16(soft[2 * k]);
+    __m128i s1 = _mm_set1_epi16(soft[2 * k + 1]);
+    uint64_t d = 0;
+
+    for (int q = 0; q < 4; q++) { /* butterflies i = 8q .. 8q + 7 */
+      __m128i bm = _mm_add_epi16(_mm_xor_si128(s0, E0[q]),
+                                 _mm_xor_si128(s1, E1[q]));
+      __m128i cbm = _mm_sub_epi16(bm_max, bm);
+      __m128i a0 = _mm_add_epi16(m[q], bm), b0 = _mm_add_epi16(m[q + 4], cbm);
+      __m128i a1 = _mm_add_epi16(m[q], cbm), b1 = _mm_add_epi16(m[q + 4], bm);
+      __m128i n0 = _mm_min_epi16(a0, b0), n1 = _mm_min_epi16(a1, b1);
+      __m128i c0 = _mm_cmpgt_epi16(a0, b0), c1 = _mm_cmpgt_epi16(a1, b1);
+
+      /* new states 2i, 2i + 1 interleaved: 16q .. 16q + 15 */
+      nm[2 * q] = _mm_unpacklo_epi16(n0, n1);
+      nm[2 * q + 1] = _mm_unpackhi_epi16(n0, n1);
+      __m128i dd = _mm_packs_epi16(_mm_unpacklo_epi16(c0, c1),
+                                   _mm_unpackhi_epi16(c0, c1));
+      d |= (uint64_t)(unsigned)_mm_movemask_epi8(dd) << (16 * q);
+    }
+    dec[k] = d;
+    memcpy(m, nm, sizeof(m));
+
+    if (k % RENORM_PERIOD == RENORM_PERIOD - 1) {
+      __m128i mn = m[0];
+      for (int r = 1; r < 8; r++)
+        mn = _mm_min_epi16(mn, m[r]);
+      mn = _mm_min_epi16(mn, _mm_shuffle_epi32(mn, 0x4E));
+      mn = _mm_min_epi16(mn, _mm_shuffle_epi32(mn, 0xB1));
+      mn = _mm_min_epi16(mn, _mm_shufflelo_epi16(mn, 0xB1));
+      mn = _mm_shuffle_epi32(_mm_shufflelo_epi16(mn, 0x00), 0x00);
+      for (int r = 0; r < 8; r++)
+        m[r] = _mm_sub_epi16(m[r], mn);
+    }
+  }
+}
+
+/* -------------------------------------------------------------------------
+ * Add-compare-select: AVX2, states in 4 registers of 16 lanes
+ * ------------------------------------------------------------------------- */
+__attribute__((target("avx2"))) static void
+acs_avx2(const uint8_t *soft, int steps, uint64_t *dec) {
+  int16_t e0[32], e1[32];
+  branch_tables(e0, e1);
+
+  __m256i E0[2], E1[2], m[4], nm[4];
+  for (int q = 0; q < 2; q++) {
+    E0[q] = _mm256_loadu_si256((const __m256i *)&e0[16 * q]);
+    E1[q] = _mm256_loadu_si256((const __m256i *)&e1[16 * q]);
+  }
+  for (int r = 0; r < 4; r++)
+    m[r] = _mm256_set1_epi16(INIT_METRIC);
+  m[0] = _mm256_insert_epi16(m[0], 0, 0);
+  const __m256i bm_max = _mm256_set1_epi16(BM_MAX);
+
+  for (int k = 0; k < steps; k++) {
+    __m256i s0 = _mm256_set1_epi16(soft[2 * k]);
+    __m256i s1 = _mm256_set1_epi16(soft[2 * k + 1]);
+    uint64_t d = 0;
+
+    for (int q = 0; q < 2; q++) { /* butterflies i = 16q .. 16q + 15 */
+      __m256i bm = _mm256_add_epi16(_mm256_xor_si256(s0, E0[q]),
+                                    _mm256_xor_si256(s1, E1[q]));
+      __m256i cbm = _mm256_sub_epi16(bm_max, bm);
+      __m256i a0 = _mm256_add_epi16(m[q], bm);
+      __m256i b0 = _mm256_add_epi16(m[q + 2], cbm);
+      __m256i a1 = _mm256_add_epi16(m[q], cbm);
+      __m256i b1 = _mm256_add_epi16(m[q + 2], bm);
+      __m256i n0 = _mm256_min_epi16(a0, b0), n1 = _mm256_min_epi16(a1, b1);
+      __m256i c0 = _mm256_cmpgt_epi16(a0, b0);
+      __m256i c1 = _mm256_cmpgt_epi16(a1, b1);
+
+      /* unpack works per 128-bit half: lo = states 32q + {0..7, 16..23},
+       * hi = 32q + {8..15, 24..31} */
+      __m256i lo = _mm256_unpacklo_epi16(n0, n1);
+      __m256i hi = _mm256_unpackhi_epi16(n0, n1);
+      nm[2 * q] = _mm256_permute2x128_si256(lo, hi, 0x20);
+      nm[2 * q + 1] = _mm256_permute2x128_si256(lo, hi, 0x31);
+
+      /* packs interleaves the halves back into state order */
+      __m256i dd = _mm256_packs_epi16(_mm256_unpacklo_epi16(c0, c1),
+                                      _mm256_unpackhi_epi16(c0, c1));
+      d |= (uint64_t)(uint32_t)_mm256_movemask_epi8(dd) << (32 * q);
+    }
+    dec[k] = d;
+    memcpy(m, nm, sizeof(m));
+
+    if (k % RENORM_PERIOD == RENORM_PERIOD - 1) {
+      __m256i mn = _mm256_min_epi16(_mm256_min_epi16(m[0], m[1]),
+                                    _mm256_min_epi16(m[2], m[3]));
+      __m128i h = _mm_min_epi16(_mm256_castsi256_si128(mn),
+                                _mm256_extracti128_si256(mn, 1));
+      h = _mm_minpos_epu16(h); /* metrics are non-negative */
+      __m256i sub = _mm256_set1_epi16((int16_t)_mm_extract_epi16(h, 0));
+      for (int r = 0; r < 4; r++)
+        m[r] = _mm256_sub_epi16(m[r], sub);
+    }
+  }
+}
+#endif /* RS_CONV_X86 */
+
+/* -------------------------------------------------------------------------
+ * Kernel selection and decoder
+ * ------------------------------------------------------------------------- */
+typedef void (*acs_fn)(const uint8_t *, int, uint64_t *);
+
+static acs_fn select_kernel(const char **name) {
+#ifdef RS_CONV_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    *name = "avx2";
+    return acs_avx2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    *name = "sse2";
+    return acs_sse2;
+  }
+#endif
+  *name = "scalar";
+  return acs_scalar;
+}
+
+const char *rs_viterbi_kernel(void) {
+  const char *name;
+  select_kernel(&name);
+  return name;
+}
+
+rs_viterbi *rs_viterbi_create(int max_bits) {
+  if (max_bits < 1)
+    return NULL;
+  rs_viterbi *v = (rs_viterbi *)malloc(sizeof(rs_viterbi));
+  if (!v)
+    return NULL;
+  v->max_bits = max_bits;
+  v->dec = (uint64_t *)malloc((size_t)(max_bits + RS_CONV_TAIL) *
+                              sizeof(uint64_t));
+  if (!v->dec) {
+    free(v);
+    return NULL;
+  }
+  const char *name;
+  v->acs = select_kernel(&name);
+  return v;
+}
+
+void rs_viterbi_destroy(rs_viterbi *v) {
+  if (!v)
+    return;
+  free(v->dec);
+  free(v);
+}
+
+int rs_viterbi_decode(rs_viterbi *v, const uint8_t *soft, int n_bits,
+                      uint8_t *bits) {
+  if (n_bits < 0 || n_bits > v->max_bits)
+    return -1;
+  int steps = n_bits + RS_CONV_TAIL;
+  v->acs(soft, steps, v->dec);
+
+  /* Traceback from state 0 (terminated frame) */
+  unsigned s = 0;
+  for (int k = steps - 1; k >= 0; k--) {
+    if (k < n_bits)
+      bits[k] = (uint8_t)(s & 1);
+    unsigned c = (unsigned)(v->dec[k] >> s) & 1u;
+    s = (s >> 1) | (c << 5);
+  }
+  return 0;
+}
@@ -20,51 +20,133 @@
  * The decoder assumes:
  *   - rs_gf_init() has been called
  *   - recv_bits contains Ns * m bits
+ *
+ * All scratch buffers come from an rs_workspace (explicit *_ws variants,
+ * or the calling thread's default workspace), so no decoding stage
+ * allocates or keeps field-sized arrays on the stack.
+ *
+ * The polynomial work of every stage (evaluation, the BM discrepancy and
+ * update, row operations, Ω(x)) goes through the kernels of rs_poly.h.
  */
 
 #include "rs_decoder.h"
+#include "rs_encoder.h"
 #include "rs_gf.h"
+#if RS_M_MAX > 8
+#include "rs_gf16.h"
+#endif
+#include "rs_pack.h"
+#include "rs_poly.h"
+#include "rs_trace.h"
 
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
 /* -------------------------------------------------------------------------
- * Helpers: bits <-> symbol (LSB-first ordering)
+ * Helpers: bits <-> symbol (LSB- or MSB-first ordering, rs_pack.h)
  * ------------------------------------------------------------------------- */
-static uint16_t bits_to_symbol(const int *bits, int m) {
+static uint16_t bits_to_symbol(const int *bits, int m, int msb_first) {
   uint16_t v = 0;
-  for (int i = 0; i < m; i++)
-    v |= (uint16_t)((bits[i] & 1) << i);
+  if (msb_first)
+    for (int i = 0; i < m; i++)
+      v = (uint16_t)(v << 1 | (bits[i] & 1));
+  else
+    for (int i = 0; i < m; i++)
+      v |= (uint16_t)((bits[i] & 1) << i);
   return v;
 }
 
-static void symbol_to_bits(uint16_t symbol, int *bits, int m) {
+static void symbol_to_bits(uint16_t symbol, int *bits, int m, int msb_first) {
   for (int b = 0; b < m; b++)
-    bits[b] = rs_symbol_bits[symbol][b];
+#ifdef RS_COMPACT
+    bits[b] = (symbol >> (msb_first ? m - 1 - b : b)) & 1;
+#else
+    bits[b] = rs_symbol_bits[symbol][msb_first ? m - 1 - b : b];
+#endif
 }
 
 /* -------------------------------------------------------------------------
  * 1) Syndrome computation (on parent length Np)
  *
- *     S_i = Σ_{j=0}^{Np-1} r_j α^{(i+1)*j},   for i = 0..T-1
+ *     S_i = Σ_{j=0}^{Np-1} r_j α^{e_i*j},   for i = 0..T-1
+ *
+ * e_i = rs_gf_root_log(i) are the generator roots (e_i = i for the
+ * default code), so these are exactly the evaluations that vanish on a
+ * valid codeword.
+ * The S leading parent symbols of a shortened code are zero and are
+ * skipped: recv_sym holds only the Ns transmitted symbols (j = S + n).
+ * syndromes_range() sums the symbols [n0, n1) only, r[0] being symbol n0.
+ *
+ * The T roots α^{e_i} form a geometric sequence, so S_i = α^{e_i*(S + n0)}
+ * R(α^{e_i}) with R(x) = Σ r_{n0+n} x^n comes from one
+ * rs_poly_eval_geom() call. Dual-basis words (m = 8, at most 255 symbols)
+ * are converted into a stack copy first.
+ *
+ * Remainder backend (RS_SYND_REMAINDER): re-encoding the K information
+ * symbols gives a codeword c with the same information part, whose
+ * syndromes vanish. r - c is zero but for the parity positions, where it
+ * holds the remainder of r(x) modulo g(x), so the syndromes of r are those
+ * of the T-symbol range [K, N) of r - c: T·T products instead of N·T, after
+ * an encoder pass that costs K·T with the encoder's kernels. A zero
+ * remainder is a clean word, with no evaluation at all.
  *
  * Zero syndromes → no errors.
  * ------------------------------------------------------------------------- */
-static void compute_syndromes(const uint16_t *recv_sym_p, uint16_t *S) {
-  int Np = rs_Np;
-  int T = rs_T;
+static void syndromes_range(const rs_sym_t *r, int n0, int n1, rs_sym_t *S) {
+  const rs_sym_t *conv = rs_dual_to_conv;
+  rs_sym_t buf[256];
+
+  if (conv) {
+    for (int n = 0; n < n1 - n0; n++)
+      buf[n] = conv[r[n]];
+    r = buf;
+  }
 
-  for (int i = 0; i < T; i++) {
-    uint16_t sum = 0;
-    int si = i + 1; /* Evaluate at α^(i+1) */
+  rs_poly_eval_geom(r, n1 - n0, rs_gf_root_log(0), rs_root_step, rs_T, S);
+  for (int i = 0; i < rs_T; i++)
+    if (S[i])
+      S[i] = (rs_sym_t)rs_gf_mul(
+          S[i], rs_gf_exp[(long long)rs_gf_root_log(i) * (rs_S + n0) % rs_Np]);
+}
 
-    for (int j = 0; j < Np; j++) {
-      int k = (si * j) % rs_Np;
-      sum ^= rs_gf_mul(recv_sym_p[j], rs_gf_exp[k]);
-    }
-    S[i] = sum;
+static rs_synd_method synd_method = RS_SYND_DIRECT;
+
+void rs_decode_set_syndrome_method(rs_synd_method method) {
+  synd_method = method;
+}
+
+rs_synd_method rs_decode_get_syndrome_method(void) { return synd_method; }
+
+static int syndromes_remainder(const rs_sym_t *recv_sym, rs_sym_t *S) {
+  int K = rs_K, T = rs_T;
+  rs_sym_t rem[RS_SYND_REM_T_MAX];
+  int dirty = 0;
+
+  rs_encode_parity(recv_sym, rem);
+  for (int j = 0; j < T; j++) {
+    rem[j] ^= recv_sym[K + j];
+    dirty |= (rem[j] != 0);
   }
+  if (!dirty) {
+    memset(S, 0, (size_t)T * sizeof(rs_sym_t));
+    return 0;
+  }
+  syndromes_range(rem, K, rs_N, S);
+  return 1;
+}
+
+static int compute_syndromes(const rs_sym_t *recv_sym, rs_sym_t *S) {
+  int dirty = 0;
+
+  if (synd_method == RS_SYND_REMAINDER && rs_T <= RS_SYND_REM_T_MAX)
+    return syndromes_remainder(recv_sym, S);
+
+  syndromes_range(recv_sym, 0, rs_N, S);
+  for (int i = 0; i < rs_T; i++)
+    dirty |= (S[i] != 0);
+
+  return dirty;
 }
 
 /* -------------------------------------------------------------------------
@@ -76,12 +158,18 @@ static void compute_syndromes(const uint16_t *recv_sym_p, uint16_t *S) {
  *
  * L = degree of error-locator polynomial
  * ------------------------------------------------------------------------- */
-static int berlekamp_massey(const uint16_t *S, uint16_t *sigma_out) {
+static int berlekamp_massey(rs_workspace *ws, const rs_sym_t *S,
+                            rs_sym_t *sigma_out) {
   int T = rs_T;
   int t = T / 2;
 
-  uint16_t C[RS_GF_MAX] = {0}; /* current polynomial */
-  uint16_t B[RS_GF_MAX] = {0}; /* previous polynomial */
+  rs_sym_t *C = ws->bm_C;      /* current polynomial */
+  rs_sym_t *B = ws->bm_B;      /* previous polynomial */
+  rs_sym_t *Temp = ws->bm_tmp; /* copy of C(x) before the update */
+  for (int i = 0; i <= T; i++) {
+    C[i] = 0;
+    B[i] = 0;
+  }
   C[0] = 1;
   B[0] = 1;
 
@@ -90,23 +178,17 @@ static int berlekamp_massey(const uint16_t *S, uint16_t *sigma_out) {
   uint16_t bbb = 1;
 
   for (int n = 0; n < T; n++) {
-    uint16_t d = S[n];
-    for (int i = 1; i <= L; i++)
-      d ^= rs_gf_mul(C[i], S[n - i]);
+    /* d = coefficient n of C(x) S(x) (C[0] = 1) */
+    uint16_t d = rs_poly_mul_coef(C, L + 1, S, T, n);
 
     if (d != 0) {
-      uint16_t Temp[RS_GF_MAX];
       for (int i = 0; i <= T; i++)
         Temp[i] = C[i];
 
       uint16_t coef = rs_gf_div(d, bbb);
 
       /* C(x) ← C(x) - coef * x^m_shift * B(x) */
-      for (int i = 0; i <= T; i++) {
-        int idx = i + m_shift;
-        if (idx <= T)
-          C[idx] ^= rs_gf_mul(coef, B[i]);
-      }
+      rs_poly_scale_add(C + m_shift, C + m_shift, coef, B, T + 1 - m_shift);
 
       if (2 * L <= n) {
         /* Update B(x) ← previous C(x) */
@@ -139,85 +221,139 @@ static int berlekamp_massey(const uint16_t *S, uint16_t *sigma_out) {
 /* -------------------------------------------------------------------------
  * 3) Chien search
  *
- * Find i such that σ(α^{-i}) = 0, for i = 0..Np-1.
+ * Find i such that σ(β^{-i}) = 0, for i = 0..Np-1, β = α^{rs_root_step}
+ * (the syndromes are power sums of the locators X = β^i).
  * Each such i corresponds to an error at position i.
+ * chien_range() scans positions [i0, i1) and stops after max_roots roots.
+ * The points β^{-i} form a geometric sequence, evaluated CHIEN_BLOCK at a
+ * time by rs_poly_eval_geom() (σ_j β^{-i·j} advanced by one product per
+ * position and term). Wide fields with vector rs_gf16 kernels take
+ * CHIEN_BLOCK_WIDE positions per call, enough for the term blocks.
  * ------------------------------------------------------------------------- */
-static int chien_search(const uint16_t *sigma, int L, int *error_pos) {
-  int Np = rs_Np;
+#define CHIEN_BLOCK 64
+#if RS_M_MAX > 8
+#define CHIEN_BLOCK_WIDE 1024
+#else
+#define CHIEN_BLOCK_WIDE CHIEN_BLOCK
+#endif
+
+static int chien_range(const rs_sym_t *sigma, int L, int i0, int i1,
+                       int *error_pos, int max_roots) {
+  rs_sym_t val[CHIEN_BLOCK_WIDE];
+  long long step = rs_root_step;
   int count = 0;
+  int block = CHIEN_BLOCK;
+#if RS_M_MAX > 8
+  if (rs_m > 8 && rs_gf16_vector())
+    block = CHIEN_BLOCK_WIDE;
+#endif
+
+  for (int b0 = i0; b0 < i1 && count < max_roots; b0 += block) {
+    int len = (i1 - b0 < block) ? i1 - b0 : block;
+    rs_poly_eval_geom(sigma, L + 1, -step * b0, -step, len, val);
+    for (int k = 0; k < len && count < max_roots; k++)
+      if (val[k] == 0)
+        error_pos[count++] = b0 + k;
+  }
 
-  for (int i = 0; i < Np; i++) {
-    uint16_t x_inv = (i == 0) ? 1 : rs_gf_exp[rs_Np - i];
-    uint16_t sum = 0;
-    uint16_t power = 1;
+  return count;
+}
 
-    for (int j = 0; j <= L; j++) {
-      if (sigma[j] != 0)
-        sum ^= rs_gf_mul(sigma[j], power);
-      power = rs_gf_mul(power, x_inv);
-    }
+static int chien_search(const rs_sym_t *sigma, int L, int *error_pos) {
+  return chien_range(sigma, L, 0, rs_Np, error_pos, L + 1);
+}
+
+/* -------------------------------------------------------------------------
+ * 4a) Post-correction verification (rs_decode_set_verify())
+ *
+ * The syndromes of the corrected word are
+ *
+ *     S'_i = S_i + Σ_k Y_k α^{e_i p_k}
+ *
+ * so they follow from the errata values without re-reading the N symbols:
+ * O(T·e). All T must vanish, and every position must lie in the
+ * transmitted range (p_k ≥ S); a root in the shortened zone would "correct"
+ * a symbol that was never sent, which the plain decoder silently drops.
+ * ------------------------------------------------------------------------- */
+static int verify_enabled = 0;
 
-    if (sum == 0)
-      error_pos[count++] = i;
+void rs_decode_set_verify(int enable) { verify_enabled = (enable != 0); }
 
-    if (count > L)
-      break;
-  }
+int rs_decode_get_verify(void) { return verify_enabled; }
 
-  return count;
+static int errata_consistent(const rs_sym_t *S, const int *error_pos,
+                             const rs_sym_t *val, int cnt) {
+  for (int k = 0; k < cnt; k++)
+    if (error_pos[k] < rs_S)
+      return 0;
+
+  for (int i = 0; i < rs_T; i++) {
+    long long e = rs_gf_root_log(i);
+    uint16_t v = S[i];
+    for (int k = 0; k < cnt; k++)
+      v ^= rs_gf_mul(val[k], rs_gf_exp[e * error_pos[k] % rs_Np]);
+    if (v != 0)
+      return 0;
+  }
+  return 1;
 }
 
 /* -------------------------------------------------------------------------
  * 4) Error magnitude solving via linear system
  *
  * Simplified Forney method:
- *     S_l = Σ e_k α^{(l+1) * i_k}
+ *     S_l = Σ e_k α^{e_l * i_k}
  * Solve for e_k using Gaussian elimination in GF(2^m).
+ *
+ * Returns RS_DECODE_MISCORRECTED, with recv_sym untouched, if verification
+ * is enabled and rejects the solution; 0 otherwise.
  * ------------------------------------------------------------------------- */
-static void correct_errors(uint16_t *recv_sym_p, const uint16_t *S,
-                           const int *error_pos, int error_count) {
+static int correct_errors(rs_workspace *ws, rs_sym_t *recv_sym,
+                          const rs_sym_t *S, const int *error_pos,
+                          int error_count) {
   if (error_count <= 0)
-    return;
+    return 0;
 
   int cnt = error_count;
   int Np = rs_Np;
 
-  uint16_t A[cnt][cnt];
-  uint16_t B[cnt];
-  uint16_t e[cnt];
+  /* cnt × cnt system in the workspace (row stride cnt ≤ t) */
+  rs_sym_t *A = ws->mat;
+  rs_sym_t *B = ws->rhs;
 
   /* Construct linear system */
   for (int r = 0; r < cnt; r++) {
+    int e = rs_gf_root_log(r);
     B[r] = S[r];
     for (int c = 0; c < cnt; c++) {
       int pos = error_pos[c];
-      int exp = ((r + 1) * pos) % Np;
-      A[r][c] = rs_gf_exp[exp];
+      int exp = (int)(((long long)e * pos) % Np);
+      A[r * cnt + c] = rs_gf_exp[exp];
     }
   }
 
   /* Gaussian elimination over GF(2^m) */
   for (int i = 0; i < cnt; i++) {
-    uint16_t piv = A[i][i];
+    uint16_t piv = A[i * cnt + i];
 
     if (piv == 0) {
       int swap_r = -1;
       for (int r = i + 1; r < cnt; r++)
-        if (A[r][i] != 0) {
+        if (A[r * cnt + i] != 0) {
           swap_r = r;
           break;
         }
 
       if (swap_r >= 0) {
         for (int c = 0; c < cnt; c++) {
-          uint16_t tmp = A[i][c];
-          A[i][c] = A[swap_r][c];
-          A[swap_r][c] = tmp;
+          uint16_t tmp = A[i * cnt + c];
+          A[i * cnt + c] = A[swap_r * cnt + c];
+          A[swap_r * cnt + c] = tmp;
         }
         uint16_t tmpB = B[i];
         B[i] = B[swap_r];
         B[swap_r] = tmpB;
-        piv = A[i][i];
+        piv = A[i * cnt + i];
       }
     }
 
@@ -226,94 +362,431 @@ static void correct_errors(uint16_t *recv_sym_p, const uint16_t *S,
 
     uint16_t inv = rs_gf_inv(piv);
     for (int c = 0; c < cnt; c++)
-      A[i][c] = rs_gf_mul(A[i][c], inv);
+      A[i * cnt + c] = rs_gf_mul(A[i * cnt + c], inv);
     B[i] = rs_gf_mul(B[i], inv);
 
     for (int r = 0; r < cnt; r++) {
       if (r == i)
         continue;
-      uint16_t factor = A[r][i];
+      uint16_t factor = A[r * cnt + i];
       if (factor == 0)
         continue;
 
-      for (int c = 0; c < cnt; c++)
-        A[r][c] = rs_gf_add(A[r][c], rs_gf_mul(factor, A[i][c]));
+      rs_poly_scale_add(&A[r * cnt], &A[r * cnt], factor, &A[i * cnt], cnt);
       B[r] = rs_gf_add(B[r], rs_gf_mul(factor, B[i]));
     }
   }
 
-  for (int i = 0; i < cnt; i++)
-    e[i] = B[i];
+  if (verify_enabled && !errata_consistent(S, error_pos, B, cnt))
+    return RS_DECODE_MISCORRECTED;
 
-  /* Apply error corrections */
+  /* Apply error corrections e_k = B[k] (positions inside the shortened
+   * zone are dropped, exactly as if the zero padding had been corrected).
+   * The basis change is linear, so a dual-basis symbol takes the
+   * converted error value directly. */
+  const rs_sym_t *dual = rs_conv_to_dual;
+  int bits = 0;
   for (int k = 0; k < cnt; k++) {
-    int pos = error_pos[k];
-    recv_sym_p[pos] ^= e[k];
+    int pos = error_pos[k] - rs_S;
+    if (pos >= 0) {
+      rs_sym_t e = dual ? dual[B[k]] : B[k];
+      recv_sym[pos] ^= e;
+      bits += __builtin_popcount(e);
+    }
   }
+  ws->corr_bits = bits;
+  return 0;
+}
+
+/* -------------------------------------------------------------------------
+ * 5) Stage-level API
+ *
+ * rs_decode_syndromes() and rs_decode_correct() split the decoder into the
+ * cheap, always-executed syndrome stage and the solver stage (BM → Chien →
+ * magnitudes → correction) that only dirty codewords need.
+ * Both only read the tables built by rs_gf_init(), so they may run
+ * concurrently on different codewords.
+ * ------------------------------------------------------------------------- */
+int rs_decode_syndromes(const rs_sym_t *code_sym, rs_sym_t *synd) {
+  return compute_syndromes(code_sym, synd);
+}
+
+int rs_decode_correct_ws(rs_workspace *ws, rs_sym_t *code_sym,
+                         const rs_sym_t *synd) {
+  int t = rs_T / 2;
+
+  if (rs_workspace_check(ws) != 0)
+    return -1;
+  ws->corr_bits = 0;
+
+  /* BM → locator polynomial */
+  rs_sym_t *sigma = ws->sigma;
+  int L = berlekamp_massey(ws, synd, sigma);
+  int failed = (L > t);
+  if (L > t)
+    L = t;
+
+  /* Chien search */
+  int *error_pos = ws->error_pos;
+  int count = chien_search(sigma, L, error_pos);
+
+  /* A locator of degree L must have exactly L roots in the parent code;
+   * otherwise the word is left as received */
+  if (failed || count != L)
+    return -1;
+
+  /* Correct */
+  int check = correct_errors(ws, code_sym, synd, error_pos, count);
+  if (check < 0)
+    return check;
+  return count;
+}
+
+int rs_decode_locator_ws(rs_workspace *ws, const rs_sym_t *synd,
+                         rs_sym_t *sigma) {
+  if (rs_workspace_check(ws) != 0)
+    return -1;
+  return berlekamp_massey(ws, synd, sigma);
+}
+
+/*
+ * Partial syndromes of symbols [n0, n1): the exponent walk starts at
+ * α^{e_i(S + n0)}, the range's shift within the codeword, so the partials of
+ * disjoint ranges covering 0..Ns-1 XOR to S_i.
+ */
+void rs_decode_syndromes_range(const rs_sym_t *code_sym, int n0, int n1,
+                               rs_sym_t *synd) {
+  syndromes_range(code_sym + n0, n0, n1, synd);
+}
+
+int rs_decode_chien_range(const rs_sym_t *sigma, int L, int i0, int i1,
+                          int *error_pos, int max_roots) {
+  return chien_range(sigma, L, i0, i1, error_pos, max_roots);
+}
+
+int rs_decode_magnitudes_ws(rs_workspace *ws, rs_sym_t *code_sym,
+                            const rs_sym_t *synd, const int *error_pos,
+                            int count) {
+  if (rs_workspace_check(ws) != 0)
+    return -1;
+  ws->corr_bits = 0;
+  if (count > 0 && count <= rs_T / 2)
+    return correct_errors(ws, code_sym, synd, error_pos, count);
+  return 0;
+}
+
+int rs_decode_sym_ws(rs_workspace *ws, rs_sym_t *code_sym) {
+  if (rs_workspace_check(ws) != 0)
+    return -1;
+  if (rs_trace_active)
+    rs_trace_write_sym(rs_trace_active, code_sym, NULL, 0, 0);
+  ws->corr_bits = 0;
+  if (!compute_syndromes(code_sym, ws->synd))
+    return 0;
+  return rs_decode_correct_ws(ws, code_sym, ws->synd);
+}
+
+int rs_decode_last_bits(void) {
+  rs_workspace *ws = rs_workspace_default();
+  return ws ? ws->corr_bits : 0;
+}
+
+int rs_decode_correct(rs_sym_t *code_sym, const rs_sym_t *synd) {
+  rs_workspace *ws = rs_workspace_default();
+  if (!ws)
+    return -1;
+  return rs_decode_correct_ws(ws, code_sym, synd);
+}
+
+int rs_decode_sym(rs_sym_t *code_sym) {
+  rs_workspace *ws = rs_workspace_default();
+  if (!ws)
+    return -1;
+  return rs_decode_sym_ws(ws, code_sym);
 }
 
 /* -------------------------------------------------------------------------
- * 5) Public API: RS decoding
+ * 6) Public API: RS decoding
  *
  * Steps:
- *   - Expand to parent length: [S zero-symbols][Ns received]
+ *   - Convert Ns received symbols (shortened zone is implicit)
  *   - Compute syndromes
  *   - If non-zero: BM → Chien → Solve magnitudes → Correct
  *   - Output:
  *       code_bits : Ns symbols
  *       info_bits : first K symbols
  * ------------------------------------------------------------------------- */
-void rs_decode(const int *recv_bits, int *code_bits, int *info_bits) {
+int rs_decode_ws(rs_workspace *ws, const int *recv_bits, int *code_bits,
+                 int *info_bits) {
   int m = rs_m;
   int Ns = rs_N;
-  int Np = rs_Np;
-  int S = rs_S;
   int K = rs_K;
-  int T = rs_T;
-  int t = T / 2;
+  int order;
+  rs_io_get_format(&order, NULL);
+  int msb = (order == RS_BIT_MSB_FIRST);
 
-  /* Build parent-length buffer */
-  uint16_t recv_sym_p[Np];
+  if (rs_workspace_check(ws) != 0)
+    return -1;
+  rs_sym_t *recv_sym = ws->sym;
+  for (int i = 0; i < Ns; i++)
+    recv_sym[i] = bits_to_symbol(&recv_bits[i * m], m, msb);
 
-  for (int i = 0; i < S; i++)
-    recv_sym_p[i] = 0;
+  int status = rs_decode_sym_ws(ws, recv_sym);
 
+  /* Output corrected shortened codeword */
   for (int i = 0; i < Ns; i++)
-    recv_sym_p[S + i] = bits_to_symbol(&recv_bits[i * m], m);
+    symbol_to_bits(recv_sym[i], &code_bits[i * m], m, msb);
 
-  /* Syndromes */
-  uint16_t synd[T];
-  compute_syndromes(recv_sym_p, synd);
+  /* Output K information symbols */
+  for (int i = 0; i < K; i++)
+    symbol_to_bits(recv_sym[i], &info_bits[i * m], m, msb);
 
-  /* Check if all-zero syndromes → no errors */
-  int all_zero = 1;
-  for (int i = 0; i < T; i++)
-    if (synd[i] != 0) {
-      all_zero = 0;
-      break;
+  return status;
+}
+
+int rs_decode(const int *recv_bits, int *code_bits, int *info_bits) {
+  rs_workspace *ws = rs_workspace_default();
+  if (!ws) {
+    fprintf(stderr, "ERROR: RS workspace allocation failed\n");
+    return -1;
+  }
+  return rs_decode_ws(ws, recv_bits, code_bits, info_bits);
+}
+
+/* -------------------------------------------------------------------------
+ * 7) Packed buffers (rs_pack.h)
+ * ------------------------------------------------------------------------- */
+int rs_decode_packed_ws(rs_workspace *ws, const uint8_t *recv_pack,
+                        uint8_t *code_pack, uint8_t *info_pack) {
+  if (rs_workspace_check(ws) != 0)
+    return -1;
+  rs_sym_t *recv_sym = ws->sym;
+
+  rs_unpack_symbols(recv_pack, recv_sym, rs_N);
+  int status = rs_decode_sym_ws(ws, recv_sym);
+
+  if (code_pack)
+    rs_pack_symbols(recv_sym, code_pack, rs_N);
+  if (info_pack)
+    rs_pack_symbols(recv_sym, info_pack, rs_K);
+
+  return status;
+}
+
+int rs_decode_packed(const uint8_t *recv_pack, uint8_t *code_pack,
+                     uint8_t *info_pack) {
+  rs_workspace *ws = rs_workspace_default();
+  if (!ws)
+    return -1;
+  return rs_decode_packed_ws(ws, recv_pack, code_pack, info_pack);
+}
+
+/* -------------------------------------------------------------------------
+ * 8) Errors-and-erasures decoding
+ *
+ * An erasure (known position, unknown value) costs one parity symbol, an
+ * error two: ρ erasures and e errors are corrected while 2e + ρ ≤ T.
+ *
+ *   - Erasure locator Γ(x) = Π (1 − X_j x), X_j = β^{S + pos_j}.
+ *   - Berlekamp–Massey started from C(x) = B(x) = Γ(x) runs the remaining
+ *     T − ρ steps and yields the errata locator σ(x) = Λ(x) Γ(x).
+ *   - Chien over the transmitted positions only: a root in the shortened
+ *     zone leaves fewer than deg σ roots, and the word is uncorrectable.
+ *   - Forney for all ρ + e values (no linear system, so the workspace
+ *     needs no T × T matrix):
+ *         Y = X^{1-b} Ω(X^{-1}) / σ'(X^{-1}),  Ω = S σ mod x^T
+ *
+ * Corrections are applied only once every value is known, so a word the
+ * decoder gives up on is left unmodified.
+ * ------------------------------------------------------------------------- */
+
+/* β^{(S + pos) · k} as a log, k may be negative */
+static int locator_log(int pos, long long k) {
+  long long e = (long long)rs_root_step * (rs_S + pos) % rs_Np * k % rs_Np;
+  return (int)(e < 0 ? e + rs_Np : e);
+}
+
+/* Errata locator in C[0..T]; returns its degree ρ + e, -1 if 2e + ρ > T */
+static int errata_locator(rs_workspace *ws, const rs_sym_t *S,
+                          const int *eras_pos, int n_eras) {
+  int T = rs_T;
+  rs_sym_t *C = ws->bm_C;
+  rs_sym_t *B = ws->bm_B;
+  rs_sym_t *Temp = ws->bm_tmp;
+
+  memset(C, 0, (size_t)(T + 1) * sizeof(rs_sym_t));
+  C[0] = 1;
+  for (int j = 0; j < n_eras; j++) {
+    uint16_t X = rs_gf_exp[locator_log(eras_pos[j], 1)];
+    for (int i = j + 1; i >= 1; i--)
+      C[i] ^= rs_gf_mul(C[i - 1], X);
+  }
+  memcpy(B, C, (size_t)(T + 1) * sizeof(rs_sym_t));
+
+  int L = 0; /* errors located so far */
+  int m_shift = 1;
+  uint16_t bbb = 1;
+
+  for (int r = n_eras; r < T; r++) {
+    uint16_t d = rs_poly_mul_coef(C, n_eras + L + 1, S, T, r);
+
+    if (d == 0) {
+      m_shift++;
+      continue;
     }
 
-  if (!all_zero) {
-    /* BM → locator polynomial */
-    uint16_t sigma[t + 1];
-    int L = berlekamp_massey(synd, sigma);
-    if (L > t)
-      L = t;
+    memcpy(Temp, C, (size_t)(T + 1) * sizeof(rs_sym_t));
+    uint16_t coef = rs_gf_div(d, bbb);
+    rs_poly_scale_add(C + m_shift, C + m_shift, coef, B, T + 1 - m_shift);
 
-    /* Chien search */
-    int error_pos[t];
-    int count = chien_search(sigma, L, error_pos);
+    if (2 * L <= r - n_eras) {
+      memcpy(B, Temp, (size_t)(T + 1) * sizeof(rs_sym_t));
+      L = r + 1 - n_eras - L;
+      bbb = d;
+      m_shift = 1;
+    } else {
+      m_shift++;
+    }
+  }
+
+  if (2 * L + n_eras > T)
+    return -1;
+  return n_eras + L;
+}
 
-    /* Correct */
-    if (count > 0 && count <= t)
-      correct_errors(recv_sym_p, synd, error_pos, count);
+int rs_decode_sym_erasures_ws(rs_workspace *ws, rs_sym_t *code_sym,
+                              const int *eras_pos, int n_eras) {
+  int T = rs_T, Np = rs_Np;
+
+  if (rs_workspace_check(ws) != 0)
+    return -1;
+  rs_sym_t *S = ws->synd;
+
+  if (rs_trace_active)
+    rs_trace_write_sym(rs_trace_active, code_sym, eras_pos, n_eras, 0);
+  ws->corr_bits = 0;
+  if (n_eras < 0 || n_eras > T)
+    return -1;
+  if (!compute_syndromes(code_sym, S))
+    return 0;
+
+  int deg = errata_locator(ws, S, eras_pos, n_eras);
+  if (deg <= 0)
+    return -1;
+
+  rs_sym_t *sigma = ws->bm_C;
+  int *error_pos = ws->error_pos;
+  int count = chien_range(sigma, deg, rs_S, Np, error_pos, deg + 1);
+  if (count != deg)
+    return -1;
+
+  /* Ω = S σ mod x^T in bm_tmp, values in bm_B */
+  rs_sym_t *omg = ws->bm_tmp;
+  rs_sym_t *val = ws->bm_B;
+  for (int i = 0; i < T; i++)
+    omg[i] = (rs_sym_t)rs_poly_mul_coef(sigma, deg + 1, S, T, i);
+
+  for (int c = 0; c < count; c++) {
+    int pos = error_pos[c] - rs_S;
+    uint16_t xinv = rs_gf_exp[locator_log(pos, -1)];
+    uint16_t xinv2 = rs_gf_mul(xinv, xinv);
+
+    uint16_t num = rs_poly_eval(omg, T, xinv);
+    uint16_t den = 0; /* σ'(x) = Σ_{j odd} σ_j x^{j-1} */
+    for (int j = deg - (deg % 2 == 0); j >= 1; j -= 2)
+      den = rs_gf_mul(den, xinv2) ^ sigma[j];
+
+    if (den == 0)
+      return -1;
+    val[c] = rs_gf_mul(rs_gf_div(num, den),
+                       rs_gf_exp[locator_log(pos, 1 - rs_fcr)]);
   }
 
-  /* Output corrected shortened codeword */
-  for (int i = 0; i < Ns; i++)
-    symbol_to_bits(recv_sym_p[S + i], &code_bits[i * m], m);
+  if (verify_enabled && !errata_consistent(S, error_pos, val, count))
+    return RS_DECODE_MISCORRECTED;
 
-  /* Output K information symbols */
-  for (int i = 0; i < K; i++)
-    symbol_to_bits(recv_sym_p[S + i], &info_bits[i * m], m);
+  const rs_sym_t *dual = rs_conv_to_dual;
+  int bits = 0;
+  for (int c = 0; c < count; c++) {
+    rs_sym_t e = dual ? dual[val[c]] : val[c];
+    code_sym[error_pos[c] - rs_S] ^= e;
+    bits += __builtin_popcount(e);
+  }
+  ws->corr_bits = bits;
+  return count;
+}
+
+int rs_decode_sym_erasures(rs_sym_t *code_sym, const int *eras_pos,
+                           int n_eras) {
+  rs_workspace *ws = rs_workspace_default();
+  if (!ws)
+    return -1;
+  return rs_decode_sym_erasures_ws(ws, code_sym, eras_pos, n_eras);
+}
+
+/* -------------------------------------------------------------------------
+ * 9) Streaming decoding
+ *
+ * Arrived symbols [done, pos) are folded into ws->synd as the partial
+ * syndromes of their range (syndromes_range() into bm_tmp, which is free
+ * until the solver stage). Folding per batch rather than per push keeps
+ * the per-call cost (T shift products) off single-symbol pushes and gives
+ * rs_poly_eval_geom() ranges long enough for its vector kernels. After the
+ * last fold ws->synd holds exactly what compute_syndromes() returns.
+ * ------------------------------------------------------------------------- */
+static void stream_fold(rs_decode_stream *st) {
+  rs_sym_t *S = st->ws->synd;
+  rs_sym_t *part = st->ws->bm_tmp;
+
+  if (st->pos == st->done)
+    return;
+  syndromes_range(st->code_sym + st->done, st->done, st->pos, part);
+  for (int i = 0; i < rs_T; i++)
+    S[i] ^= part[i];
+  st->done = st->pos;
+}
+
+int rs_decode_stream_begin(rs_decode_stream *st, rs_workspace *ws,
+                           rs_sym_t *code_sym) {
+  int batch = rs_N / RS_DECODE_STREAM_DIV;
+  int lo = (rs_m > 8) ? RS_DECODE_STREAM_MIN_WIDE : RS_DECODE_STREAM_MIN;
+
+  st->ws = ws;
+  st->code_sym = code_sym;
+  st->pos = st->done = 0;
+  st->batch = (batch < lo)                     ? lo
+              : (batch > RS_DECODE_STREAM_MAX) ? RS_DECODE_STREAM_MAX
+                                               : batch;
+  if (rs_workspace_check(ws) != 0)
+    return -1;
+  memset(ws->synd, 0, (size_t)rs_T * sizeof(rs_sym_t));
+  return 0;
+}
+
+int rs_decode_stream_push(rs_decode_stream *st, int n) {
+  if (n < 0 || n > rs_N - st->pos || rs_workspace_check(st->ws) != 0)
+    return -1;
+  st->pos += n;
+  if (st->pos - st->done >= st->batch)
+    stream_fold(st);
+  return rs_N - st->pos;
+}
+
+int rs_decode_stream_finish(rs_decode_stream *st) {
+  rs_workspace *ws = st->ws;
+  int dirty = 0;
+
+  if (rs_workspace_check(ws) != 0)
+    return -1;
+  if (st->pos != rs_N)
+    return RS_DECODE_INCOMPLETE;
+  stream_fold(st);
+  if (rs_trace_active)
+    rs_trace_write_sym(rs_trace_active, st->code_sym, NULL, 0, 0);
+  ws->corr_bits = 0;
+  for (int i = 0; i < rs_T; i++)
+    dirty |= (ws->synd[i] != 0);
+  if (!dirty)
+    return 0;
+  return rs_decode_correct_ws(ws, st->code_sym, ws->synd);
 }
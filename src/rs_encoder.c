@@ -17,7 +17,11 @@
  *   Parity computation is implemented using the classical shift-register
  *   architecture:
  *       parity ← (parity << 1) ⊕ feedback * g(x)
- *   where g(x) is the generator polynomial.
+ *   where g(x) is the generator polynomial. Each step is one
+ *   rs_poly_scale_add_log() over the logarithms of g(x) (rs_generator_log),
+ *   the register division of rs_poly_divmod(). Wide fields (m > 8) add
+ *   split rows of g(x) instead (rs_generator_split): four row reads per
+ *   step, no exp-table lookups.
  *
  * Shortened RS codes:
  *   When shortening is used, S = Np - N dummy symbols are shifted through
@@ -26,97 +30,246 @@
 
 #include "rs_encoder.h"
 #include "rs_gf.h"
+#include "rs_pack.h"
+#include "rs_poly.h"
 #include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 /* -------------------------------------------------------------------------
  * Helpers: Conversion between bit arrays and GF symbols
  * ------------------------------------------------------------------------- */
 
 /**
- * @brief Convert m bits → GF symbol (uint16_t).
+ * @brief Convert m bits → GF symbol (uint16_t), bits[0] = LSB or MSB.
  */
-static uint16_t bits_to_symbol(const int *bits, int m) {
+static uint16_t bits_to_symbol(const int *bits, int m, int msb_first) {
   uint16_t v = 0;
-  for (int i = 0; i < m; i++)
-    v |= (bits[i] & 1) << i;
+  if (msb_first)
+    for (int i = 0; i < m; i++)
+      v = (uint16_t)(v << 1 | (bits[i] & 1));
+  else
+    for (int i = 0; i < m; i++)
+      v |= (bits[i] & 1) << i;
   return v;
 }
 
 /**
- * @brief Convert GF symbol → m bits.
+ * @brief Convert GF symbol → m bits, bits[0] = LSB or MSB.
  *
- * Uses precomputed rs_symbol_bits[] for speed.
+ * Uses precomputed rs_symbol_bits[] for speed, read backwards for MSB-first
+ * (shifts in the compact profile, which has no bit table).
  */
-static void symbol_to_bits(uint16_t sym, int *bits, int m) {
+static void symbol_to_bits(uint16_t sym, int *bits, int m, int msb_first) {
   for (int b = 0; b < m; b++)
-    bits[b] = rs_symbol_bits[sym][b];
+#ifdef RS_COMPACT
+    bits[b] = (sym >> (msb_first ? m - 1 - b : b)) & 1;
+#else
+    bits[b] = rs_symbol_bits[sym][msb_first ? m - 1 - b : b];
+#endif
 }
 
 /* -------------------------------------------------------------------------
  * Systematic RS encoding
  * ------------------------------------------------------------------------- */
 
+#if RS_M_MAX > 8
+/* Register symbols per inner step of split_step() (one 128-bit vector) */
+#define SPLIT_LANES 8
+
+/* next[j] = cur[j + 1] + r0[j] + r1[j] + r2[j] + r3[j], j < n (n a
+ * multiple of SPLIT_LANES; the fixed inner loop lets the compiler
+ * vectorize without alias checks) */
+static void split_step(rs_sym_t *restrict next, const rs_sym_t *restrict cur,
+                       const rs_sym_t *restrict r0,
+                       const rs_sym_t *restrict r1,
+                       const rs_sym_t *restrict r2,
+                       const rs_sym_t *restrict r3, int n) {
+  for (int j = 0; j < n; j += SPLIT_LANES)
+    for (int l = 0; l < SPLIT_LANES; l++)
+      next[j + l] =
+          cur[j + l + 1] ^ r0[j + l] ^ r1[j + l] ^ r2[j + l] ^ r3[j + l];
+}
+
 /**
- * @brief Systematic Reed–Solomon encoder.
+ * @brief Register steps of a wide field (m > 8) on the split rows of g(x).
  *
- * Produces a codeword of:
- *      [K info symbols][T parity symbols]
- *
- * @param inf_bits  Input bit array (K * m bits).
- * @param code_bits Output bit array ((K + T) * m bits).
+ * fb·g is the sum of the rows of fb's nibbles (rs_generator_split), so a
+ * step reads four rows instead of making T lookups in the 2^m-entry exp
+ * table. Nibbles above m read the zero row of nibble 0. The register
+ * alternates between two zero-padded copies (the padding stays zero since
+ * the rows are zero past T).
  */
-void rs_encode(const int *inf_bits, int *code_bits) {
-  int m = rs_m;
+static void encode_split(const rs_sym_t *info_sym, rs_sym_t *parity) {
   int K = rs_K;
   int T = rs_T;
-  int S = rs_S;
+  int stride = RS_GEN_SPLIT_STRIDE(T);
+  const rs_sym_t *split = rs_generator_split;
+  rs_sym_t reg[2][RS_GEN_SPLIT_T_MAX + SPLIT_LANES] = {{0}};
+  int cur = 0;
 
-  /* -------------------------------------------------------------
-   * Convert K information symbols from bits → GF symbols
-   * ------------------------------------------------------------- */
-  uint16_t u[K];
-  for (int i = 0; i < K; i++)
-    u[i] = bits_to_symbol(&inf_bits[i * m], m);
+  for (int i = 0; i < K; i++) {
+    unsigned fb = info_sym[i] ^ reg[cur][0];
+    const rs_sym_t *r0 = split + (size_t)(fb & 15) * stride;
+    const rs_sym_t *r1 = split + (size_t)(16 + ((fb >> 4) & 15)) * stride;
+    const rs_sym_t *r2 = split + (size_t)(32 + ((fb >> 8) & 15)) * stride;
+    const rs_sym_t *r3 =
+        (rs_m > 12) ? split + (size_t)(48 + (fb >> 12)) * stride : split;
+    split_step(reg[cur ^ 1], reg[cur], r0, r1, r2, r3, stride);
+    cur ^= 1;
+  }
+  memcpy(parity, reg[cur], (size_t)T * sizeof(rs_sym_t));
+}
+#endif
+
+/**
+ * @brief Parity of K information symbols: the register division of
+ *        u(x)·x^T by g(x).
+ *
+ * @param info_sym Input symbols (K entries).
+ * @param parity   Output symbols (T entries), not overlapping info_sym.
+ */
+void rs_encode_parity(const rs_sym_t *info_sym, rs_sym_t *parity) {
+  int K = rs_K;
+  int T = rs_T;
 
   /* -------------------------------------------------------------
    * Initialize T parity registers to zero
    * ------------------------------------------------------------- */
-  uint16_t parity[T];
   for (int i = 0; i < T; i++)
     parity[i] = 0;
 
   /* -------------------------------------------------------------
    * Handle shortening:
-   *   Shift S dummy symbols (all zeros) through the encoder.
-   *
-   * This produces the same result as encoding an N-symbol RS code
-   * and then shortening it to length N.
+   *   The S leading parent symbols are zero. Shifting them through
+   *   the all-zero register leaves it zero, so encoding starts
+   *   directly with the information symbols; the result equals
+   *   encoding the Np-symbol parent word and dropping the padding.
    * ------------------------------------------------------------- */
-  for (int s = 0; s < S; s++) {
-    uint16_t fb = parity[0];
-    for (int j = 0; j < T - 1; j++)
-      parity[j] = rs_gf_add(parity[j + 1], rs_gf_mul(fb, rs_generator[j + 1]));
-    parity[T - 1] = rs_gf_mul(fb, rs_generator[T]);
+
+#if RS_M_MAX > 8
+  if (rs_generator_split) {
+    encode_split(info_sym, parity);
+    return;
   }
+#endif
 
   /* -------------------------------------------------------------
-   * Feed the actual K information symbols
+   * Feed the actual K information symbols (dual-basis symbols are
+   * converted as they enter the register)
    * ------------------------------------------------------------- */
+  const rs_sym_t *conv = rs_dual_to_conv;
+  const rs_sym_t *g_log = rs_generator_log;
   for (int i = 0; i < K; i++) {
-    uint16_t fb = rs_gf_add(u[i], parity[0]);
-    for (int j = 0; j < T - 1; j++)
-      parity[j] = rs_gf_add(parity[j + 1], rs_gf_mul(fb, rs_generator[j + 1]));
+    rs_sym_t u = conv ? conv[info_sym[i]] : info_sym[i];
+    uint16_t fb = rs_gf_add(u, parity[0]);
+    rs_poly_scale_add_log(parity, parity + 1, fb, g_log + 1, T - 1);
     parity[T - 1] = rs_gf_mul(fb, rs_generator[T]);
   }
 
+  /* Parity leaves in the symbol basis of the code */
+  if (rs_conv_to_dual)
+    for (int j = 0; j < T; j++)
+      parity[j] = rs_conv_to_dual[parity[j]];
+}
+
+/**
+ * @brief Systematic Reed–Solomon encoder on GF symbols.
+ *
+ * Produces a codeword of:
+ *      [K info symbols][T parity symbols]
+ *
+ * @param info_sym Input symbols (K entries).
+ * @param code_sym Output symbols (K + T entries).
+ */
+void rs_encode_sym(const rs_sym_t *info_sym, rs_sym_t *code_sym) {
+  if (code_sym != info_sym)
+    memcpy(code_sym, info_sym, (size_t)rs_K * sizeof(rs_sym_t));
+  rs_encode_parity(info_sym, &code_sym[rs_K]);
+}
+
+/**
+ * @brief Systematic Reed–Solomon encoder (explicit workspace).
+ *
+ * Produces a codeword of:
+ *      [K info symbols][T parity symbols]
+ *
+ * @param ws        Workspace sized for the current code.
+ * @param inf_bits  Input bit array (K * m bits).
+ * @param code_bits Output bit array ((K + T) * m bits).
+ *
+ * @return 0, or -1 if ws does not fit the current code.
+ */
+int rs_encode_ws(rs_workspace *ws, const int *inf_bits, int *code_bits) {
+  int m = rs_m;
+  int K = rs_K;
+  int T = rs_T;
+  int order;
+  rs_io_get_format(&order, NULL);
+  int msb = (order == RS_BIT_MSB_FIRST);
+
+  if (rs_workspace_check(ws) != 0)
+    return -1;
+
+  /* -------------------------------------------------------------
+   * Convert K information symbols from bits → GF symbols
+   * (the encoder fills the parity part of the same buffer in place)
+   * ------------------------------------------------------------- */
+  rs_sym_t *c = ws->sym;
+  for (int i = 0; i < K; i++)
+    c[i] = bits_to_symbol(&inf_bits[i * m], m, msb);
+
+  rs_encode_sym(c, c);
+
   /* -------------------------------------------------------------
    * Output systematic codeword:
    *     [ info symbols ][ parity symbols ]
    * Convert back to bits.
    * ------------------------------------------------------------- */
-  for (int i = 0; i < K; i++)
-    symbol_to_bits(u[i], &code_bits[i * m], m);
+  for (int i = 0; i < K + T; i++)
+    symbol_to_bits(c[i], &code_bits[i * m], m, msb);
+  return 0;
+}
 
-  for (int i = 0; i < T; i++)
-    symbol_to_bits(parity[i], &code_bits[(K + i) * m], m);
+/**
+ * @brief Systematic Reed–Solomon encoder (per-thread workspace).
+ */
+void rs_encode(const int *inf_bits, int *code_bits) {
+  rs_workspace *ws = rs_workspace_default();
+  if (!ws) {
+    fprintf(stderr, "ERROR: RS workspace allocation failed\n");
+    exit(1);
+  }
+  rs_encode_ws(ws, inf_bits, code_bits);
+}
+
+/**
+ * @brief Systematic Reed–Solomon encoder on packed buffers.
+ *
+ * @param ws        Workspace sized for the current code.
+ * @param info_pack Input  packed information symbols (K symbols).
+ * @param code_pack Output packed codeword (K + T symbols).
+ *
+ * @return 0, or -1 if ws does not fit the current code.
+ */
+int rs_encode_packed_ws(rs_workspace *ws, const uint8_t *info_pack,
+                        uint8_t *code_pack) {
+  if (rs_workspace_check(ws) != 0)
+    return -1;
+  rs_sym_t *c = ws->sym;
+
+  rs_unpack_symbols(info_pack, c, rs_K);
+  rs_encode_sym(c, c);
+  rs_pack_symbols(c, code_pack, rs_K + rs_T);
+  return 0;
+}
+
+void rs_encode_packed(const uint8_t *info_pack, uint8_t *code_pack) {
+  rs_workspace *ws = rs_workspace_default();
+  if (!ws) {
+    fprintf(stderr, "ERROR: RS workspace allocation failed\n");
+    exit(1);
+  }
+  rs_encode_packed_ws(ws, info_pack, code_pack);
 }
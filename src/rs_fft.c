@@ -0,0 +1,576 @@
+/**
+ * @file rs_fft.c
+ * @brief Additive-FFT (Lin–Chung–Han) encoder and decoder front end.
+ *
+ * Transform:
+ *   Basis v_i = 2^i of GF(2^m) over GF(2), subspaces V_k = span(v_0..v_k-1)
+ *   (the field elements 0..2^k - 1), subspace polynomials
+ *       W_k(x) = Π_{a ∈ V_k} (x - a),   Ŵ_k(x) = W_k(x) / W_k(v_k),
+ *   and novel basis X_i(x) = Π_k Ŵ_k(x)^{b_k} for i = Σ b_k 2^k.
+ *   For D(x) = D0(x) + Ŵ_j(x) D1(x) on a coset o + V_{j+1}, Ŵ_j is the
+ *   constant λ = Ŵ_j(o) on o + V_j and λ + 1 on o + v_j + V_j, so
+ *       D0 ← D0 + λ D1,   D1 ← D1 + D0
+ *   splits the evaluation into two half-size problems. k such layers
+ *   evaluate a polynomial of degree < n = 2^k at u = 0..n-1.
+ *
+ * Basis change:
+ *   Monomial → novel divides recursively by the sparse linearized Ŵ_j(x)
+ *   (j + 1 terms x^{2^i}); novel → monomial multiplies back in reverse.
+ *
+ * Products:
+ *   A Toeplitz product y_i = Σ_j a_j H[i + D - j] (i < C, j ≤ D) is cut into
+ *   tiles of bi outputs × bj inputs. Each tile is the middle of a linear
+ *   product of degree < n, computed pointwise on V_k. Kernel tiles are
+ *   transformed once per code; tiles sharing outputs are summed in the
+ *   evaluation domain and inverse-transformed once.
+ *
+ * Field multiplications use the exp/log tables of rs_gf.c; transformed
+ * kernels and butterfly constants are stored as logarithms (LOG_ZERO for 0).
+ *
+ * Roots: with β = α^{rs_root_step} and b = rs_fcr the syndromes are
+ * S_i = r(β^{b+i}) and an error at parent position p has locator X = β^p,
+ * so the Forney values carry the usual X^{1-b} factor.
+ */
+
+#include "rs_fft.h"
+#include "rs_decoder.h"
+#include "rs_workspace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LOG_ZERO ((unsigned)rs_Np) /* log "value" of 0 */
+
+/* -------------------------------------------------------------------------
+ * Product plans
+ * ------------------------------------------------------------------------- */
+typedef struct {
+  int C, D;      /* outputs i < C, inputs j ≤ D */
+  int k, n;      /* transform length n = 2^k */
+  int bi, bj;    /* tile size (outputs × inputs) */
+  int ti, tj;    /* tile counts */
+  rs_sym_t *pre;  /* [D + 1] log input scale, NULL = none */
+  rs_sym_t *post; /* [C]     log output scale, NULL = none */
+  rs_sym_t *kern; /* [ti * tj * n] log of transformed kernel tiles */
+} fft_plan;
+
+struct rs_fft {
+  rs_sym_t *skew;                     /* [2^m] log Ŵ_j(o), at o + 2^j - 1 */
+  rs_sym_t nov_div[RS_M_MAX][RS_M_MAX]; /* log W_j coeffs, [j][j] = W_j(v_j) */
+  rs_sym_t nov_mul[RS_M_MAX][RS_M_MAX]; /* log Ŵ_j coefficients */
+
+  fft_plan synd;   /* S_i = r(β^{b+i})             C = T,  D = N - 1 */
+  fft_plan chien;  /* σ(β^{-i}), i < Np            C = Np, D = t */
+  fft_plan omega;  /* Ω = S Γ mod x^T              C = T,  D = T - 1 */
+  fft_plan parity; /* Ω(X_r^{-1}), parity pos. X_r C = T,  D = T - 1 */
+
+  rs_sym_t *par_coef; /* [T] log X_r^{1-b} / Γ'(X_r^{-1}) */
+
+  rs_sym_t *buf;  /* [n_max] inverse transform accumulator */
+  rs_sym_t *fwd;  /* transformed input tiles (logs), plan_fwd_size() */
+  rs_sym_t *vals; /* [max(Np, T)] plan outputs */
+  rs_sym_t *omg;  /* [T] Ω(x) */
+
+  rs_workspace *ws; /* Berlekamp–Massey scratch, syndromes, σ(x) */
+};
+
+/* -------------------------------------------------------------------------
+ * Field helpers
+ * ------------------------------------------------------------------------- */
+static inline rs_sym_t exp_sum(unsigned e) {
+#ifdef RS_COMPACT
+  if (e >= (unsigned)rs_Np)
+    e -= rs_Np;
+#endif
+  return rs_gf_exp[e];
+}
+
+/* a · α^l (l < Np) */
+static inline rs_sym_t mul_log(rs_sym_t a, unsigned l) {
+  return a ? exp_sum(rs_gf_log[a] + l) : 0;
+}
+
+static inline unsigned log_of(rs_sym_t a) {
+  return a ? rs_gf_log[a] : LOG_ZERO;
+}
+
+/* (a · b) mod Np for exponents */
+static unsigned exp_mod(long long a, long long b) {
+  long long r = ((a % rs_Np) * (b % rs_Np)) % rs_Np;
+  return (unsigned)(r < 0 ? r + rs_Np : r);
+}
+
+/* -------------------------------------------------------------------------
+ * Transform and basis change
+ * ------------------------------------------------------------------------- */
+static void fft_forward(const rs_fft *f, rs_sym_t *a, int k) {
+  int n = 1 << k;
+  for (int j = k - 1; j >= 0; j--) {
+    int h = 1 << j;
+    for (int o = 0; o < n; o += 2 * h) {
+      unsigned lam = f->skew[o + h - 1];
+      rs_sym_t *lo = &a[o], *hi = &a[o + h];
+      if (lam != LOG_ZERO)
+        for (int i = 0; i < h; i++)
+          lo[i] ^= mul_log(hi[i], lam);
+      for (int i = 0; i < h; i++)
+        hi[i] ^= lo[i];
+    }
+  }
+}
+
+static void fft_inverse(const rs_fft *f, rs_sym_t *a, int k) {
+  int n = 1 << k;
+  for (int j = 0; j < k; j++) {
+    int h = 1 << j;
+    for (int o = 0; o < n; o += 2 * h) {
+      unsigned lam = f->skew[o + h - 1];
+      rs_sym_t *lo = &a[o], *hi = &a[o + h];
+      for (int i = 0; i < h; i++)
+        hi[i] ^= lo[i];
+      if (lam != LOG_ZERO)
+        for (int i = 0; i < h; i++)
+          lo[i] ^= mul_log(hi[i], lam);
+    }
+  }
+}
+
+/* Monomial → novel basis: split every block of 2^r by Ŵ_{r-1}(x) */
+static void to_novel(const rs_fft *f, rs_sym_t *a, int k) {
+  int n = 1 << k;
+  for (int r = k; r >= 2; r--) {
+    int h = 1 << (r - 1);
+    const rs_sym_t *c = f->nov_div[r - 1];
+    for (int b = 0; b < n; b += 2 * h)
+      for (int d = 2 * h - 1; d >= h; d--) {
+        rs_sym_t v = a[b + d];
+        if (!v)
+          continue;
+        unsigned lv = rs_gf_log[v];
+        for (int i = 0; i < r - 1; i++)
+          if (c[i] != LOG_ZERO)
+            a[b + d - h + (1 << i)] ^= exp_sum(lv + c[i]);
+        a[b + d] = exp_sum(lv + c[r - 1]);
+      }
+  }
+}
+
+/* Novel → monomial basis: exact reverse of to_novel() */
+static void from_novel(const rs_fft *f, rs_sym_t *a, int k) {
+  int n = 1 << k;
+  for (int r = 2; r <= k; r++) {
+    int h = 1 << (r - 1);
+    const rs_sym_t *c = f->nov_mul[r - 1];
+    for (int b = 0; b < n; b += 2 * h)
+      for (int d = h; d < 2 * h; d++) {
+        rs_sym_t v = a[b + d];
+        if (!v)
+          continue;
+        unsigned lv = rs_gf_log[v];
+        for (int i = 0; i < r - 1; i++)
+          if (c[i] != LOG_ZERO)
+            a[b + d - h + (1 << i)] ^= exp_sum(lv + c[i]);
+        a[b + d] = exp_sum(lv + c[r - 1]);
+      }
+  }
+}
+
+/*
+ * W_0(x) = x, W_{j+1}(x) = W_j(x) (W_j(x) + W_j(v_j)); with W_j(x) =
+ * Σ_i c_i x^{2^i} the recursion is c_i ← c_{i-1}^2 + W_j(v_j) c_i, and the
+ * values W_j(v_i) follow the same product.
+ */
+static void build_basis(rs_fft *f) {
+  int m = rs_m;
+  uint16_t c[RS_M_MAX + 1] = {1};
+  uint16_t wv[RS_M_MAX];
+  for (int i = 0; i < m; i++)
+    wv[i] = (uint16_t)(1u << i);
+
+  for (int j = 0; j < m; j++) {
+    uint16_t wj = wv[j];
+    unsigned lwj = rs_gf_log[wj];
+
+    /* Basis change tables: Ŵ_j = W_j / W_j(v_j), leading coefficient 1/wj */
+    for (int i = 0; i < j; i++) {
+      f->nov_div[j][i] = (rs_sym_t)log_of(c[i]);
+      f->nov_mul[j][i] = (rs_sym_t)(c[i] ? (rs_gf_log[c[i]] + rs_Np - lwj) %
+                                               rs_Np
+                                         : LOG_ZERO);
+    }
+    f->nov_div[j][j] = (rs_sym_t)lwj;
+    f->nov_mul[j][j] = (rs_sym_t)((rs_Np - lwj) % rs_Np);
+
+    /* Butterfly constants Ŵ_j(o), o a multiple of 2^{j+1} */
+    for (int o = 0; o < (1 << m); o += 2 << j) {
+      uint16_t v = 0;
+      for (int i = j + 1; i < m; i++)
+        if (o & (1 << i))
+          v ^= rs_gf_div(wv[i], wj);
+      f->skew[o + (1 << j) - 1] = (rs_sym_t)log_of(v);
+    }
+
+    /* W_{j+1} */
+    for (int i = j + 1; i >= 1; i--)
+      c[i] = rs_gf_mul(c[i - 1], c[i - 1]) ^ rs_gf_mul(wj, c[i]);
+    c[0] = rs_gf_mul(wj, c[0]);
+    for (int i = 0; i < m; i++)
+      wv[i] = rs_gf_mul(wv[i], wv[i] ^ wj);
+  }
+}
+
+/* -------------------------------------------------------------------------
+ * Toeplitz product plans
+ * ------------------------------------------------------------------------- */
+
+/* Pick the transform length with the lowest estimated cost */
+static void plan_geometry(fft_plan *p) {
+  double best = -1.0;
+  for (int k = 1; k <= rs_m; k++) {
+    int n = 1 << k;
+    int bi = (p->C < n / 2) ? p->C : n / 2;
+    int bj = (n + 1 - bi) / 2;
+    if (bj > p->D + 1)
+      bj = p->D + 1;
+    if (bi < 1 || bj < 1)
+      continue;
+
+    int ti = (p->C + bi - 1) / bi;
+    int tj = (p->D + bj) / bj;
+    double cost = (double)(ti + tj) * n * k * k + (double)ti * tj * n;
+    if (best < 0.0 || cost < best) {
+      best = cost;
+      p->k = k;
+      p->n = n;
+      p->bi = bi;
+      p->bj = bj;
+      p->ti = ti;
+      p->tj = tj;
+    }
+  }
+}
+
+/* Allocate a plan and transform its kernel H[0 .. C + D - 1] */
+static int plan_build(rs_fft *f, fft_plan *p, int C, int D,
+                      const rs_sym_t *H, int scaled) {
+  memset(p, 0, sizeof(*p));
+  p->C = C;
+  p->D = D;
+  plan_geometry(p);
+
+  int n = p->n;
+  p->kern = (rs_sym_t *)malloc((size_t)p->ti * p->tj * n * sizeof(rs_sym_t));
+  if (scaled) {
+    p->pre = (rs_sym_t *)malloc((size_t)(D + 1) * sizeof(rs_sym_t));
+    p->post = (rs_sym_t *)malloc((size_t)C * sizeof(rs_sym_t));
+  }
+  if (!p->kern || (scaled && (!p->pre || !p->post)))
+    return -1;
+
+  rs_sym_t *buf = f->buf;
+  for (int ti = 0; ti < p->ti; ti++)
+    for (int tj = 0; tj < p->tj; tj++) {
+      /* Kernel slice of the tile: H[i0 + D - (j0 + bj - 1) + s] */
+      long base = (long)ti * p->bi + D - ((long)tj * p->bj + p->bj - 1);
+      memset(buf, 0, (size_t)n * sizeof(rs_sym_t));
+      for (int s = 0; s < p->bi + p->bj - 1; s++) {
+        long idx = base + s;
+        if (idx >= 0 && idx < (long)C + D)
+          buf[s] = H[idx];
+      }
+      to_novel(f, buf, p->k);
+      fft_forward(f, buf, p->k);
+
+      rs_sym_t *kern = &p->kern[((size_t)ti * p->tj + tj) * n];
+      for (int u = 0; u < n; u++)
+        kern[u] = (rs_sym_t)log_of(buf[u]);
+    }
+  return 0;
+}
+
+/* Chirp plan for y_i = post_i Σ_j pre_j a_j z^{ij}, z = α^{ez}:
+ * pre_j = α^{pl·j} w^{j^2}, post_i = α^{q0 + ql·i} w^{i^2}, H_d = w^{-d^2} */
+static int plan_chirp(rs_fft *f, fft_plan *p, int C, int D, unsigned ez,
+                      unsigned pl, unsigned ql, unsigned q0) {
+  unsigned ew = exp_mod(ez, (rs_Np + 1) / 2); /* w = z^{1/2} */
+
+  rs_sym_t *H = (rs_sym_t *)malloc((size_t)(C + D) * sizeof(rs_sym_t));
+  if (!H)
+    return -1;
+  for (int idx = 0; idx < C + D; idx++) {
+    long long d = idx - D;
+    H[idx] = rs_gf_exp[(rs_Np - exp_mod(ew, exp_mod(d, d))) % rs_Np];
+  }
+  int ret = plan_build(f, p, C, D, H, 1);
+  free(H);
+  if (ret != 0)
+    return ret;
+
+  for (int j = 0; j <= D; j++)
+    p->pre[j] = (rs_sym_t)((exp_mod(pl, j) + exp_mod(ew, (long long)j * j)) %
+                           rs_Np);
+  for (int i = 0; i < C; i++)
+    p->post[i] = (rs_sym_t)((q0 + exp_mod(ql, i) +
+                             exp_mod(ew, (long long)i * i)) %
+                            rs_Np);
+  return 0;
+}
+
+static void plan_free(fft_plan *p) {
+  free(p->kern);
+  free(p->pre);
+  free(p->post);
+}
+
+/* Input tiles kept in transformed form: all of them when several output
+ * tiles reuse them, otherwise one at a time */
+static size_t plan_fwd_size(const fft_plan *p) {
+  return (size_t)(p->ti > 1 ? p->tj : 1) * p->n;
+}
+
+/* acc += F · kernel tile (F and kernel as logs) */
+static void tile_accumulate(rs_sym_t *acc, const rs_sym_t *F,
+                            const rs_sym_t *Kt, int n) {
+  for (int u = 0; u < n; u++)
+    if (F[u] != LOG_ZERO && Kt[u] != LOG_ZERO)
+      acc[u] ^= exp_sum((unsigned)F[u] + Kt[u]);
+}
+
+/* y[0 .. C-1] for the input a[0 .. na-1], na ≤ D + 1 */
+static void plan_apply(rs_fft *f, const fft_plan *p, const rs_sym_t *a,
+                       int na, rs_sym_t *y) {
+  int n = p->n, k = p->k;
+  int keep = (p->ti > 1);
+  rs_sym_t *acc = f->buf;
+
+  /* Forward transforms of the input tiles (stored as logs); with a single
+   * output tile they are folded into the accumulator right away */
+  memset(acc, 0, (size_t)n * sizeof(rs_sym_t));
+  int tj_used = 0;
+  for (int tj = 0; tj < p->tj; tj++) {
+    int j0 = tj * p->bj;
+    if (j0 >= na)
+      break;
+    int len = (na - j0 < p->bj) ? na - j0 : p->bj;
+
+    rs_sym_t *F = &f->fwd[keep ? (size_t)tj * n : 0];
+    memset(F, 0, (size_t)n * sizeof(rs_sym_t));
+    for (int jj = 0; jj < len; jj++)
+      F[jj] = p->pre ? mul_log(a[j0 + jj], p->pre[j0 + jj]) : a[j0 + jj];
+    to_novel(f, F, k);
+    fft_forward(f, F, k);
+    for (int u = 0; u < n; u++)
+      F[u] = (rs_sym_t)log_of(F[u]);
+    if (!keep)
+      tile_accumulate(acc, F, &p->kern[(size_t)tj * n], n);
+    tj_used++;
+  }
+
+  /* Per output tile: pointwise products summed over input tiles */
+  for (int ti = 0; ti < p->ti; ti++) {
+    if (keep) {
+      memset(acc, 0, (size_t)n * sizeof(rs_sym_t));
+      for (int tj = 0; tj < tj_used; tj++)
+        tile_accumulate(acc, &f->fwd[(size_t)tj * n],
+                        &p->kern[((size_t)ti * p->tj + tj) * n], n);
+    }
+    fft_inverse(f, acc, k);
+    from_novel(f, acc, k);
+
+    int i0 = ti * p->bi;
+    for (int ii = 0; ii < p->bi && i0 + ii < p->C; ii++) {
+      rs_sym_t v = acc[p->bj - 1 + ii];
+      y[i0 + ii] = p->post ? mul_log(v, p->post[i0 + ii]) : v;
+    }
+  }
+}
+
+/* -------------------------------------------------------------------------
+ * Object lifetime
+ * ------------------------------------------------------------------------- */
+void rs_fft_destroy(rs_fft *f) {
+  if (!f)
+    return;
+  plan_free(&f->synd);
+  plan_free(&f->chien);
+  plan_free(&f->omega);
+  plan_free(&f->parity);
+  free(f->skew);
+  free(f->par_coef);
+  free(f->buf);
+  free(f->fwd);
+  free(f->vals);
+  free(f->omg);
+  rs_workspace_destroy(f->ws);
+  free(f);
+}
+
+rs_fft *rs_fft_create(void) {
+  int Np = rs_Np, N = rs_N, T = rs_T, t = rs_T / 2;
+  int st = rs_root_step, b = rs_fcr;
+  size_t max_n = (size_t)1 << rs_m;
+
+  if (rs_dual_to_conv) {
+    fprintf(stderr, "ERROR: rs_fft does not support dual-basis symbols\n");
+    return NULL;
+  }
+
+  rs_fft *f = (rs_fft *)calloc(1, sizeof(rs_fft));
+  if (!f)
+    return NULL;
+
+  f->skew = (rs_sym_t *)malloc(max_n * sizeof(rs_sym_t));
+  f->buf = (rs_sym_t *)malloc(max_n * sizeof(rs_sym_t));
+  f->vals = (rs_sym_t *)malloc((size_t)(Np > T ? Np : T) * sizeof(rs_sym_t));
+  f->omg = (rs_sym_t *)malloc((size_t)T * sizeof(rs_sym_t));
+  f->par_coef = (rs_sym_t *)malloc((size_t)T * sizeof(rs_sym_t));
+  rs_sym_t *gam = (rs_sym_t *)calloc((size_t)T + 1, sizeof(rs_sym_t));
+  f->ws = rs_workspace_create();
+  if (!f->skew || !f->buf || !f->vals || !f->omg || !f->par_coef || !gam ||
+      !f->ws)
+    goto fail;
+
+  build_basis(f);
+
+  /* Erasure locator of the parity positions Np - T + r, r < T:
+   * Γ(x) = Π (1 - X_r x), X_r = β^{Np - T + r}, built once in O(T^2) */
+  gam[0] = 1;
+  for (int r = 0; r < T; r++) {
+    uint16_t X = rs_gf_exp[exp_mod(st, Np - T + r)];
+    for (int j = r + 1; j >= 1; j--)
+      gam[j] ^= rs_gf_mul(gam[j - 1], X);
+  }
+
+  /* Syndromes: S_i = β^{(b+i)S} Σ_n (r_n β^{bn}) β^{in} */
+  if (plan_chirp(f, &f->synd, T, N - 1, (unsigned)st, exp_mod(st, b),
+                 exp_mod(st, rs_S), exp_mod(exp_mod(st, b), rs_S)) != 0)
+    goto fail;
+  /* Chien: σ(β^{-i}) for every parent position */
+  if (plan_chirp(f, &f->chien, Np, t, exp_mod(-st, 1), 0, 0, 0) != 0)
+    goto fail;
+  /* Parity evaluation: Ω(X_r^{-1}) = Σ_j (Ω_j β^{Tj}) β^{-rj} */
+  if (plan_chirp(f, &f->parity, T, T - 1, exp_mod(-st, 1), exp_mod(st, T),
+                 0, 0) != 0)
+    goto fail;
+  /* Ω = S Γ mod x^T: kernel H[D + d] = Γ_d */
+  {
+    rs_sym_t *H = (rs_sym_t *)calloc(2 * (size_t)T, sizeof(rs_sym_t));
+    if (!H)
+      goto fail;
+    memcpy(&H[T - 1], gam, (size_t)T * sizeof(rs_sym_t));
+    int ret = plan_build(f, &f->omega, T, T - 1, H, 0);
+    free(H);
+    if (ret != 0)
+      goto fail;
+  }
+
+  size_t fwd_size = plan_fwd_size(&f->synd);
+  const fft_plan *plans[] = {&f->chien, &f->omega, &f->parity};
+  for (int i = 0; i < 3; i++)
+    if (plan_fwd_size(plans[i]) > fwd_size)
+      fwd_size = plan_fwd_size(plans[i]);
+  f->fwd = (rs_sym_t *)malloc(fwd_size * sizeof(rs_sym_t));
+  if (!f->fwd)
+    goto fail;
+
+  /* Forney factor of the parity positions: X_r^{1-b} / Γ'(X_r^{-1}),
+   * Γ'(x) = Σ_{j even} Γ_{j+1} x^j */
+  for (int j = 0; j < T; j++)
+    f->omg[j] = (j % 2 == 0) ? gam[j + 1] : 0;
+  plan_apply(f, &f->parity, f->omg, T, f->vals);
+  for (int r = 0; r < T; r++)
+    f->par_coef[r] = (rs_sym_t)((exp_mod((long long)st * (1 - b), Np - T + r) +
+                                 Np - rs_gf_log[f->vals[r]]) %
+                                Np);
+
+  free(gam);
+  return f;
+
+fail:
+  free(gam);
+  rs_fft_destroy(f);
+  return NULL;
+}
+
+/* -------------------------------------------------------------------------
+ * Encoder
+ * ------------------------------------------------------------------------- */
+void rs_fft_encode_sym(rs_fft *f, const rs_sym_t *info_sym,
+                       rs_sym_t *code_sym) {
+  int K = rs_K, T = rs_T;
+  rs_sym_t *synd = f->ws->synd;
+
+  if (code_sym != info_sym)
+    memcpy(code_sym, info_sym, (size_t)K * sizeof(rs_sym_t));
+
+  /* Syndromes of [info | 0], then parity = erasure values cancelling them */
+  plan_apply(f, &f->synd, code_sym, K, synd);
+  plan_apply(f, &f->omega, synd, T, f->omg);
+  plan_apply(f, &f->parity, f->omg, T, f->vals);
+
+  for (int r = 0; r < T; r++)
+    code_sym[K + r] = mul_log(f->vals[r], f->par_coef[r]);
+}
+
+/* -------------------------------------------------------------------------
+ * Decoder
+ * ------------------------------------------------------------------------- */
+int rs_fft_syndromes(rs_fft *f, const rs_sym_t *code_sym, rs_sym_t *synd) {
+  int dirty = 0;
+  plan_apply(f, &f->synd, code_sym, rs_N, synd);
+  for (int i = 0; i < rs_T; i++)
+    dirty |= (synd[i] != 0);
+  return dirty;
+}
+
+int rs_fft_decode_sym(rs_fft *f, rs_sym_t *code_sym) {
+  int T = rs_T, t = rs_T / 2, Np = rs_Np;
+  long long st = rs_root_step, b = rs_fcr;
+  rs_sym_t *synd = f->ws->synd;
+  rs_sym_t *sigma = f->ws->sigma;
+  int *error_pos = f->ws->error_pos;
+
+  if (!rs_fft_syndromes(f, code_sym, synd))
+    return 0;
+
+  int L = rs_decode_locator_ws(f->ws, synd, sigma);
+  if (L > t)
+    return -1;
+
+  /* Chien search: all roots of σ(β^{-i}) in one product */
+  plan_apply(f, &f->chien, sigma, L + 1, f->vals);
+  int count = 0;
+  for (int i = 0; i < Np && count <= L; i++)
+    if (f->vals[i] == 0)
+      error_pos[count++] = i;
+  if (count != L)
+    return -1;
+
+  /* Forney: e = X^{1-b} Ω(X^{-1}) / σ'(X^{-1}), Ω = S σ mod x^T */
+  rs_sym_t *omg = f->omg;
+  for (int i = 0; i < T; i++) {
+    uint16_t v = 0;
+    for (int j = 0; j <= L && j <= i; j++)
+      v ^= rs_gf_mul(sigma[j], synd[i - j]);
+    omg[i] = (rs_sym_t)v;
+  }
+
+  for (int c = 0; c < count; c++) {
+    int pos = error_pos[c];
+    unsigned xinv = exp_mod(-st, pos);
+
+    uint16_t num = 0;
+    for (int i = T - 1; i >= 0; i--)
+      num = mul_log(num, xinv) ^ omg[i];
+    uint16_t den = 0; /* σ'(x) = Σ_{j odd} σ_j x^{j-1} */
+    for (int j = L - (L % 2 == 0); j >= 1; j -= 2)
+      den = mul_log(mul_log(den, xinv), xinv) ^ sigma[j];
+
+    if (pos >= rs_S && den != 0)
+      code_sym[pos - rs_S] ^=
+          mul_log(rs_gf_div(num, den), exp_mod(st * (1 - b), pos));
+  }
+
+  return count;
+}
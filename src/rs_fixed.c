@@ -0,0 +1,363 @@
+/**
+ * @file rs_fixed.c
+ * @brief Bounded-latency decoder with a data-independent schedule.
+ *
+ * Loop bounds depend on (N, T, Np) only. Where rs_decoder.c branches on
+ * data, this file selects with masks:
+ *
+ *   - mul_nb() / mul_log_nb() compute the table product unconditionally
+ *     and AND it with an all-ones / all-zero mask for the zero operand;
+ *   - the Berlekamp–Massey register swap is a masked blend of the old
+ *     locator and the shifted correction polynomial;
+ *   - Chien roots are written to the next free slot at every position and
+ *     the slot index advances by the comparison result;
+ *   - Forney results and the write-back index are masked to 0 for empty
+ *     slots, positions in the shortened zone and failed words.
+ *
+ * The inversionless Berlekamp–Massey form (λ ← γλ + δ x b) avoids the
+ * per-iteration division of rs_decoder.c; its locator is a non-zero
+ * multiple of σ(x), which changes neither the roots nor the Forney ratio.
+ *
+ * As in the rs_poly.h kernels, operands that are reused are turned into
+ * logarithms once (RS_POLY_LOG_ZERO marks a zero), so the inner loops do
+ * one exp lookup per product: the received symbols before the syndromes,
+ * which then take SYND_LANES roots per pass over them; the syndromes, γ
+ * and δ in Berlekamp–Massey. The register update only runs over the
+ * coefficients that can be non-zero after r iterations (r + 1), a bound
+ * that depends on the iteration, not on the word.
+ *
+ * Wide fields (m > 8) on CPUs with vector rs_gf16 kernels run both O(N·T)
+ * stages on them instead, as rs_decoder.c does: syndromes by lane-wise
+ * Horner, Chien by geometric blocks, with zero terms masked rather than
+ * skipped. Those kernels use no field table at all, so their timing does
+ * not even depend on table addresses; the choice depends on the field and
+ * the CPU only.
+ *
+ * Scratch lives in the rs_workspace: symbol logs in sym, λ in bm_C, b(x)
+ * in bm_B, syndrome logs, then Chien term logs, then Ω(x) in bm_tmp,
+ * Chien log steps in sigma.
+ */
+
+#include "rs_fixed.h"
+#include "rs_gf.h"
+#if RS_M_MAX > 8
+#include "rs_gf16.h"
+#endif
+#include "rs_poly.h"
+
+#include <string.h>
+
+/* -------------------------------------------------------------------------
+ * Branch-free field helpers
+ * ------------------------------------------------------------------------- */
+
+/* All ones if c, else 0 (c ∈ {0, 1}) */
+static inline rs_sym_t mask_of(int c) { return (rs_sym_t) - (rs_sym_t)c; }
+
+/* α^e for e < 2 Np (reduced for the compact single-period exp table) */
+static inline rs_sym_t exp_nb(unsigned e) {
+#ifdef RS_COMPACT
+  e -= (unsigned)rs_Np & -(unsigned)(e >= (unsigned)rs_Np);
+#endif
+  return rs_gf_exp[e];
+}
+
+static inline rs_sym_t mul_nb(rs_sym_t a, rs_sym_t b) {
+  return exp_nb((unsigned)rs_gf_log[a] + rs_gf_log[b]) &
+         mask_of((a != 0) & (b != 0));
+}
+
+/* a · α^l, l < Np */
+static inline rs_sym_t mul_log_nb(rs_sym_t a, unsigned l) {
+  return exp_nb(rs_gf_log[a] + l) & mask_of(a != 0);
+}
+
+/* log a, or RS_POLY_LOG_ZERO for a = 0 */
+static inline rs_sym_t log_nb(rs_sym_t a) {
+  rs_sym_t z = mask_of(a == 0);
+  return (rs_sym_t)((rs_gf_log[a] & ~z) | (RS_POLY_LOG_ZERO & z));
+}
+
+/* a · b for b given as log_nb(b) */
+static inline rs_sym_t mul_lz_nb(rs_sym_t a, rs_sym_t lb) {
+  return exp_nb((unsigned)rs_gf_log[a] + lb) &
+         mask_of((a != 0) & (lb != RS_POLY_LOG_ZERO));
+}
+
+/* x mod Np for x < 2 Np */
+static inline unsigned reduce_nb(unsigned x) {
+  return x - ((unsigned)rs_Np & -(unsigned)(x >= (unsigned)rs_Np));
+}
+
+/* -------------------------------------------------------------------------
+ * Stages
+ * ------------------------------------------------------------------------- */
+
+/* Roots per pass over the symbol logs */
+#define SYND_LANES 8
+
+/* S_i = Σ r_n α^{e_i (S + n)} */
+static void syndromes(rs_workspace *ws, const rs_sym_t *recv_sym,
+                      rs_sym_t *S) {
+  const rs_sym_t *conv = rs_dual_to_conv;
+  rs_sym_t *lr = ws->sym;
+  int T = rs_T, N = rs_N;
+
+  for (int n = 0; n < N; n++)
+    lr[n] = log_nb(conv ? conv[recv_sym[n]] : recv_sym[n]);
+
+  /* Lanes past T repeat root i0 and are not stored */
+  for (int i0 = 0; i0 < T; i0 += SYND_LANES) {
+    unsigned e[SYND_LANES], k[SYND_LANES];
+    rs_sym_t sum[SYND_LANES];
+    for (int l = 0; l < SYND_LANES; l++) {
+      e[l] = (unsigned)rs_gf_root_log(i0 + l < T ? i0 + l : i0);
+      k[l] = (unsigned)(((long long)e[l] * rs_S) % rs_Np);
+      sum[l] = 0;
+    }
+
+    for (int n = 0; n < N; n++) {
+      unsigned lg = lr[n];
+      rs_sym_t mk = mask_of(lg != RS_POLY_LOG_ZERO);
+      for (int l = 0; l < SYND_LANES; l++) {
+        sum[l] ^= exp_nb(lg + k[l]) & mk;
+        k[l] = reduce_nb(k[l] + e[l]);
+      }
+    }
+    for (int l = 0; l < SYND_LANES && i0 + l < T; l++)
+      S[i0 + l] = sum[l];
+  }
+}
+
+/* Inversionless Berlekamp–Massey, T iterations; λ[0..T], returns L */
+static int locator(rs_workspace *ws, const rs_sym_t *S, rs_sym_t *lam) {
+  int T = rs_T;
+  rs_sym_t *b = ws->bm_B;
+  rs_sym_t *ls = ws->bm_tmp;
+
+  for (int i = 0; i < T; i++)
+    ls[i] = log_nb(S[i]);
+  memset(lam, 0, (size_t)(T + 1) * sizeof(rs_sym_t));
+  memset(b, 0, (size_t)(T + 1) * sizeof(rs_sym_t));
+  lam[0] = 1;
+  b[0] = 1;
+  rs_sym_t gamma = 1;
+  int L = 0;
+
+  for (int r = 0; r < T; r++) {
+    rs_sym_t delta = 0;
+    for (int i = 0; i <= r; i++)
+      delta ^= mul_lz_nb(lam[i], ls[r - i]);
+
+    /* λ ← γλ + δ x b; b ← λ (update) or x b (no update). γ is never 0.
+     * Both have degree ≤ r before the update, ≤ r + 1 after it. */
+    int upd = (delta != 0) & (2 * L <= r);
+    rs_sym_t mk = mask_of(upd);
+    unsigned lgam = rs_gf_log[gamma];
+    rs_sym_t ldel = log_nb(delta);
+    for (int i = (r + 1 < T) ? r + 1 : T; i >= 1; i--) {
+      rs_sym_t old = lam[i], bs = b[i - 1];
+      lam[i] = mul_log_nb(old, lgam) ^ mul_lz_nb(bs, ldel);
+      b[i] = (rs_sym_t)((old & mk) | (bs & ~mk));
+    }
+    rs_sym_t old0 = lam[0];
+    lam[0] = mul_log_nb(old0, lgam);
+    b[0] = old0 & mk;
+
+    gamma = (rs_sym_t)((delta & mk) | (gamma & ~mk));
+    L += upd * (r + 1 - 2 * L);
+  }
+  return L;
+}
+
+/* Roots of λ(β^{-i}) over all parent positions; returns the root count
+ * (slots beyond t + 1 are not stored) */
+static int chien(rs_workspace *ws, const rs_sym_t *lam, int *error_pos) {
+  int t = rs_T / 2, Np = rs_Np;
+  rs_sym_t *lg = ws->bm_tmp; /* log of λ_j β^{-ij} */
+  rs_sym_t *stp = ws->sigma; /* log β^{-j} */
+
+  memset(error_pos, 0, (size_t)(t + 1) * sizeof(int));
+  for (int j = 0; j <= t; j++) {
+    lg[j] = rs_gf_log[lam[j]];
+    int s = (int)(((long long)rs_root_step * j) % Np);
+    stp[j] = (rs_sym_t)(s ? Np - s : 0);
+  }
+
+  int count = 0;
+  for (int i = 0; i < Np; i++) {
+    rs_sym_t sum = 0;
+    for (int j = 0; j <= t; j++) {
+      sum ^= rs_gf_exp[lg[j]] & mask_of(lam[j] != 0);
+      lg[j] = (rs_sym_t)reduce_nb((unsigned)lg[j] + stp[j]);
+    }
+    error_pos[count - (count > t)] = i;
+    count += (sum == 0);
+  }
+  return count;
+}
+
+#if RS_M_MAX > 8
+/* -------------------------------------------------------------------------
+ * Wide-field stages on the vector rs_gf16 kernels
+ * ------------------------------------------------------------------------- */
+
+/* Chien positions per pass over the terms */
+#define CHIEN_WIDE 1024
+
+/* S_i = α^{e_i S} Σ_l acc_l α^{e_i l}, acc from Horner by α^{e_i·LANES} */
+static void syndromes_wide(rs_workspace *ws, const rs_sym_t *recv_sym,
+                           rs_sym_t *S) {
+  const rs_sym_t *conv = rs_dual_to_conv;
+  int N = rs_N, Np = rs_Np;
+  int nb = N / RS_GF16_LANES, rem = N % RS_GF16_LANES;
+  uint16_t acc[RS_GF16_LANES];
+  rs_gf16_const k;
+
+  if (conv) {
+    for (int n = 0; n < N; n++)
+      ws->sym[n] = conv[recv_sym[n]];
+    recv_sym = ws->sym;
+  }
+
+  for (int i = 0; i < rs_T; i++) {
+    unsigned e = (unsigned)rs_gf_root_log(i);
+    for (int l = 0; l < RS_GF16_LANES; l++)
+      acc[l] = (l < rem) ? recv_sym[nb * RS_GF16_LANES + l] : 0;
+    rs_gf16_const_init(
+        &k, rs_gf_exp[(unsigned long long)e * RS_GF16_LANES % Np]);
+    rs_gf16_horner(&k, recv_sym, (size_t)nb, acc);
+
+    unsigned x = (unsigned)((long long)e * rs_S % Np);
+    rs_sym_t sum = 0;
+    for (int l = 0; l < RS_GF16_LANES; l++) {
+      sum ^= mul_log_nb(acc[l], x);
+      x = reduce_nb(x + e);
+    }
+    S[i] = sum;
+  }
+}
+
+/* chien() over CHIEN_WIDE positions per pass: each term's values at
+ * RS_GF16_LANES consecutive positions, advanced by β^{-j·LANES} per block */
+static int chien_wide(rs_workspace *ws, const rs_sym_t *lam, int *error_pos) {
+  int t = rs_T / 2, Np = rs_Np;
+  rs_sym_t *lg = ws->bm_tmp; /* log of λ_j β^{-i0·j} at block start i0 */
+  rs_sym_t *stp = ws->sigma; /* log β^{-j} */
+  uint16_t val[CHIEN_WIDE], v[RS_GF16_LANES];
+  rs_gf16_const k;
+
+  memset(error_pos, 0, (size_t)(t + 1) * sizeof(int));
+  for (int j = 0; j <= t; j++) {
+    lg[j] = rs_gf_log[lam[j]];
+    int s = (int)(((long long)rs_root_step * j) % Np);
+    stp[j] = (rs_sym_t)(s ? Np - s : 0);
+  }
+
+  int count = 0;
+  for (int i0 = 0; i0 < Np; i0 += CHIEN_WIDE) {
+    int len = (Np - i0 < CHIEN_WIDE) ? Np - i0 : CHIEN_WIDE;
+    int nb = (len + RS_GF16_LANES - 1) / RS_GF16_LANES;
+    memset(val, 0, (size_t)nb * RS_GF16_LANES * sizeof(uint16_t));
+
+    for (int j = 0; j <= t; j++) {
+      rs_sym_t mk = mask_of(lam[j] != 0);
+      unsigned l = lg[j];
+      for (int q = 0; q < RS_GF16_LANES; q++) {
+        v[q] = rs_gf_exp[l] & mk;
+        l = reduce_nb(l + stp[j]);
+      }
+      rs_gf16_const_init(
+          &k, rs_gf_exp[(unsigned long long)stp[j] * RS_GF16_LANES % Np]);
+      rs_gf16_geom(&k, v, val, (size_t)nb);
+      lg[j] = (rs_sym_t)((lg[j] + (unsigned long long)stp[j] * CHIEN_WIDE) %
+                         Np);
+    }
+
+    for (int q = 0; q < len; q++) {
+      error_pos[count - (count > t)] = i0 + q;
+      count += (val[q] == 0);
+    }
+  }
+  return count;
+}
+#endif
+
+/* -------------------------------------------------------------------------
+ * Decoder
+ * ------------------------------------------------------------------------- */
+int rs_decode_sym_fixed_ws(rs_workspace *ws, rs_sym_t *code_sym) {
+  int T = rs_T, t = rs_T / 2, Np = rs_Np;
+
+  if (rs_workspace_check(ws) != 0)
+    return -1;
+  rs_sym_t *S = ws->synd;
+  rs_sym_t *lam = ws->bm_C;
+  int *error_pos = ws->error_pos;
+
+  int count, L;
+#if RS_M_MAX > 8
+  if (rs_gf16_vector()) {
+    syndromes_wide(ws, code_sym, S);
+    L = locator(ws, S, lam);
+    count = chien_wide(ws, lam, error_pos);
+  } else
+#endif
+  {
+    syndromes(ws, code_sym, S);
+    L = locator(ws, S, lam);
+    count = chien(ws, lam, error_pos);
+  }
+
+  /* Ω = S λ mod x^T (λ beyond t is irrelevant once L ≤ t is required) */
+  rs_sym_t *om = ws->bm_tmp;
+  for (int i = 0; i < T; i++) {
+    rs_sym_t v = 0;
+    for (int j = 0; j <= t && j <= i; j++)
+      v ^= mul_nb(lam[j], S[i - j]);
+    om[i] = v;
+  }
+
+  /* Forney for every slot: e = X^{1-b} Ω(X^{-1}) / λ'(X^{-1}), X = β^pos */
+  const rs_sym_t *dual = rs_conv_to_dual;
+  long long fx = ((long long)rs_root_step * (1 - rs_fcr)) % Np;
+  if (fx < 0)
+    fx += Np;
+  int ok = (L <= t) & (count == L);
+  int bits = 0;
+
+  for (int k = 0; k < t; k++) {
+    int pos = error_pos[k];
+    unsigned xi = (unsigned)((Np - ((long long)rs_root_step * pos) % Np) % Np);
+    unsigned x2 = reduce_nb(2 * xi);
+
+    rs_sym_t num = 0;
+    for (int i = T - 1; i >= 0; i--)
+      num = mul_log_nb(num, xi) ^ om[i];
+    rs_sym_t den = 0; /* λ'(x) = Σ_{j odd} λ_j x^{j-1} */
+    for (int j = t - (t % 2 == 0); j >= 1; j -= 2)
+      den = mul_log_nb(den, x2) ^ lam[j];
+
+    unsigned el = reduce_nb(rs_gf_log[num] + (unsigned)(Np - rs_gf_log[den]));
+    el = reduce_nb(el + (unsigned)((fx * pos) % Np));
+    int apply = ok & (k < count) & (pos >= rs_S) & (num != 0) & (den != 0);
+    rs_sym_t e = rs_gf_exp[el] & mask_of(apply);
+    if (dual)
+      e = dual[e];
+
+    code_sym[(pos - rs_S) & -apply] ^= e;
+    bits += __builtin_popcount(e);
+  }
+  ws->corr_bits = bits;
+
+  if (!ok)
+    return -1;
+  return count;
+}
+
+int rs_decode_sym_fixed(rs_sym_t *code_sym) {
+  rs_workspace *ws = rs_workspace_default();
+  if (!ws)
+    return -1;
+  return rs_decode_sym_fixed_ws(ws, code_sym);
+}
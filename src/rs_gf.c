@@ -4,7 +4,8 @@
  *
  * This module initializes the finite field GF(2^m), manages exponential/log
  * tables, provides basic operations (add/mul/div/inv/pow), and generates the
- * RS generator polynomial of degree T.
+ * RS generator polynomial of degree T. The field polynomial, the generator
+ * roots and the symbol basis (CCSDS dual basis) are selectable.
  *
  * Supported:
  *   - GF sizes up to RS_GF_MAX (configurable in rs_gf.h)
@@ -14,37 +15,82 @@
  */
 
 #include "rs_gf.h"
+#include "rs_poly.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 /* -------------------------------------------------------------------------
  * Global RS parameters (set by rs_gf_init)
  * ------------------------------------------------------------------------- */
 int rs_m = 0, rs_N = 0, rs_Np = 0, rs_S = 0, rs_K = 0, rs_T = 0;
+unsigned rs_code_gen = 0;
+uint32_t rs_poly = 0;
+int rs_fcr = 0, rs_prim = 0, rs_root_step = 1;
 
-/* Exponential/log tables for GF(2^m) */
-uint16_t rs_gf_exp[2 * RS_GF_MAX];
-uint16_t rs_gf_log[RS_GF_MAX];
-
-/* Generator polynomial coefficients g(x) (degree T) */
-uint16_t rs_generator[RS_GF_MAX];
-
-/* Lookup table: symbol (0..2^m-1) → per-bit representation */
-int rs_symbol_bits[RS_GF_MAX][RS_M_MAX];
-
-/* Primitive polynomials for m = 1..8 (CCSDS/NASA compatible) */
-static const uint16_t primitive_poly[9] = {
-    0x00, /* unused (m=0) */
-    0x03, /* m=1 */
-    0x07, /* m=2 */
-    0x0B, /* m=3 */
-    0x13, /* m=4 */
-    0x25, /* m=5 */
-    0x43, /* m=6 */
-    0x89, /* m=7 */
-    0x11D /* m=8 (used for RS(255,223), GF(256)) */
+/* Table storage filled by rs_gf_init() */
+static rs_sym_t gf_exp_tab[RS_GF_EXP_SIZE];
+static rs_sym_t gf_log_tab[RS_GF_MAX];
+static rs_sym_t generator_tab[RS_GF_MAX];
+static rs_sym_t generator_log_tab[RS_GF_MAX];
+#ifndef RS_COMPACT
+static int symbol_bits_tab[RS_GF_MAX][RS_M_MAX];
+#endif
+#if RS_M_MAX > 8
+static rs_sym_t generator_split_tab[64 * RS_GEN_SPLIT_T_MAX];
+#endif
+static rs_sym_t dual_to_conv_tab[RS_DUAL_SIZE];
+static rs_sym_t conv_to_dual_tab[RS_DUAL_SIZE];
+
+/* Active tables: the storage above, or a mapped table file (rs_table.h) */
+const rs_sym_t *rs_gf_exp = gf_exp_tab;
+const rs_sym_t *rs_gf_log = gf_log_tab;
+const rs_sym_t *rs_generator = generator_tab;
+const rs_sym_t *rs_generator_log = generator_log_tab;
+#ifndef RS_COMPACT
+const int (*rs_symbol_bits)[RS_M_MAX] = (const int(*)[RS_M_MAX])symbol_bits_tab;
+#endif
+#if RS_M_MAX > 8
+const rs_sym_t *rs_generator_split = NULL;
+#endif
+const rs_sym_t *rs_dual_to_conv = NULL;
+const rs_sym_t *rs_conv_to_dual = NULL;
+
+/* Primitive polynomials for m = 1..16 (CCSDS/NASA compatible) */
+static const uint32_t primitive_poly[17] = {
+    0x00,    /* unused (m=0) */
+    0x03,    /* m=1 */
+    0x07,    /* m=2 */
+    0x0B,    /* m=3 */
+    0x13,    /* m=4 */
+    0x25,    /* m=5 */
+    0x43,    /* m=6 */
+    0x89,    /* m=7 */
+    0x11D,   /* m=8 (used for RS(255,223), GF(256)) */
+    0x211,   /* m=9 */
+    0x409,   /* m=10 */
+    0x805,   /* m=11 */
+    0x1053,  /* m=12 */
+    0x201B,  /* m=13 */
+    0x4443,  /* m=14 */
+    0x8003,  /* m=15 */
+    0x1100B  /* m=16 */
 };
 
+/* CCSDS 131.0 dual-basis transform (Berlekamp): conventional bit k of a
+ * symbol contributes row ccsds_tal[7 - k] to its dual-basis image */
+static const uint8_t ccsds_tal[8] = {0x8d, 0xef, 0xec, 0x86,
+                                     0xfa, 0x99, 0xaf, 0x7b};
+
+static int gcd(int a, int b) {
+  while (b) {
+    int r = a % b;
+    a = b;
+    b = r;
+  }
+  return a;
+}
+
 /* -------------------------------------------------------------------------
  * Basic GF operations
  * ------------------------------------------------------------------------- */
@@ -81,7 +127,7 @@ uint16_t rs_gf_pow(uint16_t base, int power) {
   if (base == 0)
     return 0;
   int logv = rs_gf_log[base];
-  int x = (logv * power) % rs_Np;
+  int x = (int)(((long long)logv * power) % rs_Np);
   if (x < 0)
     x += rs_Np;
   return rs_gf_exp[x];
@@ -98,82 +144,204 @@ uint16_t rs_gf_inv(uint16_t a) {
  * Initialize GF(2^m) and build generator polynomial g(x)
  * ------------------------------------------------------------------------- */
 int rs_gf_init(int m, int N, int K, int T) {
-  rs_m = m;
-  rs_N = N;
-  rs_K = K;
-  rs_T = T;
+  return rs_gf_init_params(m, N, K, T, NULL);
+}
 
-  /* Field size (2^m - 1) */
-  rs_Np = (1 << m) - 1;
+int rs_gf_init_ccsds(int N, int K) {
+  rs_code_params p = {RS_CCSDS_POLY, RS_CCSDS_FCR, RS_CCSDS_PRIM, 1};
+  return rs_gf_init_params(8, N, K, N - K, &p);
+}
 
-  /* Number of shortened symbols */
-  rs_S = rs_Np - rs_N;
-  if (rs_S < 0) {
+int rs_gf_init_params(int m, int N, int K, int T, const rs_code_params *p) {
+  if (m < 1 || m > RS_M_MAX) {
+    fprintf(stderr, "ERROR: m must be in 1..%d\n", RS_M_MAX);
+    return -1;
+  }
+  if (K < 1 || T < 1 || N != K + T) {
+    fprintf(stderr, "ERROR: invalid code parameters (N = K + T required)\n");
+    return -1;
+  }
+  if (N > (1 << m) - 1) {
     fprintf(stderr, "ERROR: N exceeds field maximum (2^m - 1)\n");
     return -1;
   }
 
-  /* Select primitive polynomial */
-  uint16_t prim = primitive_poly[m];
+  int Np = (1 << m) - 1;
+  uint32_t poly = (p && p->poly) ? p->poly : primitive_poly[m];
+  int fcr = p ? p->fcr % Np : 0;
+  int prim = p ? p->prim % Np : Np - 1;
+  int dual = p ? p->dual_basis : 0;
+  if (fcr < 0)
+    fcr += Np;
+  if (prim < 0)
+    prim += Np;
+
+  if ((poly >> m) != 1) {
+    fprintf(stderr, "ERROR: field polynomial 0x%X is not of degree %d\n",
+            (unsigned)poly, m);
+    return -1;
+  }
+  if (Np > 1 && (prim == 0 || gcd(prim, Np) != 1)) {
+    fprintf(stderr, "ERROR: root spacing %d is not coprime to %d\n", prim,
+            Np);
+    return -1;
+  }
+  if (dual && (m != 8 || poly != RS_CCSDS_POLY)) {
+    fprintf(stderr, "ERROR: dual basis needs m = 8 and polynomial 0x%X\n",
+            RS_CCSDS_POLY);
+    return -1;
+  }
+
+  /* Generator roots and product-tree scratch (rs_poly.h) */
+  rs_sym_t *roots = (rs_sym_t *)malloc(
+      ((size_t)T + rs_poly_from_roots_scratch(T)) * sizeof(rs_sym_t));
+  if (!roots) {
+    fprintf(stderr, "ERROR: generator construction out of memory\n");
+    return -1;
+  }
+
+  /* α must generate the whole multiplicative group (checked before any
+   * table of the current code is overwritten) */
+  uint32_t x = 1;
+  for (int i = 1; i <= Np; i++) {
+    x <<= 1;
+    if (x & (1u << m))
+      x ^= poly;
+    if ((x == 1) != (i == Np)) {
+      fprintf(stderr, "ERROR: field polynomial 0x%X is not primitive\n",
+              (unsigned)poly);
+      free(roots);
+      return -1;
+    }
+  }
 
   /* Build exp/log tables */
-  uint16_t x = 1;
-  for (int i = 0; i < rs_Np; i++) {
-    rs_gf_exp[i] = x;
-    rs_gf_log[x] = i;
+  x = 1;
+  for (int i = 0; i < Np; i++) {
+    gf_exp_tab[i] = (rs_sym_t)x;
+    gf_log_tab[x] = (rs_sym_t)i;
 
     x <<= 1;
     if (x & (1u << m))
-      x ^= prim;
+      x ^= poly;
   }
 
-  /* Extend exp table for mod-free multiplication */
-  for (int i = rs_Np; i < 2 * rs_Np; i++)
-    rs_gf_exp[i] = rs_gf_exp[i - rs_Np];
+  rs_m = m;
+  rs_N = N;
+  rs_K = K;
+  rs_T = T;
 
-  rs_gf_log[0] = 0;
+  /* Field size (2^m - 1) */
+  rs_Np = Np;
 
-  /* ---------------------------------------------------------------------
-   * Generator polynomial construction (degree T)
-   * g(x) = (x - α^0)(x - α^1)...(x - α^(T-1))
-   * --------------------------------------------------------------------- */
-  for (int i = 0; i <= T; i++)
-    rs_generator[i] = 0;
-  rs_generator[0] = 1;
+  /* Number of shortened symbols */
+  rs_S = rs_Np - rs_N;
 
-  uint16_t tmp[RS_GF_MAX];
+  rs_poly = poly;
+  rs_fcr = fcr;
+  rs_prim = prim;
+  rs_root_step = (Np - prim) % (Np > 1 ? Np : 2);
 
-  for (int i = 0; i < T; i++) {
-    /* Copy existing coefficients */
-    for (int j = 0; j <= i; j++)
-      tmp[j] = rs_generator[j];
+  /* Extend exp table for mod-free multiplication (compact: α^Np only) */
+#ifdef RS_COMPACT
+  gf_exp_tab[rs_Np] = 1;
+#else
+  for (int i = rs_Np; i < 2 * rs_Np; i++)
+    gf_exp_tab[i] = gf_exp_tab[i - rs_Np];
+#endif
 
-    rs_generator[i + 1] = 0;
+  gf_log_tab[0] = 0;
 
-    /* Perform polynomial multiplication by (x - α^i) */
-    for (int j = i + 1; j >= 1; j--) {
-      uint16_t term = (j <= i) ? rs_gf_mul(tmp[j], rs_gf_exp[i]) : 0;
-      rs_generator[j] = rs_gf_add(tmp[j - 1], term);
-    }
-    rs_generator[0] = rs_gf_mul(tmp[0], rs_gf_exp[i]);
-  }
+  /* Switch back to the built-in storage if a table file was loaded */
+  rs_gf_exp = gf_exp_tab;
+  rs_gf_log = gf_log_tab;
+  rs_generator = generator_tab;
+  rs_generator_log = generator_log_tab;
+#ifndef RS_COMPACT
+  rs_symbol_bits = (const int(*)[RS_M_MAX])symbol_bits_tab;
+#endif
+
+  /* ---------------------------------------------------------------------
+   * Generator polynomial construction (degree T)
+   * g(x) = (x - α^{e_0})(x - α^{e_1})...(x - α^{e_(T-1)}),
+   * e_i = rs_root_step·(fcr + i), the internal (lowest degree first) roots,
+   * multiplied out by a product tree (Karatsuba for long codes)
+   * --------------------------------------------------------------------- */
+  for (int i = 0; i < T; i++)
+    roots[i] = rs_gf_exp[rs_gf_root_log(i)];
+  rs_poly_from_roots(roots, T, generator_tab, roots + T);
+  free(roots);
 
   /* Normalize g(x) so that g[0] = 1 */
-  uint16_t g0 = rs_generator[0];
+  uint16_t g0 = generator_tab[0];
   uint16_t inv_g0 = rs_gf_inv(g0);
   for (int j = 0; j <= T; j++)
-    rs_generator[j] = rs_gf_mul(rs_generator[j], inv_g0);
+    generator_tab[j] = rs_gf_mul(generator_tab[j], inv_g0);
+  rs_gf_generator_log_update();
 
+#ifndef RS_COMPACT
   /* ---------------------------------------------------------------------
    * Precompute symbol bit-representation table
    * --------------------------------------------------------------------- */
   int max_val = 1 << m;
   for (int val = 0; val < max_val; val++) {
     for (int b = 0; b < m; b++)
-      rs_symbol_bits[val][b] = (val >> b) & 1;
+      symbol_bits_tab[val][b] = (val >> b) & 1;
     for (int b = m; b < RS_M_MAX; b++)
-      rs_symbol_bits[val][b] = 0;
+      symbol_bits_tab[val][b] = 0;
+  }
+#endif
+
+  /* ---------------------------------------------------------------------
+   * Dual-basis conversion tables
+   * --------------------------------------------------------------------- */
+  rs_dual_to_conv = NULL;
+  rs_conv_to_dual = NULL;
+  if (dual) {
+    for (int v = 0; v < RS_DUAL_SIZE; v++) {
+      uint8_t d = 0;
+      for (int k = 0; k < 8; k++)
+        if ((v >> k) & 1)
+          d ^= ccsds_tal[7 - k];
+      conv_to_dual_tab[v] = d;
+      dual_to_conv_tab[d] = (rs_sym_t)v;
+    }
+    rs_dual_to_conv = dual_to_conv_tab;
+    rs_conv_to_dual = conv_to_dual_tab;
   }
 
+  rs_code_gen++;
   return 0;
 }
+
+/* Logarithms of the generator coefficients for the encoder register, and
+ * for wide fields its split rows (rows of nibble values a symbol of the
+ * field cannot take stay zero) */
+void rs_gf_generator_log_update(void) {
+  rs_generator_log = generator_log_tab;
+  rs_poly_log(rs_generator, generator_log_tab, rs_T + 1);
+
+#if RS_M_MAX > 8
+  rs_generator_split = NULL;
+  if (rs_m <= 8 || rs_T > RS_GEN_SPLIT_T_MAX)
+    return;
+  int stride = RS_GEN_SPLIT_STRIDE(rs_T);
+  memset(generator_split_tab, 0, 64 * (size_t)stride * sizeof(rs_sym_t));
+  for (int i = 0; 4 * i < rs_m; i++)
+    for (int v = 0; v < 16 && (v << 4 * i) <= rs_Np; v++) {
+      rs_sym_t *row = generator_split_tab + (size_t)(16 * i + v) * stride;
+      for (int j = 0; j < stride; j++)
+        row[j] = (j < rs_T) ? (rs_sym_t)rs_gf_mul((uint16_t)(v << 4 * i),
+                                                  rs_generator[j + 1])
+                            : 0;
+    }
+  rs_generator_split = generator_split_tab;
+#endif
+}
+
+/* Exponent e_i = step·(fcr + i) mod Np of the i-th internal root */
+int rs_gf_root_log(int i) {
+  if (rs_Np <= 1)
+    return 0;
+  return (int)((long long)rs_root_step * ((rs_fcr + i) % rs_Np) % rs_Np);
+}
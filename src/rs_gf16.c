@@ -0,0 +1,599 @@
+/**
+ * @file rs_gf16.c
+ * @brief Vector GF(2^16) multiplication kernels (split tables, carry-less
+ *        multiply) for the wide fields 8 < m ≤ 16.
+ *
+ * A constant's split tables are built from its images c·x^b, b < 16, by
+ * subset sums (no field-sized table is touched). The vector split kernels
+ * separate 16 symbols into a register of low bytes and one of high bytes,
+ * look up the four nibbles in both halves of the product (eight PSHUFB)
+ * and interleave the halves back. The carry-less kernel widens symbols to
+ * 32-bit lanes; each PCLMULQDQ then forms two products, and the Barrett
+ * quotient and its multiple of P take two more per pair.
+ *
+ * The choice between kernels is made by timing: at first use every kernel
+ * the CPU supports runs the same Horner pass (or element-wise product) on
+ * CALIB_SYMS symbols of the current field, and the fastest is kept.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "rs_gf16.h"
+#include "rs_gf.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RS_GF16_X86 1
+#include <immintrin.h>
+#endif
+
+#define LANES RS_GF16_LANES
+
+#define CALIB_SYMS 2048 /* symbols per timing run */
+#define CALIB_RUNS 5    /* timing runs per kernel (the fastest counts) */
+
+/* -------------------------------------------------------------------------
+ * Constants
+ * ------------------------------------------------------------------------- */
+
+/* ⌊x^2m / P⌋ for the Barrett reduction */
+static uint32_t barrett_mu(int m, uint32_t poly) {
+  uint64_t r = 1ull << (2 * m);
+  uint32_t q = 0;
+  for (int d = 2 * m; d >= m; d--)
+    if ((r >> d) & 1) {
+      r ^= (uint64_t)poly << (d - m);
+      q |= 1u << (d - m);
+    }
+  return q;
+}
+
+void rs_gf16_const_init(rs_gf16_const *k, uint16_t c) {
+  uint16_t basis[16];
+  uint32_t v = c;
+
+  /* c·x^b; bits at and above m never occur in symbols */
+  for (int b = 0; b < 16; b++) {
+    basis[b] = (uint16_t)v;
+    v <<= 1;
+    if (v & (1u << rs_m))
+      v ^= rs_poly;
+  }
+
+  /* c·(v << 4i) as subset sums of the four images of nibble i */
+  for (int i = 0; i < 4; i++) {
+    k->t[i][0] = 0;
+    for (int b = 0; b < 4; b++)
+      for (int x = 0; x < (1 << b); x++)
+        k->t[i][x | (1 << b)] = k->t[i][x] ^ basis[4 * i + b];
+    for (int x = 0; x < 16; x++) {
+      k->lo[i][x] = (uint8_t)k->t[i][x];
+      k->hi[i][x] = (uint8_t)(k->t[i][x] >> 8);
+    }
+  }
+
+  k->c = c;
+  k->log_c = c ? rs_gf_log[c] : 0;
+  k->mu = barrett_mu(rs_m, rs_poly);
+}
+
+/* -------------------------------------------------------------------------
+ * Portable kernels: log/exp tables and scalar split tables
+ * ------------------------------------------------------------------------- */
+static inline uint16_t split1(const rs_gf16_const *k, uint16_t x) {
+  return k->t[0][x & 15] ^ k->t[1][(x >> 4) & 15] ^ k->t[2][(x >> 8) & 15] ^
+         k->t[3][x >> 12];
+}
+
+static inline uint16_t table_mul(uint16_t a, uint16_t b) {
+  if (!a || !b)
+    return 0;
+  unsigned e = (unsigned)rs_gf_log[a] + rs_gf_log[b];
+  return rs_gf_exp[e >= (unsigned)rs_Np ? e - rs_Np : e];
+}
+
+static void mul_const_table(const rs_gf16_const *k, const uint16_t *a,
+                            uint16_t *dst, size_t n) {
+  unsigned lc = k->log_c, np = (unsigned)rs_Np;
+
+  if (!k->c) {
+    memset(dst, 0, n * sizeof(uint16_t));
+    return;
+  }
+  for (size_t i = 0; i < n; i++) {
+    uint16_t x = a[i];
+    unsigned e = lc + (x ? rs_gf_log[x] : 0);
+    dst[i] = x ? rs_gf_exp[e >= np ? e - np : e] : 0;
+  }
+}
+
+static void mul_const_split(const rs_gf16_const *k, const uint16_t *a,
+                            uint16_t *dst, size_t n) {
+  for (size_t i = 0; i < n; i++)
+    dst[i] = split1(k, a[i]);
+}
+
+static void mul_vec_table(const uint16_t *a, const uint16_t *b, uint16_t *c,
+                          size_t n) {
+  for (size_t i = 0; i < n; i++)
+    c[i] = table_mul(a[i], b[i]);
+}
+
+typedef void (*const_fn)(const rs_gf16_const *, const uint16_t *, uint16_t *,
+                         size_t);
+
+/* Horner and geometric blocks on any multiply-by-constant kernel */
+static void horner_with(const_fn mul, const rs_gf16_const *k,
+                        const uint16_t *a, size_t blocks, uint16_t *acc) {
+  for (size_t t = blocks; t-- > 0;) {
+    const uint16_t *blk = a + t * LANES;
+    mul(k, acc, acc, LANES);
+    for (int l = 0; l < LANES; l++)
+      acc[l] ^= blk[l];
+  }
+}
+
+static void geom_with(const_fn mul, const rs_gf16_const *k, uint16_t *v,
+                      uint16_t *out, size_t blocks) {
+  for (size_t t = 0; t < blocks; t++) {
+    uint16_t *blk = out + t * LANES;
+    for (int l = 0; l < LANES; l++)
+      blk[l] ^= v[l];
+    mul(k, v, v, LANES);
+  }
+}
+
+#ifdef RS_GF16_X86
+/* -------------------------------------------------------------------------
+ * PCLMULQDQ: four products per pass in 32-bit lanes, Barrett reduction
+ * ------------------------------------------------------------------------- */
+typedef struct {
+  __m128i mu, poly, m;
+} barrett128;
+
+__attribute__((target("pclmul,sse4.1"))) static void
+load_barrett(barrett128 *b, uint32_t mu) {
+  b->mu = _mm_cvtsi32_si128((int)mu);
+  b->poly = _mm_cvtsi32_si128((int)rs_poly);
+  b->m = _mm_cvtsi32_si128(rs_m);
+}
+
+/* p mod P for four products of degree ≤ 2m - 2 (one per 32-bit lane) */
+__attribute__((target("pclmul,sse4.1"))) static inline __m128i
+reduce128(__m128i p, const barrett128 *b) {
+  __m128i h = _mm_srl_epi32(p, b->m);
+  __m128i q = _mm_unpacklo_epi64(_mm_clmulepi64_si128(h, b->mu, 0x00),
+                                 _mm_clmulepi64_si128(h, b->mu, 0x01));
+  q = _mm_srl_epi32(q, b->m);
+  return _mm_xor_si128(
+      p, _mm_unpacklo_epi64(_mm_clmulepi64_si128(q, b->poly, 0x00),
+                            _mm_clmulepi64_si128(q, b->poly, 0x01)));
+}
+
+/* c·x for four symbols in 32-bit lanes: a_l c lands in lane l */
+__attribute__((target("pclmul,sse4.1"))) static inline __m128i
+clmul_const4(__m128i x, __m128i c, const barrett128 *b) {
+  return reduce128(_mm_unpacklo_epi64(_mm_clmulepi64_si128(x, c, 0x00),
+                                      _mm_clmulepi64_si128(x, c, 0x01)),
+                   b);
+}
+
+__attribute__((target("pclmul,sse4.1"))) static void
+mul_const_clmul(const rs_gf16_const *k, const uint16_t *a, uint16_t *dst,
+                size_t n) {
+  barrett128 b;
+  load_barrett(&b, k->mu);
+  __m128i c = _mm_cvtsi32_si128(k->c);
+  size_t i = 0;
+
+  for (; i + 8 <= n; i += 8) {
+    __m128i x = _mm_loadu_si128((const __m128i *)(a + i));
+    __m128i p0 = clmul_const4(_mm_cvtepu16_epi32(x), c, &b);
+    __m128i p1 = clmul_const4(_mm_cvtepu16_epi32(_mm_srli_si128(x, 8)), c, &b);
+    _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi32(p0, p1));
+  }
+  for (; i < n; i++)
+    dst[i] = split1(k, a[i]);
+}
+
+/* a_l b_l for four lane pairs: lanes 0 and 2 of each 64 × 64 product */
+__attribute__((target("pclmul,sse4.1"))) static inline __m128i
+clmul_vec4(__m128i x, __m128i y, const barrett128 *b) {
+  __m128i r0 = _mm_clmulepi64_si128(x, y, 0x00);
+  __m128i r1 = _mm_clmulepi64_si128(x, y, 0x11);
+  return reduce128(
+      _mm_unpacklo_epi64(_mm_shuffle_epi32(r0, _MM_SHUFFLE(3, 1, 2, 0)),
+                         _mm_shuffle_epi32(r1, _MM_SHUFFLE(3, 1, 2, 0))),
+      b);
+}
+
+__attribute__((target("pclmul,sse4.1"))) static void
+mul_vec_clmul(const uint16_t *a, const uint16_t *b, uint16_t *c, size_t n) {
+  barrett128 br;
+  load_barrett(&br, barrett_mu(rs_m, rs_poly));
+  size_t i = 0;
+
+  for (; i + 8 <= n; i += 8) {
+    __m128i x = _mm_loadu_si128((const __m128i *)(a + i));
+    __m128i y = _mm_loadu_si128((const __m128i *)(b + i));
+    __m128i p0 = clmul_vec4(_mm_cvtepu16_epi32(x), _mm_cvtepu16_epi32(y), &br);
+    __m128i p1 = clmul_vec4(_mm_cvtepu16_epi32(_mm_srli_si128(x, 8)),
+                            _mm_cvtepu16_epi32(_mm_srli_si128(y, 8)), &br);
+    _mm_storeu_si128((__m128i *)(c + i), _mm_packus_epi32(p0, p1));
+  }
+  for (; i < n; i++)
+    c[i] = table_mul(a[i], b[i]);
+}
+
+/* -------------------------------------------------------------------------
+ * SSSE3: split tables in PSHUFB operands, 16 symbols per pass
+ * ------------------------------------------------------------------------- */
+typedef struct {
+  __m128i lo[4], hi[4], nib, low8;
+} split128;
+
+__attribute__((target("ssse3"))) static void
+load_split128(split128 *s, const rs_gf16_const *k) {
+  for (int i = 0; i < 4; i++) {
+    s->lo[i] = _mm_loadu_si128((const __m128i *)k->lo[i]);
+    s->hi[i] = _mm_loadu_si128((const __m128i *)k->hi[i]);
+  }
+  s->nib = _mm_set1_epi8(0x0F);
+  s->low8 = _mm_set1_epi16(0x00FF);
+}
+
+/* Σ_i tab[i][nibble i] over the nibbles n0..n3 */
+__attribute__((target("ssse3"))) static inline __m128i
+lookup4_128(const __m128i *tab, __m128i n0, __m128i n1, __m128i n2,
+            __m128i n3) {
+  return _mm_xor_si128(
+      _mm_xor_si128(_mm_shuffle_epi8(tab[0], n0), _mm_shuffle_epi8(tab[1], n1)),
+      _mm_xor_si128(_mm_shuffle_epi8(tab[2], n2),
+                    _mm_shuffle_epi8(tab[3], n3)));
+}
+
+/* c·x for symbols 0..7 in x0 and 8..15 in x1 */
+__attribute__((target("ssse3"))) static inline void
+mul16(const split128 *s, __m128i *x0, __m128i *x1) {
+  __m128i lo = _mm_packus_epi16(_mm_and_si128(*x0, s->low8),
+                                _mm_and_si128(*x1, s->low8));
+  __m128i hi =
+      _mm_packus_epi16(_mm_srli_epi16(*x0, 8), _mm_srli_epi16(*x1, 8));
+  __m128i n0 = _mm_and_si128(lo, s->nib);
+  __m128i n1 = _mm_and_si128(_mm_srli_epi16(lo, 4), s->nib);
+  __m128i n2 = _mm_and_si128(hi, s->nib);
+  __m128i n3 = _mm_and_si128(_mm_srli_epi16(hi, 4), s->nib);
+  __m128i rl = lookup4_128(s->lo, n0, n1, n2, n3);
+  __m128i rh = lookup4_128(s->hi, n0, n1, n2, n3);
+  *x0 = _mm_unpacklo_epi8(rl, rh);
+  *x1 = _mm_unpackhi_epi8(rl, rh);
+}
+
+__attribute__((target("ssse3"))) static void
+mul_const_ssse3(const rs_gf16_const *k, const uint16_t *a, uint16_t *dst,
+                size_t n) {
+  split128 s;
+  load_split128(&s, k);
+  size_t i = 0;
+
+  for (; i + 16 <= n; i += 16) {
+    __m128i x0 = _mm_loadu_si128((const __m128i *)(a + i));
+    __m128i x1 = _mm_loadu_si128((const __m128i *)(a + i + 8));
+    mul16(&s, &x0, &x1);
+    _mm_storeu_si128((__m128i *)(dst + i), x0);
+    _mm_storeu_si128((__m128i *)(dst + i + 8), x1);
+  }
+  for (; i < n; i++)
+    dst[i] = split1(k, a[i]);
+}
+
+__attribute__((target("ssse3"))) static void
+horner_ssse3(const rs_gf16_const *k, const uint16_t *a, size_t blocks,
+             uint16_t *acc) {
+  split128 s;
+  load_split128(&s, k);
+  __m128i v[4];
+  for (int q = 0; q < 4; q++)
+    v[q] = _mm_loadu_si128((const __m128i *)(acc + 8 * q));
+
+  for (size_t t = blocks; t-- > 0;) {
+    const uint16_t *blk = a + t * LANES;
+    mul16(&s, &v[0], &v[1]);
+    mul16(&s, &v[2], &v[3]);
+    for (int q = 0; q < 4; q++)
+      v[q] = _mm_xor_si128(
+          v[q], _mm_loadu_si128((const __m128i *)(blk + 8 * q)));
+  }
+  for (int q = 0; q < 4; q++)
+    _mm_storeu_si128((__m128i *)(acc + 8 * q), v[q]);
+}
+
+__attribute__((target("ssse3"))) static void
+geom_ssse3(const rs_gf16_const *k, uint16_t *vec, uint16_t *out,
+           size_t blocks) {
+  split128 s;
+  load_split128(&s, k);
+  __m128i v[4];
+  for (int q = 0; q < 4; q++)
+    v[q] = _mm_loadu_si128((const __m128i *)(vec + 8 * q));
+
+  for (size_t t = 0; t < blocks; t++) {
+    __m128i *blk = (__m128i *)(out + t * LANES);
+    for (int q = 0; q < 4; q++)
+      _mm_storeu_si128(blk + q,
+                       _mm_xor_si128(_mm_loadu_si128(blk + q), v[q]));
+    mul16(&s, &v[0], &v[1]);
+    mul16(&s, &v[2], &v[3]);
+  }
+  for (int q = 0; q < 4; q++)
+    _mm_storeu_si128((__m128i *)(vec + 8 * q), v[q]);
+}
+
+/* -------------------------------------------------------------------------
+ * AVX2: the SSSE3 kernel on 32 symbols per pass (PACKUS and UNPACK work
+ * per 128-bit lane, so the interleave undoes the split)
+ * ------------------------------------------------------------------------- */
+typedef struct {
+  __m256i lo[4], hi[4], nib, low8;
+} split256;
+
+__attribute__((target("avx2"))) static void
+load_split256(split256 *s, const rs_gf16_const *k) {
+  for (int i = 0; i < 4; i++) {
+    s->lo[i] = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)k->lo[i]));
+    s->hi[i] = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)k->hi[i]));
+  }
+  s->nib = _mm256_set1_epi8(0x0F);
+  s->low8 = _mm256_set1_epi16(0x00FF);
+}
+
+__attribute__((target("avx2"))) static inline __m256i
+lookup4_256(const __m256i *tab, __m256i n0, __m256i n1, __m256i n2,
+            __m256i n3) {
+  return _mm256_xor_si256(_mm256_xor_si256(_mm256_shuffle_epi8(tab[0], n0),
+                                           _mm256_shuffle_epi8(tab[1], n1)),
+                          _mm256_xor_si256(_mm256_shuffle_epi8(tab[2], n2),
+                                           _mm256_shuffle_epi8(tab[3], n3)));
+}
+
+/* c·x for symbols 0..15 in x0 and 16..31 in x1 */
+__attribute__((target("avx2"))) static inline void
+mul32(const split256 *s, __m256i *x0, __m256i *x1) {
+  __m256i lo = _mm256_packus_epi16(_mm256_and_si256(*x0, s->low8),
+                                   _mm256_and_si256(*x1, s->low8));
+  __m256i hi = _mm256_packus_epi16(_mm256_srli_epi16(*x0, 8),
+                                   _mm256_srli_epi16(*x1, 8));
+  __m256i n0 = _mm256_and_si256(lo, s->nib);
+  __m256i n1 = _mm256_and_si256(_mm256_srli_epi16(lo, 4), s->nib);
+  __m256i n2 = _mm256_and_si256(hi, s->nib);
+  __m256i n3 = _mm256_and_si256(_mm256_srli_epi16(hi, 4), s->nib);
+  __m256i rl = lookup4_256(s->lo, n0, n1, n2, n3);
+  __m256i rh = lookup4_256(s->hi, n0, n1, n2, n3);
+  *x0 = _mm256_unpacklo_epi8(rl, rh);
+  *x1 = _mm256_unpackhi_epi8(rl, rh);
+}
+
+__attribute__((target("avx2"))) static void
+mul_const_avx2(const rs_gf16_const *k, const uint16_t *a, uint16_t *dst,
+               size_t n) {
+  split256 s;
+  load_split256(&s, k);
+  size_t i = 0;
+
+  for (; i + 32 <= n; i += 32) {
+    __m256i x0 = _mm256_loadu_si256((const __m256i *)(a + i));
+    __m256i x1 = _mm256_loadu_si256((const __m256i *)(a + i + 16));
+    mul32(&s, &x0, &x1);
+    _mm256_storeu_si256((__m256i *)(dst + i), x0);
+    _mm256_storeu_si256((__m256i *)(dst + i + 16), x1);
+  }
+  for (; i < n; i++)
+    dst[i] = split1(k, a[i]);
+}
+
+__attribute__((target("avx2"))) static void
+horner_avx2(const rs_gf16_const *k, const uint16_t *a, size_t blocks,
+            uint16_t *acc) {
+  split256 s;
+  load_split256(&s, k);
+  __m256i v0 = _mm256_loadu_si256((const __m256i *)acc);
+  __m256i v1 = _mm256_loadu_si256((const __m256i *)(acc + 16));
+
+  for (size_t t = blocks; t-- > 0;) {
+    const uint16_t *blk = a + t * LANES;
+    mul32(&s, &v0, &v1);
+    v0 = _mm256_xor_si256(v0, _mm256_loadu_si256((const __m256i *)blk));
+    v1 = _mm256_xor_si256(v1,
+                          _mm256_loadu_si256((const __m256i *)(blk + 16)));
+  }
+  _mm256_storeu_si256((__m256i *)acc, v0);
+  _mm256_storeu_si256((__m256i *)(acc + 16), v1);
+}
+
+__attribute__((target("avx2"))) static void
+geom_avx2(const rs_gf16_const *k, uint16_t *vec, uint16_t *out,
+          size_t blocks) {
+  split256 s;
+  load_split256(&s, k);
+  __m256i v0 = _mm256_loadu_si256((const __m256i *)vec);
+  __m256i v1 = _mm256_loadu_si256((const __m256i *)(vec + 16));
+
+  for (size_t t = 0; t < blocks; t++) {
+    __m256i *blk = (__m256i *)(out + t * LANES);
+    _mm256_storeu_si256(blk, _mm256_xor_si256(_mm256_loadu_si256(blk), v0));
+    _mm256_storeu_si256(blk + 1,
+                        _mm256_xor_si256(_mm256_loadu_si256(blk + 1), v1));
+    mul32(&s, &v0, &v1);
+  }
+  _mm256_storeu_si256((__m256i *)vec, v0);
+  _mm256_storeu_si256((__m256i *)(vec + 16), v1);
+}
+#endif /* RS_GF16_X86 */
+
+/* -------------------------------------------------------------------------
+ * Kernel selection
+ * ------------------------------------------------------------------------- */
+typedef struct {
+  const char *name;
+  int vector;
+  const_fn mul_const;
+  void (*horner)(const rs_gf16_const *, const uint16_t *, size_t,
+                 uint16_t *); /* NULL: horner_with(mul_const) */
+  void (*geom)(const rs_gf16_const *, uint16_t *, uint16_t *, size_t);
+  void (*mul_vec)(const uint16_t *, const uint16_t *, uint16_t *, size_t);
+} gf16_kernel;
+
+static const gf16_kernel kernels[] = {
+#ifdef RS_GF16_X86
+    {"avx2", 1, mul_const_avx2, horner_avx2, geom_avx2, NULL},
+    {"ssse3", 1, mul_const_ssse3, horner_ssse3, geom_ssse3, NULL},
+    {"clmul", 1, mul_const_clmul, NULL, NULL, mul_vec_clmul},
+#endif
+    {"split", 0, mul_const_split, NULL, NULL, NULL},
+    {"table", 0, mul_const_table, NULL, NULL, mul_vec_table},
+};
+
+#define N_KERNELS ((int)(sizeof(kernels) / sizeof(kernels[0])))
+
+static const gf16_kernel *active[2]; /* by rs_gf16_op */
+static pthread_once_t select_once = PTHREAD_ONCE_INIT;
+
+static int supported(const gf16_kernel *k, rs_gf16_op op) {
+  if (op == RS_GF16_MUL && !k->mul_vec)
+    return 0;
+#ifdef RS_GF16_X86
+  __builtin_cpu_init();
+  if (strcmp(k->name, "avx2") == 0)
+    return __builtin_cpu_supports("avx2");
+  if (strcmp(k->name, "ssse3") == 0)
+    return __builtin_cpu_supports("ssse3");
+  if (strcmp(k->name, "clmul") == 0)
+    return __builtin_cpu_supports("pclmul") &&
+           __builtin_cpu_supports("sse4.1");
+#endif
+  return 1;
+}
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void run_op(const gf16_kernel *k, rs_gf16_op op,
+                   const rs_gf16_const *c, uint16_t *a, uint16_t *b) {
+  if (op == RS_GF16_MUL) {
+    k->mul_vec(a, a, b, CALIB_SYMS);
+  } else if (k->horner) {
+    k->horner(c, a, CALIB_SYMS / LANES, b);
+  } else {
+    horner_with(k->mul_const, c, a, CALIB_SYMS / LANES, b);
+  }
+}
+
+/* Fastest supported kernel on a Horner pass / element-wise product */
+static const gf16_kernel *measure(rs_gf16_op op) {
+  static uint16_t a[CALIB_SYMS], b[CALIB_SYMS];
+  const gf16_kernel *best = NULL;
+  double best_t = 0;
+  uint16_t mask = (uint16_t)rs_Np;
+  uint32_t x = 1;
+  rs_gf16_const c;
+
+  /* No field yet: order of preference */
+  if (rs_m <= 0) {
+    for (int i = 0; i < N_KERNELS && !best; i++)
+      if (supported(&kernels[i], op))
+        best = &kernels[i];
+    return best;
+  }
+
+  for (int i = 0; i < CALIB_SYMS; i++) {
+    x = x * 1103515245u + 12345u;
+    a[i] = (uint16_t)(x >> 16) & mask;
+  }
+  rs_gf16_const_init(&c, (uint16_t)(a[0] | 2) & mask);
+
+  for (int i = 0; i < N_KERNELS; i++) {
+    if (!supported(&kernels[i], op))
+      continue;
+    double t_min = 0;
+    for (int r = 0; r < CALIB_RUNS; r++) {
+      memcpy(b, a, sizeof(b));
+      double t0 = now_sec();
+      run_op(&kernels[i], op, &c, a, b);
+      double t = now_sec() - t0;
+      if (r == 0 || t < t_min)
+        t_min = t;
+    }
+    if (!best || t_min < best_t) {
+      best = &kernels[i];
+      best_t = t_min;
+    }
+  }
+  return best;
+}
+
+static void select_default(void) {
+  active[RS_GF16_CONST] = measure(RS_GF16_CONST);
+  active[RS_GF16_MUL] = measure(RS_GF16_MUL);
+}
+
+static const gf16_kernel *kernel(rs_gf16_op op) {
+  pthread_once(&select_once, select_default);
+  return active[op];
+}
+
+const char *rs_gf16_kernel(rs_gf16_op op) { return kernel(op)->name; }
+
+int rs_gf16_vector(void) { return kernel(RS_GF16_CONST)->vector; }
+
+int rs_gf16_set_kernel(rs_gf16_op op, const char *name) {
+  pthread_once(&select_once, select_default);
+  if (!name) {
+    active[op] = measure(op);
+    return 0;
+  }
+  for (int i = 0; i < N_KERNELS; i++)
+    if (strcmp(kernels[i].name, name) == 0 && supported(&kernels[i], op)) {
+      active[op] = &kernels[i];
+      return 0;
+    }
+  return -1;
+}
+
+/* -------------------------------------------------------------------------
+ * Operations
+ * ------------------------------------------------------------------------- */
+void rs_gf16_mul_const(const rs_gf16_const *k, const uint16_t *a,
+                       uint16_t *dst, size_t n) {
+  kernel(RS_GF16_CONST)->mul_const(k, a, dst, n);
+}
+
+void rs_gf16_horner(const rs_gf16_const *k, const uint16_t *a,
+                    size_t blocks, uint16_t *acc) {
+  const gf16_kernel *kk = kernel(RS_GF16_CONST);
+  if (kk->horner)
+    kk->horner(k, a, blocks, acc);
+  else
+    horner_with(kk->mul_const, k, a, blocks, acc);
+}
+
+void rs_gf16_geom(const rs_gf16_const *k, uint16_t *v, uint16_t *out,
+                  size_t blocks) {
+  const gf16_kernel *kk = kernel(RS_GF16_CONST);
+  if (kk->geom)
+    kk->geom(k, v, out, blocks);
+  else
+    geom_with(kk->mul_const, k, v, out, blocks);
+}
+
+void rs_gf16_mul_vec(const uint16_t *a, const uint16_t *b, uint16_t *c,
+                     size_t n) {
+  kernel(RS_GF16_MUL)->mul_vec(a, b, c, n);
+}
@@ -0,0 +1,153 @@
+/**
+ * @file rs_pack.c
+ * @brief Packed byte buffers ↔ GF(2^m) symbols.
+ *
+ * Byte-aligned layouts (m = 8, m = 16, RS_PACK_ALIGNED) are plain per-byte
+ * loops the compiler vectorises; other field sizes stream through a 32-bit
+ * bit accumulator, little-endian for LSB-first and big-endian for
+ * MSB-first streams, so every input/output byte is touched exactly once.
+ */
+
+#include "rs_pack.h"
+
+static int io_bit_order = RS_BIT_LSB_FIRST;
+static int io_packing = RS_PACK_DENSE;
+
+int rs_io_set_format(int bit_order, int packing) {
+  if ((bit_order != RS_BIT_LSB_FIRST && bit_order != RS_BIT_MSB_FIRST) ||
+      (packing != RS_PACK_DENSE && packing != RS_PACK_ALIGNED))
+    return -1;
+  io_bit_order = bit_order;
+  io_packing = packing;
+  return 0;
+}
+
+void rs_io_get_format(int *bit_order, int *packing) {
+  if (bit_order)
+    *bit_order = io_bit_order;
+  if (packing)
+    *packing = io_packing;
+}
+
+/* Bytes per symbol when every symbol starts on a byte boundary, 0 if the
+ * layout is a dense stream across byte boundaries */
+static int width_for(int m, int packing) {
+  if (packing == RS_PACK_ALIGNED || m == 16)
+    return (m + 7) / 8;
+  return m == 8 ? 1 : 0;
+}
+
+static int aligned_width(void) { return width_for(rs_m, io_packing); }
+
+size_t rs_packed_bytes_for(int m, int packing, int n_sym) {
+  int w = width_for(m, packing);
+  if (w)
+    return (size_t)n_sym * w;
+  return ((size_t)n_sym * m + 7) / 8;
+}
+
+size_t rs_packed_bytes(int n_sym) {
+  return rs_packed_bytes_for(rs_m, io_packing, n_sym);
+}
+
+/* -------------------------------------------------------------------------
+ * Unpack
+ * ------------------------------------------------------------------------- */
+void rs_unpack_symbols(const uint8_t *in, rs_sym_t *sym, int n_sym) {
+  int m = rs_m;
+  uint32_t mask = (1u << m) - 1;
+  int w = aligned_width();
+
+  if (w == 1) {
+    for (int i = 0; i < n_sym; i++)
+      sym[i] = (rs_sym_t)(in[i] & mask);
+    return;
+  }
+  if (w == 2) {
+    if (io_bit_order == RS_BIT_MSB_FIRST)
+      for (int i = 0; i < n_sym; i++)
+        sym[i] = (rs_sym_t)(((uint32_t)in[2 * i] << 8 | in[2 * i + 1]) & mask);
+    else
+      for (int i = 0; i < n_sym; i++)
+        sym[i] = (rs_sym_t)((in[2 * i] | (uint32_t)in[2 * i + 1] << 8) & mask);
+    return;
+  }
+
+  uint32_t acc = 0;
+  int n_bits = 0;
+
+  if (io_bit_order == RS_BIT_MSB_FIRST) {
+    for (int i = 0; i < n_sym; i++) {
+      while (n_bits < m) {
+        acc = acc << 8 | *in++;
+        n_bits += 8;
+      }
+      n_bits -= m;
+      sym[i] = (rs_sym_t)((acc >> n_bits) & mask);
+    }
+    return;
+  }
+
+  for (int i = 0; i < n_sym; i++) {
+    while (n_bits < m) {
+      acc |= (uint32_t)(*in++) << n_bits;
+      n_bits += 8;
+    }
+    sym[i] = (rs_sym_t)(acc & mask);
+    acc >>= m;
+    n_bits -= m;
+  }
+}
+
+/* -------------------------------------------------------------------------
+ * Pack
+ * ------------------------------------------------------------------------- */
+void rs_pack_symbols(const rs_sym_t *sym, uint8_t *out, int n_sym) {
+  int m = rs_m;
+  int w = aligned_width();
+
+  if (w == 1) {
+    for (int i = 0; i < n_sym; i++)
+      out[i] = (uint8_t)sym[i];
+    return;
+  }
+  if (w == 2) {
+    int hi = (io_bit_order == RS_BIT_MSB_FIRST) ? 0 : 1;
+    for (int i = 0; i < n_sym; i++) {
+      out[2 * i + hi] = (uint8_t)(sym[i] >> 8);
+      out[2 * i + 1 - hi] = (uint8_t)sym[i];
+    }
+    return;
+  }
+
+  uint32_t acc = 0;
+  int n_bits = 0;
+
+  if (io_bit_order == RS_BIT_MSB_FIRST) {
+    /* Only the low n_bits of acc are live; older bits shift out */
+    for (int i = 0; i < n_sym; i++) {
+      acc = acc << m | sym[i];
+      n_bits += m;
+      while (n_bits >= 8) {
+        n_bits -= 8;
+        *out++ = (uint8_t)(acc >> n_bits);
+      }
+    }
+    if (n_bits > 0)
+      *out = (uint8_t)(acc << (8 - n_bits));
+    return;
+  }
+
+  for (int i = 0; i < n_sym; i++) {
+    acc |= (uint32_t)sym[i] << n_bits;
+    n_bits += m;
+    while (n_bits >= 8) {
+      *out++ = (uint8_t)acc;
+      acc >>= 8;
+      n_bits -= 8;
+    }
+  }
+
+  if (n_bits > 0)
+    *out = (uint8_t)acc;
+}
@@ -0,0 +1,346 @@
+/**
+ * @file rs_pipeline.c
+ * @brief Stage-pipelined Reed–Solomon stream decoder.
+ *
+ * Threads and queues:
+ *
+ *   feeder (caller) ──in_q[s]──► syndrome worker s
+ *   syndrome worker s ──mid_q[s][v]──► solver worker v
+ *
+ * Every queue is a bounded single-producer/single-consumer ring of frame
+ * indices. Per-frame state (syndromes, status, completion sequence) lives
+ * in a ring of `window` slots indexed by frame & (window - 1); a slot is
+ * reused only after the feeder has retired its previous frame, so the
+ * window bounds both memory and the number of frames in flight.
+ *
+ * Completion is published with a release store of (frame + 1) into the
+ * slot's sequence word; the feeder retires frames strictly in order with
+ * acquire loads, which gives in-order completion without locks.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "rs_pipeline.h"
+#include "rs_decoder.h"
+#include "rs_gf.h"
+#include "rs_workspace.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RS_CACHE_LINE 64
+
+/* -------------------------------------------------------------------------
+ * Bounded SPSC ring of frame indices
+ * ------------------------------------------------------------------------- */
+typedef struct {
+  _Alignas(RS_CACHE_LINE) atomic_size_t head; /* next slot to pop (consumer) */
+  _Alignas(RS_CACHE_LINE) atomic_size_t tail; /* next slot to push (producer) */
+  _Alignas(RS_CACHE_LINE) size_t *buf;
+  size_t mask;
+} spsc_queue;
+
+static int spsc_init(spsc_queue *q, size_t capacity) {
+  atomic_init(&q->head, 0);
+  atomic_init(&q->tail, 0);
+  q->mask = capacity - 1;
+  q->buf = (size_t *)malloc(capacity * sizeof(size_t));
+  return q->buf ? 0 : -1;
+}
+
+static int spsc_push(spsc_queue *q, size_t v) {
+  size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+  size_t head = atomic_load_explicit(&q->head, memory_order_acquire);
+  if (tail - head > q->mask)
+    return 0; /* full */
+  q->buf[tail & q->mask] = v;
+  atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+  return 1;
+}
+
+static int spsc_pop(spsc_queue *q, size_t *v) {
+  size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+  size_t tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+  if (head == tail)
+    return 0; /* empty */
+  *v = q->buf[head & q->mask];
+  atomic_store_explicit(&q->head, head + 1, memory_order_release);
+  return 1;
+}
+
+/* -------------------------------------------------------------------------
+ * Pipeline object
+ * ------------------------------------------------------------------------- */
+typedef struct {
+  rs_pipeline *p;
+  int id;
+} worker_arg;
+
+struct rs_pipeline {
+  int n_synd;
+  int n_solve;
+  size_t window; /* power of two */
+  size_t mask;
+
+  spsc_queue *in_q;  /* [n_synd]           feeder → syndrome */
+  spsc_queue *mid_q; /* [n_synd * n_solve] syndrome → solver */
+
+  rs_sym_t *synd;          /* [window * T] per-slot syndromes */
+  int *slot_status;        /* [window] decoder status */
+  atomic_size_t *done_seq; /* [window] frame + 1 once completed */
+
+  rs_workspace **ws; /* [n_solve] solver scratch memory */
+
+  pthread_t *tid;   /* [n_synd + n_solve] worker threads */
+  worker_arg *args; /* [n_synd + n_solve] their arguments */
+
+  /* Per-call state */
+  rs_sym_t *frames;
+  atomic_int stop;
+};
+
+static void complete(rs_pipeline *p, size_t f, int status) {
+  size_t slot = f & p->mask;
+  p->slot_status[slot] = status;
+  atomic_store_explicit(&p->done_seq[slot], f + 1, memory_order_release);
+}
+
+/* -------------------------------------------------------------------------
+ * Stage 1: syndromes, forward dirty frames round-robin to the solvers
+ * ------------------------------------------------------------------------- */
+static void *syndrome_worker(void *arg) {
+  rs_pipeline *p = ((worker_arg *)arg)->p;
+  int s = ((worker_arg *)arg)->id;
+  int Ns = rs_N;
+  int T = rs_T;
+  int rr = s % p->n_solve;
+  size_t f;
+
+  for (;;) {
+    if (!spsc_pop(&p->in_q[s], &f)) {
+      if (atomic_load_explicit(&p->stop, memory_order_acquire))
+        break;
+      sched_yield();
+      continue;
+    }
+
+    rs_sym_t *synd = &p->synd[(f & p->mask) * T];
+    if (!rs_decode_syndromes(&p->frames[f * Ns], synd)) {
+      complete(p, f, 0);
+      continue;
+    }
+
+    /* Backpressure: try the next solver while the preferred one is full */
+    while (!spsc_push(&p->mid_q[s * p->n_solve + rr], f)) {
+      rr = (rr + 1) % p->n_solve;
+      sched_yield();
+    }
+    rr = (rr + 1) % p->n_solve;
+  }
+
+  return NULL;
+}
+
+/* -------------------------------------------------------------------------
+ * Stage 2: BM → Chien → magnitudes → correction
+ * ------------------------------------------------------------------------- */
+static void *solver_worker(void *arg) {
+  rs_pipeline *p = ((worker_arg *)arg)->p;
+  int v = ((worker_arg *)arg)->id;
+  int Ns = rs_N;
+  int T = rs_T;
+  rs_workspace *ws = p->ws[v];
+  size_t f;
+
+  for (;;) {
+    int busy = 0;
+
+    for (int s = 0; s < p->n_synd; s++) {
+      while (spsc_pop(&p->mid_q[s * p->n_solve + v], &f)) {
+        rs_sym_t *synd = &p->synd[(f & p->mask) * T];
+        complete(p, f, rs_decode_correct_ws(ws, &p->frames[f * Ns], synd));
+        busy = 1;
+      }
+    }
+
+    if (!busy) {
+      if (atomic_load_explicit(&p->stop, memory_order_acquire))
+        break;
+      sched_yield();
+    }
+  }
+
+  return NULL;
+}
+
+/* -------------------------------------------------------------------------
+ * Create / destroy
+ * ------------------------------------------------------------------------- */
+
+/* Queues are cache-line aligned so producer and consumer indices of
+ * different queues never share a line. */
+static spsc_queue *queue_array(int n) {
+  spsc_queue *q = (spsc_queue *)aligned_alloc(RS_CACHE_LINE,
+                                              n * sizeof(spsc_queue));
+  if (q)
+    memset(q, 0, n * sizeof(spsc_queue));
+  return q;
+}
+
+rs_pipeline *rs_pipeline_create(int n_synd_threads, int n_solve_threads,
+                                int window) {
+  if (n_synd_threads < 1 || n_solve_threads < 1 || rs_T <= 0)
+    return NULL;
+
+  rs_pipeline *p = (rs_pipeline *)calloc(1, sizeof(rs_pipeline));
+  if (!p)
+    return NULL;
+
+  size_t w = 2;
+  while (w < (size_t)window)
+    w <<= 1;
+
+  p->n_synd = n_synd_threads;
+  p->n_solve = n_solve_threads;
+  p->window = w;
+  p->mask = w - 1;
+
+  int n_mid = n_synd_threads * n_solve_threads;
+  p->in_q = queue_array(n_synd_threads);
+  p->mid_q = queue_array(n_mid);
+  p->synd = (rs_sym_t *)malloc(w * rs_T * sizeof(rs_sym_t));
+  p->slot_status = (int *)malloc(w * sizeof(int));
+  p->done_seq = (atomic_size_t *)malloc(w * sizeof(atomic_size_t));
+  p->ws = (rs_workspace **)calloc(n_solve_threads, sizeof(rs_workspace *));
+  p->tid = (pthread_t *)malloc((n_synd_threads + n_solve_threads) *
+                               sizeof(pthread_t));
+  p->args = (worker_arg *)malloc((n_synd_threads + n_solve_threads) *
+                                 sizeof(worker_arg));
+
+  if (!p->in_q || !p->mid_q || !p->synd || !p->slot_status || !p->done_seq ||
+      !p->ws || !p->tid || !p->args) {
+    rs_pipeline_destroy(p);
+    return NULL;
+  }
+
+  for (int i = 0; i < n_solve_threads; i++)
+    if (!(p->ws[i] = rs_workspace_create())) {
+      rs_pipeline_destroy(p);
+      return NULL;
+    }
+
+  /* Queues never hold more than the window, so pushes only fail while a
+   * downstream stage is behind. */
+  for (int i = 0; i < n_synd_threads; i++)
+    if (spsc_init(&p->in_q[i], w) != 0) {
+      rs_pipeline_destroy(p);
+      return NULL;
+    }
+  for (int i = 0; i < n_mid; i++)
+    if (spsc_init(&p->mid_q[i], w) != 0) {
+      rs_pipeline_destroy(p);
+      return NULL;
+    }
+
+  return p;
+}
+
+void rs_pipeline_destroy(rs_pipeline *p) {
+  if (!p)
+    return;
+
+  if (p->in_q)
+    for (int i = 0; i < p->n_synd; i++)
+      free(p->in_q[i].buf);
+  if (p->mid_q)
+    for (int i = 0; i < p->n_synd * p->n_solve; i++)
+      free(p->mid_q[i].buf);
+
+  if (p->ws)
+    for (int i = 0; i < p->n_solve; i++)
+      rs_workspace_destroy(p->ws[i]);
+
+  free(p->ws);
+  free(p->tid);
+  free(p->args);
+  free(p->in_q);
+  free(p->mid_q);
+  free(p->synd);
+  free(p->slot_status);
+  free(p->done_seq);
+  free(p);
+}
+
+/* -------------------------------------------------------------------------
+ * Stream decode: the calling thread feeds and retires frames in order
+ * ------------------------------------------------------------------------- */
+int rs_pipeline_decode(rs_pipeline *p, rs_sym_t *code_sym, size_t n_frames,
+                       int *status, rs_pipeline_done_fn done, void *user) {
+  int n_threads = p->n_synd + p->n_solve;
+  pthread_t *tid = p->tid;
+  worker_arg *args = p->args;
+  int started = 0;
+  int ret = 0;
+
+  p->frames = code_sym;
+  atomic_store(&p->stop, 0);
+  for (size_t i = 0; i < p->window; i++)
+    atomic_init(&p->done_seq[i], 0);
+
+  for (int i = 0; i < n_threads; i++) {
+    int is_synd = (i < p->n_synd);
+    args[i].p = p;
+    args[i].id = is_synd ? i : i - p->n_synd;
+    if (pthread_create(&tid[i], NULL, is_synd ? syndrome_worker : solver_worker,
+                       &args[i]) != 0) {
+      ret = -1;
+      n_frames = 0; /* start nothing, just shut down what was started */
+      break;
+    }
+    started++;
+  }
+
+  size_t next_feed = 0;
+  size_t next_done = 0;
+
+  while (next_done < n_frames) {
+    int progressed = 0;
+
+    /* Feed while the window has room */
+    while (next_feed < n_frames && next_feed - next_done < p->window) {
+      if (!spsc_push(&p->in_q[next_feed % p->n_synd], next_feed))
+        break;
+      next_feed++;
+      progressed = 1;
+    }
+
+    /* Retire completed frames in input order */
+    for (;;) {
+      size_t slot = next_done & p->mask;
+      if (next_done >= n_frames ||
+          atomic_load_explicit(&p->done_seq[slot], memory_order_acquire) !=
+              next_done + 1)
+        break;
+
+      int st = p->slot_status[slot];
+      if (status)
+        status[next_done] = st;
+      if (done)
+        done(user, next_done, st);
+      next_done++;
+      progressed = 1;
+    }
+
+    if (!progressed)
+      sched_yield();
+  }
+
+  atomic_store_explicit(&p->stop, 1, memory_order_release);
+  for (int i = 0; i < started; i++)
+    pthread_join(tid[i], NULL);
+
+  return ret;
+}
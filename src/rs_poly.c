@@ -0,0 +1,577 @@
+/**
+ * @file rs_poly.c
+ * @brief Polynomial arithmetic over the current GF(2^m).
+ *
+ * Every product is formed as α^(log a + log b) with one factor's logarithm
+ * hoisted out of the inner loop; the doubled exp table of the default
+ * profile absorbs the sum without a modulo (the compact profile reduces
+ * it once). Karatsuba splits a product of length n into three of length
+ * ⌈n/2⌉ and bottoms out in the schoolbook kernel, whose inner loop is the
+ * same scale-and-add the encoder and the decoder stages use.
+ */
+
+#include "rs_poly.h"
+#if RS_M_MAX > 8
+#include "rs_gf16.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Longest polynomial rs_poly_eval_geom() evaluates by term updates */
+#define GEOM_TERMS 256
+
+/* Fewest points for which wide fields run the term updates on the
+ * rs_gf16 kernels (each term then prepares a constant) */
+#define WIDE_POINTS 256
+
+/* Coefficients of b whose logarithms the schoolbook kernel keeps on the
+ * stack at a time */
+#define SCHOOL_BLOCK 256
+
+/* -------------------------------------------------------------------------
+ * Field helpers
+ * ------------------------------------------------------------------------- */
+static inline rs_sym_t exp_sum(unsigned e) {
+#ifdef RS_COMPACT
+  if (e >= (unsigned)rs_Np)
+    e -= rs_Np;
+#endif
+  return rs_gf_exp[e];
+}
+
+/* Exponent reduced to 0..Np-1 */
+static unsigned exp_mod(long long e) {
+  e %= rs_Np;
+  return (unsigned)(e < 0 ? e + rs_Np : e);
+}
+
+/* -------------------------------------------------------------------------
+ * Kernels
+ * ------------------------------------------------------------------------- */
+int rs_poly_deg(const rs_sym_t *a, int n) {
+  while (n > 0 && a[n - 1] == 0)
+    n--;
+  return n - 1;
+}
+
+void rs_poly_log(const rs_sym_t *a, rs_sym_t *a_log, int n) {
+  for (int i = 0; i < n; i++)
+    a_log[i] = a[i] ? rs_gf_log[a[i]] : RS_POLY_LOG_ZERO;
+}
+
+void rs_poly_scale_add(rs_sym_t *dst, const rs_sym_t *a, uint16_t k,
+                       const rs_sym_t *b, int n) {
+  if (k == 0) {
+    if (dst != a)
+      for (int i = 0; i < n; i++)
+        dst[i] = a[i];
+    return;
+  }
+  unsigned lk = rs_gf_log[k];
+  for (int i = 0; i < n; i++) {
+    rs_sym_t bi = b[i];
+    dst[i] = a[i] ^ (bi ? exp_sum(lk + rs_gf_log[bi]) : 0);
+  }
+}
+
+void rs_poly_scale_add_log(rs_sym_t *dst, const rs_sym_t *a, uint16_t k,
+                           const rs_sym_t *b_log, int n) {
+  if (k == 0) {
+    if (dst != a)
+      for (int i = 0; i < n; i++)
+        dst[i] = a[i];
+    return;
+  }
+  unsigned lk = rs_gf_log[k];
+  rs_sym_t lz = RS_POLY_LOG_ZERO;
+  for (int i = 0; i < n; i++) {
+    rs_sym_t lb = b_log[i];
+    dst[i] = a[i] ^ (lb != lz ? exp_sum(lk + lb) : 0);
+  }
+}
+
+uint16_t rs_poly_mul_coef(const rs_sym_t *a, int na, const rs_sym_t *b,
+                          int nb, int k) {
+  int i0 = (k - nb + 1 > 0) ? k - nb + 1 : 0;
+  int i1 = (k < na - 1) ? k : na - 1;
+  uint16_t v = 0;
+  for (int i = i0; i <= i1; i++) {
+    rs_sym_t x = a[i], y = b[k - i];
+    if (x && y)
+      v ^= exp_sum((unsigned)rs_gf_log[x] + rs_gf_log[y]);
+  }
+  return v;
+}
+
+/* -------------------------------------------------------------------------
+ * Multiplication
+ * ------------------------------------------------------------------------- */
+
+/* c += a·b (c holds na + nb - 1 coefficients) */
+static void school_acc(const rs_sym_t *a, int na, const rs_sym_t *b, int nb,
+                       rs_sym_t *c) {
+  rs_sym_t lb[SCHOOL_BLOCK];
+
+  for (int j0 = 0; j0 < nb; j0 += SCHOOL_BLOCK) {
+    int w = (nb - j0 < SCHOOL_BLOCK) ? nb - j0 : SCHOOL_BLOCK;
+    rs_poly_log(b + j0, lb, w);
+    for (int i = 0; i < na; i++)
+      if (a[i])
+        rs_poly_scale_add_log(c + i + j0, c + i + j0, a[i], lb, w);
+  }
+}
+
+void rs_poly_mul_school(const rs_sym_t *a, int na, const rs_sym_t *b, int nb,
+                        rs_sym_t *c) {
+  memset(c, 0, (size_t)(na + nb - 1) * sizeof(rs_sym_t));
+  school_acc(a, na, b, nb, c);
+}
+
+static size_t kara_scratch(int n) {
+  if (n < RS_POLY_KARATSUBA)
+    return 0;
+  int h = (n + 1) / 2;
+  return (size_t)(4 * h - 1) + kara_scratch(h);
+}
+
+/* c = a·b for two polynomials of length n, 2n - 1 coefficients */
+static void kara(const rs_sym_t *a, const rs_sym_t *b, int n, rs_sym_t *c,
+                 rs_sym_t *w) {
+  if (n < RS_POLY_KARATSUBA) {
+    rs_poly_mul_school(a, n, b, n, c);
+    return;
+  }
+
+  /* a = a0 + x^h a1, b likewise; |a0| = h, |a1| = l ≤ h */
+  int h = (n + 1) / 2, l = n - h;
+  kara(a, b, h, c, w);                 /* a0 b0 → c[0, 2h - 1) */
+  kara(a + h, b + h, l, c + 2 * h, w); /* a1 b1 → c[2h, 2n - 1) */
+  c[2 * h - 1] = 0;
+
+  rs_sym_t *sa = w, *sb = w + h, *mid = w + 2 * h;
+  for (int i = 0; i < h; i++) {
+    sa[i] = a[i] ^ (i < l ? a[h + i] : 0);
+    sb[i] = b[i] ^ (i < l ? b[h + i] : 0);
+  }
+  kara(sa, sb, h, mid, w + 4 * h - 1); /* (a0 + a1)(b0 + b1) */
+
+  /* Middle term: mid - a0 b0 - a1 b1, added at x^h */
+  for (int i = 0; i < 2 * h - 1; i++)
+    mid[i] ^= c[i];
+  for (int i = 0; i < 2 * l - 1; i++)
+    mid[i] ^= c[2 * h + i];
+  for (int i = 0; i < 2 * h - 1; i++)
+    c[h + i] ^= mid[i];
+}
+
+size_t rs_poly_mul_scratch(int na, int nb) {
+  int s = (na < nb) ? na : nb;
+  if (s < RS_POLY_KARATSUBA)
+    return 0;
+  return (size_t)(3 * s - 1) + kara_scratch(s);
+}
+
+void rs_poly_mul(const rs_sym_t *a, int na, const rs_sym_t *b, int nb,
+                 rs_sym_t *c, rs_sym_t *scratch) {
+  if (na < nb) {
+    const rs_sym_t *t = a;
+    a = b;
+    b = t;
+    int tn = na;
+    na = nb;
+    nb = tn;
+  }
+  if (nb < RS_POLY_KARATSUBA) {
+    rs_poly_mul_school(a, na, b, nb, c);
+    return;
+  }
+
+  /* Blocks of the longer factor times the shorter one, s = nb */
+  int s = nb;
+  rs_sym_t *prod = scratch, *pad = scratch + 2 * s - 1, *w = pad + s;
+  memset(c, 0, (size_t)(na + nb - 1) * sizeof(rs_sym_t));
+  for (int i0 = 0; i0 < na; i0 += s) {
+    const rs_sym_t *blk = a + i0;
+    int len = (na - i0 < s) ? na - i0 : s;
+    if (len < s) {
+      memcpy(pad, blk, (size_t)len * sizeof(rs_sym_t));
+      memset(pad + len, 0, (size_t)(s - len) * sizeof(rs_sym_t));
+      blk = pad;
+    }
+    kara(blk, b, s, prod, w);
+    for (int k = 0; k < len + s - 1; k++)
+      c[i0 + k] ^= prod[k];
+  }
+}
+
+/* -------------------------------------------------------------------------
+ * Division
+ * ------------------------------------------------------------------------- */
+int rs_poly_divmod(const rs_sym_t *a, int na, const rs_sym_t *b, int nb,
+                   rs_sym_t *q, rs_sym_t *r) {
+  if (nb < 1 || na < nb || b[nb - 1] == 0)
+    return -1;
+
+  int d = nb - 1;
+  unsigned linv = exp_mod(-(long long)rs_gf_log[b[d]]);
+
+  /* Remainder register: after a[i] it holds (a >> i) mod b */
+  for (int j = 0; j < d; j++)
+    r[j] = 0;
+  for (int i = na - 1; i >= 0; i--) {
+    rs_sym_t top = d ? r[d - 1] : a[i];
+    rs_sym_t qc = top ? exp_sum(rs_gf_log[top] + linv) : 0;
+    if (q && i <= na - nb)
+      q[i] = qc;
+    if (d == 0)
+      continue;
+
+    if (qc == 0) {
+      for (int j = d - 1; j >= 1; j--)
+        r[j] = r[j - 1];
+      r[0] = a[i];
+      continue;
+    }
+    unsigned lq = rs_gf_log[qc];
+    for (int j = d - 1; j >= 1; j--)
+      r[j] = r[j - 1] ^ (b[j] ? exp_sum(lq + rs_gf_log[b[j]]) : 0);
+    r[0] = a[i] ^ (b[0] ? exp_sum(lq + rs_gf_log[b[0]]) : 0);
+  }
+  return 0;
+}
+
+/* Scratch layout of a prepared divisor for quotients up to nq long */
+static size_t divisor_scratch(int nq, int nb) {
+  size_t m1 = rs_poly_mul_scratch(nq, nq);
+  size_t m2 = rs_poly_mul_scratch(nq, nb);
+  return (size_t)nq            /* reversed dividend / quotient */
+         + (size_t)(2 * nq - 1) /* rev(a) · inv */
+         + (size_t)(nq + nb - 1) /* q · b */
+         + (m1 > m2 ? m1 : m2);
+}
+
+int rs_poly_divisor_init(rs_poly_divisor *d, const rs_sym_t *b, int nb,
+                         int max_na) {
+  memset(d, 0, sizeof(*d));
+  if (nb < 1 || max_na < nb || b[nb - 1] == 0)
+    return -1;
+
+  int nq = max_na - nb + 1;
+  d->nb = nb;
+  d->max_na = max_na;
+  d->b = (rs_sym_t *)malloc((size_t)nb * sizeof(rs_sym_t));
+  d->inv_rev = (rs_sym_t *)calloc((size_t)nq, sizeof(rs_sym_t));
+  d->scratch =
+      (rs_sym_t *)malloc(divisor_scratch(nq, nb) * sizeof(rs_sym_t));
+
+  /* Newton scratch: rev(b), g², product and multiplication scratch */
+  size_t ns = (size_t)(4 * nq) + rs_poly_mul_scratch(nq, nq);
+  rs_sym_t *w = (rs_sym_t *)calloc(ns, sizeof(rs_sym_t));
+  if (!d->b || !d->inv_rev || !d->scratch || !w) {
+    free(w);
+    rs_poly_divisor_free(d);
+    return -1;
+  }
+  memcpy(d->b, b, (size_t)nb * sizeof(rs_sym_t));
+
+  /* g = 1 / rev(b) mod x^nq. With rev(b)·g ≡ 1 mod x^k, rev(b)·g² is the
+   * inverse mod x^2k: its product with rev(b) is (rev(b)·g)², and squaring
+   * is linear in characteristic 2 */
+  rs_sym_t *rb = w, *sq = w + nq, *prod = w + 2 * nq, *mw = w + 4 * nq;
+  for (int i = 0; i < nq; i++)
+    rb[i] = (i < nb) ? b[nb - 1 - i] : 0;
+  rs_sym_t *g = d->inv_rev;
+  g[0] = (rs_sym_t)rs_gf_inv(rb[0]);
+  for (int k = 1; k < nq;) {
+    int k2 = (2 * k < nq) ? 2 * k : nq;
+    memset(sq, 0, (size_t)k2 * sizeof(rs_sym_t));
+    for (int i = 0; 2 * i < k2; i++)
+      sq[2 * i] = g[i] ? exp_sum(2u * rs_gf_log[g[i]] % rs_Np) : 0;
+    rs_poly_mul(rb, k2, sq, k2, prod, mw);
+    memcpy(g, prod, (size_t)k2 * sizeof(rs_sym_t));
+    k = k2;
+  }
+
+  free(w);
+  return 0;
+}
+
+void rs_poly_divisor_free(rs_poly_divisor *d) {
+  free(d->b);
+  free(d->inv_rev);
+  free(d->scratch);
+  memset(d, 0, sizeof(*d));
+}
+
+int rs_poly_divmod_pre(const rs_poly_divisor *d, const rs_sym_t *a, int na,
+                       rs_sym_t *q, rs_sym_t *r) {
+  int nb = d->nb;
+  if (na < nb || na > d->max_na)
+    return -1;
+
+  int nq = na - nb + 1;
+  int max_nq = d->max_na - nb + 1;
+  rs_sym_t *rq = d->scratch;                /* [max_nq] */
+  rs_sym_t *prod = rq + max_nq;             /* [2 max_nq - 1] */
+  rs_sym_t *qb = prod + 2 * max_nq - 1;     /* [max_nq + nb - 1] */
+  rs_sym_t *mw = qb + max_nq + nb - 1;
+
+  /* rev(q) = rev(a) · inv_rev mod x^nq (top nq coefficients of a) */
+  for (int i = 0; i < nq; i++)
+    rq[i] = a[na - 1 - i];
+  rs_poly_mul(rq, nq, d->inv_rev, nq, prod, mw);
+  for (int i = 0; i < nq; i++)
+    rq[i] = prod[nq - 1 - i]; /* rq is now q */
+  if (q)
+    memcpy(q, rq, (size_t)nq * sizeof(rs_sym_t));
+
+  /* r = a - q·b, low nb - 1 coefficients */
+  rs_poly_mul(rq, nq, d->b, nb, qb, mw);
+  for (int j = 0; j < nb - 1; j++)
+    r[j] = a[j] ^ qb[j];
+  return 0;
+}
+
+/* -------------------------------------------------------------------------
+ * Euclid
+ * ------------------------------------------------------------------------- */
+size_t rs_poly_xgcd_scratch(int na, int nb) {
+  return 6 * (size_t)(na > nb ? na : nb);
+}
+
+int rs_poly_xgcd(const rs_sym_t *a, int na, const rs_sym_t *b, int nb,
+                 int stop_deg, rs_sym_t *r, rs_sym_t *s, rs_sym_t *t,
+                 rs_sym_t *scratch) {
+  int n = (na > nb) ? na : nb;
+  size_t bytes = (size_t)n * sizeof(rs_sym_t);
+  rs_sym_t *r0 = scratch, *r1 = r0 + n, *s0 = r1 + n, *s1 = s0 + n;
+  rs_sym_t *t0 = s1 + n, *t1 = t0 + n;
+
+  memset(scratch, 0, 6 * bytes);
+  memcpy(r0, a, (size_t)na * sizeof(rs_sym_t));
+  memcpy(r1, b, (size_t)nb * sizeof(rs_sym_t));
+  s0[0] = 1;
+  t1[0] = 1;
+  int d0 = rs_poly_deg(r0, n), d1 = rs_poly_deg(r1, n);
+
+  /* Invariant: r_i = s_i a + t_i b; degrees of s, t stay below n */
+  while (stop_deg > 0 ? d1 >= stop_deg : d1 >= 0) {
+    unsigned linv = exp_mod(-(long long)rs_gf_log[r1[d1]]);
+    while (d0 >= d1) {
+      int sh = d0 - d1;
+      rs_sym_t qc = exp_sum(rs_gf_log[r0[d0]] + linv);
+      rs_poly_scale_add(r0 + sh, r0 + sh, qc, r1, d1 + 1);
+      if (s)
+        rs_poly_scale_add(s0 + sh, s0 + sh, qc, s1, n - sh);
+      rs_poly_scale_add(t0 + sh, t0 + sh, qc, t1, n - sh);
+      d0 = rs_poly_deg(r0, d0);
+    }
+    rs_sym_t *p;
+    p = r0, r0 = r1, r1 = p;
+    p = s0, s0 = s1, s1 = p;
+    p = t0, t0 = t1, t1 = p;
+    int dd = d0;
+    d0 = d1;
+    d1 = dd;
+  }
+
+  /* Stopped: the current remainder; gcd: the last non-zero one, monic */
+  int deg = d1;
+  rs_sym_t *rr = r1, *ss = s1, *tt = t1;
+  uint16_t k = 1;
+  if (stop_deg <= 0) {
+    deg = d0;
+    rr = r0, ss = s0, tt = t0;
+    if (deg >= 0)
+      k = rs_gf_inv(rr[deg]);
+  }
+  for (int i = 0; i < n; i++) {
+    r[i] = (rs_sym_t)rs_gf_mul(rr[i], k);
+    if (s)
+      s[i] = (rs_sym_t)rs_gf_mul(ss[i], k);
+    if (t)
+      t[i] = (rs_sym_t)rs_gf_mul(tt[i], k);
+  }
+  return deg;
+}
+
+/* -------------------------------------------------------------------------
+ * Evaluation
+ * ------------------------------------------------------------------------- */
+
+/* Horner with x = α^lx */
+static uint16_t horner_log(const rs_sym_t *a, int n, unsigned lx) {
+  uint16_t acc = 0;
+  for (int j = n - 1; j >= 0; j--)
+    acc = (acc ? exp_sum(rs_gf_log[acc] + lx) : 0) ^ a[j];
+  return acc;
+}
+
+uint16_t rs_poly_eval(const rs_sym_t *a, int n, uint16_t x) {
+  if (n <= 0)
+    return 0;
+  if (x == 0)
+    return a[0];
+  return horner_log(a, n, rs_gf_log[x]);
+}
+
+void rs_poly_eval_many(const rs_sym_t *a, int n, const rs_sym_t *x,
+                       int count, rs_sym_t *out) {
+  for (int k = 0; k < count; k++)
+    out[k] = (rs_sym_t)rs_poly_eval(a, n, x[k]);
+}
+
+#if RS_M_MAX > 8
+/* Wide fields, long polynomial: per point x, Horner in RS_GF16_LANES
+ * interleaved lanes by the constant x^LANES, then a(x) = Σ_l acc_l x^l */
+static void eval_geom_horner16(const rs_sym_t *a, int n, unsigned le,
+                               unsigned ls, int count, rs_sym_t *out) {
+  int nb = n / RS_GF16_LANES, rem = n % RS_GF16_LANES;
+  uint16_t acc[RS_GF16_LANES];
+  rs_gf16_const k;
+  unsigned lx = le;
+
+  for (int i = 0; i < count; i++) {
+    for (int l = 0; l < RS_GF16_LANES; l++)
+      acc[l] = (l < rem) ? a[nb * RS_GF16_LANES + l] : 0;
+    rs_gf16_const_init(
+        &k, rs_gf_exp[(unsigned long long)lx * RS_GF16_LANES % rs_Np]);
+    rs_gf16_horner(&k, a, (size_t)nb, acc);
+    out[i] = (rs_sym_t)horner_log(acc, RS_GF16_LANES, lx);
+    lx += ls;
+    if (lx >= (unsigned)rs_Np)
+      lx -= rs_Np;
+  }
+}
+
+/* Wide fields, many points: term a_j α^{j·e} over RS_GF16_LANES
+ * consecutive points, advanced by the constant α^{j·step·LANES} per block */
+static void eval_geom_terms16(const rs_sym_t *a, int n, unsigned le,
+                              unsigned ls, int count, rs_sym_t *out) {
+  int nb = count / RS_GF16_LANES, rem = count % RS_GF16_LANES;
+  uint16_t v[RS_GF16_LANES];
+  rs_gf16_const k;
+
+  memset(out, 0, (size_t)count * sizeof(rs_sym_t));
+  for (int j = 0; j < n; j++) {
+    if (!a[j])
+      continue;
+    unsigned lt = (unsigned)((rs_gf_log[a[j]] +
+                              (unsigned long long)j * le) % rs_Np);
+    unsigned inc = (unsigned)((unsigned long long)j * ls % rs_Np);
+    for (int l = 0; l < RS_GF16_LANES; l++) {
+      v[l] = rs_gf_exp[lt];
+      lt += inc;
+      if (lt >= (unsigned)rs_Np)
+        lt -= rs_Np;
+    }
+    rs_gf16_const_init(
+        &k, rs_gf_exp[(unsigned long long)inc * RS_GF16_LANES % rs_Np]);
+    rs_gf16_geom(&k, v, out, (size_t)nb);
+    for (int l = 0; l < rem; l++)
+      out[nb * RS_GF16_LANES + l] ^= v[l];
+  }
+}
+#endif
+
+void rs_poly_eval_geom(const rs_sym_t *a, int n, long long e0,
+                       long long step, int count, rs_sym_t *out) {
+  unsigned le = exp_mod(e0), ls = exp_mod(step);
+
+#if RS_M_MAX > 8
+  if (rs_m > 8 && (n > GEOM_TERMS || count >= WIDE_POINTS) &&
+      rs_gf16_vector()) {
+    if (n > GEOM_TERMS)
+      eval_geom_horner16(a, n, le, ls, count, out);
+    else
+      eval_geom_terms16(a, n, le, ls, count, out);
+    return;
+  }
+#endif
+
+  if (n > GEOM_TERMS) {
+    /* Horner at every point at once: the points' steps are independent */
+    for (int k = 0; k < count; k++)
+      out[k] = 0;
+    for (int j = n - 1; j >= 0; j--) {
+      unsigned lx = le;
+      rs_sym_t aj = a[j];
+      for (int k = 0; k < count; k++) {
+        rs_sym_t acc = out[k];
+        out[k] = (rs_sym_t)((acc ? exp_sum(rs_gf_log[acc] + lx) : 0) ^ aj);
+        lx += ls;
+        if (lx >= (unsigned)rs_Np)
+          lx -= rs_Np;
+      }
+    }
+    return;
+  }
+
+  /* Terms a_j α^{j·e} as logarithms, advanced by j·step per point; zero
+   * terms are dropped */
+  unsigned lt[GEOM_TERMS], inc[GEOM_TERMS];
+  int nt = 0;
+  for (int j = 0; j < n; j++) {
+    if (!a[j])
+      continue;
+    lt[nt] = (unsigned)((rs_gf_log[a[j]] + (unsigned long long)j * le) %
+                        rs_Np);
+    inc[nt] = (unsigned)((unsigned long long)j * ls % rs_Np);
+    nt++;
+  }
+
+  for (int k = 0; k < count; k++) {
+    uint16_t v = 0;
+    for (int j = 0; j < nt; j++) {
+      v ^= rs_gf_exp[lt[j]];
+      lt[j] += inc[j];
+      if (lt[j] >= (unsigned)rs_Np)
+        lt[j] -= rs_Np;
+    }
+    out[k] = (rs_sym_t)v;
+  }
+}
+
+/* -------------------------------------------------------------------------
+ * Construction
+ * ------------------------------------------------------------------------- */
+size_t rs_poly_from_roots_scratch(int n) {
+  if (n < RS_POLY_KARATSUBA)
+    return 0;
+  int h = n / 2;
+  size_t sl = rs_poly_from_roots_scratch(h);
+  size_t sr = rs_poly_from_roots_scratch(n - h);
+  size_t sm = rs_poly_mul_scratch(h + 1, n - h + 1);
+  size_t inner = (sl > sr) ? sl : sr;
+  return (size_t)(n + 2) + (inner > sm ? inner : sm);
+}
+
+void rs_poly_from_roots(const rs_sym_t *roots, int n, rs_sym_t *out,
+                        rs_sym_t *scratch) {
+  if (n < RS_POLY_KARATSUBA) {
+    /* Multiply by (x - r) in place, top coefficient first */
+    out[0] = 1;
+    for (int i = 0; i < n; i++) {
+      out[i + 1] = out[i];
+      if (roots[i] == 0) {
+        for (int j = i; j >= 1; j--)
+          out[j] = out[j - 1];
+        out[0] = 0;
+        continue;
+      }
+      unsigned lr = rs_gf_log[roots[i]];
+      for (int j = i; j >= 1; j--)
+        out[j] = out[j - 1] ^ (out[j] ? exp_sum(rs_gf_log[out[j]] + lr) : 0);
+      out[0] = out[0] ? exp_sum(rs_gf_log[out[0]] + lr) : 0;
+    }
+    return;
+  }
+
+  /* Product tree: both halves, then one (Karatsuba) product */
+  int h = n / 2;
+  rs_sym_t *lo = scratch, *hi = scratch + h + 1, *w = scratch + n + 2;
+  rs_poly_from_roots(roots, h, lo, w);
+  rs_poly_from_roots(roots + h, n - h, hi, w);
+  rs_poly_mul(lo, h + 1, hi, n - h + 1, out, w);
+}
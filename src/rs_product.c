@@ -0,0 +1,90 @@
+/**
+ * @file rs_product.c
+ * @brief Product code RS(N, K) × RS(N, K) for 2-D storage blocks.
+ *
+ * Every pass is one rs_decode_batch_sym() call over the N rows (frame
+ * stride N, symbol stride 1) or the N columns (frame stride 1, symbol
+ * stride N). The failure list of each direction is kept from pass to pass:
+ * it is the erasure list of the next pass in the other direction and the
+ * reference for detecting a fixed point.
+ */
+
+#include "rs_product.h"
+#include "rs_batch.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+int rs_product_encode(rs_sym_t *block, int n_threads) {
+  size_t N = (size_t)rs_N;
+
+  if (rs_encode_batch_sym(block, N, 1, (size_t)rs_K, n_threads) != 0)
+    return -1;
+  return rs_encode_batch_sym(block, 1, N, N, n_threads);
+}
+
+int rs_product_decode(rs_sym_t *block, int max_passes, int n_threads,
+                      rs_product_stats *stats) {
+  int N = rs_N, T = rs_T;
+
+  if (max_passes <= 0)
+    max_passes = 16;
+
+  /* status[N], failure lists fail[2][N] (0 = rows, 1 = columns), new list */
+  int *mem = (int *)malloc((size_t)4 * N * sizeof(int));
+  if (!mem)
+    return -1;
+  int *status = mem;
+  int *fail[2] = {mem + N, mem + 2 * N};
+  int *next = mem + 3 * N;
+  int n_fail[2] = {-1, -1}; /* -1: direction not decoded yet */
+
+  int ret = -1, quiet = 0, pass;
+  long corrected = 0;
+
+  for (pass = 0; pass < max_passes; pass++) {
+    int dir = pass & 1;
+    size_t fs = dir ? 1 : (size_t)N;
+    size_t ss = dir ? (size_t)N : 1;
+    int n_eras = (n_fail[!dir] > 0 && n_fail[!dir] <= T) ? n_fail[!dir] : 0;
+
+    if (rs_decode_batch_sym(block, fs, ss, fail[!dir], n_eras, status,
+                            (size_t)N, n_threads) != 0)
+      break;
+
+    int nf = 0, changed = 0;
+    for (int f = 0; f < N; f++) {
+      if (status[f] < 0)
+        next[nf++] = f;
+      else if (status[f] > 0) {
+        changed = 1;
+        corrected += status[f];
+      }
+    }
+
+    int same = (nf == n_fail[dir]) &&
+               memcmp(next, fail[dir], (size_t)nf * sizeof(int)) == 0;
+    memcpy(fail[dir], next, (size_t)nf * sizeof(int));
+    n_fail[dir] = nf;
+    quiet = changed ? 0 : quiet + 1;
+
+    if (nf == 0 && !changed && n_fail[!dir] == 0) {
+      ret = 0;
+      pass++;
+      break;
+    }
+    if (quiet >= 2 && same) {
+      pass++;
+      break;
+    }
+  }
+
+  if (stats) {
+    stats->passes = pass;
+    stats->corrected = corrected;
+    stats->failed_rows = n_fail[0] > 0 ? n_fail[0] : 0;
+    stats->failed_cols = n_fail[1] > 0 ? n_fail[1] : 0;
+  }
+  free(mem);
+  return ret;
+}
@@ -0,0 +1,201 @@
+/**
+ * @file rs_split.c
+ * @brief Multi-threaded decoding of a single long codeword.
+ *
+ * Both parallel stages use the same fork/join helper: the index range is
+ * cut into n_threads contiguous parts, parts 1.. run on short-lived worker
+ * threads and part 0 on the calling thread. Per-part results (partial
+ * syndromes, Chien roots) go to private slots of one scratch block, so the
+ * workers share nothing but read-only inputs.
+ *
+ * The thread count is clamped to rs_batch_default_threads(), and the
+ * scratch block (parts, root slots, partial syndromes) is kept per calling
+ * thread and only re-allocated when a larger code or thread count needs
+ * more, so repeated decodes do not allocate.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "rs_split.h"
+#include "rs_batch.h"
+#include "rs_decoder.h"
+#include "rs_gf.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+typedef struct {
+  int chien; /* 0 = partial syndromes, 1 = Chien search */
+  int lo, hi;
+
+  const rs_sym_t *code_sym; /* syndromes */
+  rs_sym_t *synd;           /* [T] partial syndromes */
+
+  const rs_sym_t *sigma; /* Chien */
+  int L;
+  int *roots; /* [L + 1] */
+  int n_roots;
+} split_part;
+
+/* -------------------------------------------------------------------------
+ * Per-thread scratch block
+ * ------------------------------------------------------------------------- */
+typedef struct {
+  size_t bytes;
+  void *mem;
+} split_scratch;
+
+static pthread_key_t scratch_key;
+static pthread_once_t scratch_once = PTHREAD_ONCE_INIT;
+
+static void scratch_destroy(void *arg) {
+  split_scratch *sc = (split_scratch *)arg;
+  if (sc)
+    free(sc->mem);
+  free(sc);
+}
+
+static void scratch_make_key(void) {
+  pthread_key_create(&scratch_key, scratch_destroy);
+}
+
+/* At least `bytes` of scratch for the calling thread, or NULL */
+static void *scratch_get(size_t bytes) {
+  pthread_once(&scratch_once, scratch_make_key);
+
+  split_scratch *sc = (split_scratch *)pthread_getspecific(scratch_key);
+  if (!sc) {
+    sc = (split_scratch *)calloc(1, sizeof(*sc));
+    if (!sc || pthread_setspecific(scratch_key, sc) != 0) {
+      free(sc);
+      return NULL;
+    }
+  }
+  if (sc->bytes < bytes) {
+    free(sc->mem);
+    sc->mem = malloc(bytes);
+    sc->bytes = sc->mem ? bytes : 0;
+  }
+  return sc->mem;
+}
+
+/* -------------------------------------------------------------------------
+ * Per-part kernel and fork/join
+ * ------------------------------------------------------------------------- */
+static void *run_part(void *arg) {
+  split_part *p = (split_part *)arg;
+
+  if (p->chien)
+    p->n_roots = rs_decode_chien_range(p->sigma, p->L, p->lo, p->hi,
+                                       p->roots, p->L + 1);
+  else
+    rs_decode_syndromes_range(p->code_sym, p->lo, p->hi, p->synd);
+  return NULL;
+}
+
+static void fork_join(split_part *part, int n_parts, int len) {
+  pthread_t tid[RS_BATCH_MAX_THREADS];
+  int started[RS_BATCH_MAX_THREADS];
+
+  for (int i = 0; i < n_parts; i++) {
+    part[i].lo = (int)((long long)len * i / n_parts);
+    part[i].hi = (int)((long long)len * (i + 1) / n_parts);
+  }
+
+  for (int i = 1; i < n_parts; i++)
+    started[i] = (pthread_create(&tid[i], NULL, run_part, &part[i]) == 0);
+
+  run_part(&part[0]);
+  for (int i = 1; i < n_parts; i++) {
+    if (started[i])
+      pthread_join(tid[i], NULL);
+    else
+      run_part(&part[i]);
+  }
+}
+
+/* -------------------------------------------------------------------------
+ * Decoder
+ * ------------------------------------------------------------------------- */
+int rs_decode_sym_split_ws(rs_workspace *ws, rs_sym_t *code_sym,
+                           int n_threads) {
+  int T = rs_T;
+  int t = rs_T / 2;
+
+  if (rs_workspace_check(ws) != 0)
+    return -1;
+  ws->corr_bits = 0;
+  int max_threads = rs_batch_default_threads();
+  if (n_threads <= 0 || n_threads > max_threads)
+    n_threads = max_threads;
+  if (n_threads > rs_N)
+    n_threads = rs_N;
+  if (n_threads <= 1)
+    return rs_decode_sym_ws(ws, code_sym);
+
+  /* Scratch: parts, root slots (int), then partial syndromes */
+  size_t n = (size_t)n_threads;
+  split_part *part = (split_part *)scratch_get(
+      n * sizeof(split_part) + n * (t + 1) * sizeof(int) +
+      n * T * sizeof(rs_sym_t));
+  if (!part)
+    return rs_decode_sym_ws(ws, code_sym);
+  int *roots = (int *)&part[n_threads];
+  rs_sym_t *partial = (rs_sym_t *)&roots[n_threads * (t + 1)];
+
+  /* Stage 1: partial syndromes per symbol range */
+  for (int i = 0; i < n_threads; i++)
+    part[i] = (split_part){.chien = 0,
+                           .code_sym = code_sym,
+                           .synd = &partial[i * T]};
+  fork_join(part, n_threads, rs_N);
+
+  rs_sym_t *synd = ws->synd;
+  int dirty = 0;
+  for (int j = 0; j < T; j++) {
+    rs_sym_t s = 0;
+    for (int i = 0; i < n_threads; i++)
+      s ^= partial[i * T + j];
+    synd[j] = s;
+    dirty |= (s != 0);
+  }
+  if (!dirty)
+    return 0;
+
+  /* Stage 2: BM on the calling thread; a locator of degree > t already
+   * fails, so skip the search */
+  rs_sym_t *sigma = ws->sigma;
+  int L = rs_decode_locator_ws(ws, synd, sigma);
+  if (L > t)
+    return -1;
+
+  /* Stage 3: Chien search per parent-position range */
+  for (int i = 0; i < n_threads; i++)
+    part[i] = (split_part){
+        .chien = 1, .sigma = sigma, .L = L, .roots = &roots[i * (t + 1)]};
+  fork_join(part, n_threads, rs_Np);
+
+  /* Concatenate roots in position order, keeping at most L + 1 as the
+   * single-threaded search does */
+  int *error_pos = ws->error_pos;
+  int count = 0;
+  for (int i = 0; i < n_threads && count <= L; i++)
+    for (int r = 0; r < part[i].n_roots && count <= L; r++)
+      error_pos[count++] = part[i].roots[r];
+
+  if (count != L)
+    return -1;
+
+  /* Stage 4: magnitudes and correction */
+  int check = rs_decode_magnitudes_ws(ws, code_sym, synd, error_pos, count);
+  if (check < 0)
+    return check;
+  return count;
+}
+
+int rs_decode_sym_split(rs_sym_t *code_sym, int n_threads) {
+  rs_workspace *ws = rs_workspace_default();
+  if (!ws)
+    return -1;
+  return rs_decode_sym_split_ws(ws, code_sym, n_threads);
+}
@@ -0,0 +1,135 @@
+/**
+ * @file rs_stats.c
+ * @brief Pre-FEC bit error rate estimation from decoder corrections.
+ *
+ * The window is a ring of per-codeword bit counts and failure flags with
+ * running sums, so an update is O(1) whatever the window length.
+ */
+
+#include "rs_stats.h"
+#include "rs_gf.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct rs_chan_stats {
+  pthread_mutex_t lock;
+
+  int word_bits; /* N · m received bits per codeword */
+  int fail_bits; /* bits charged to an uncorrectable word */
+  double alpha;
+  int window;
+
+  int *ring_bits;
+  unsigned char *ring_fail;
+  int head, fill;
+  long long win_bits;
+  int win_fail;
+
+  double ewma;
+  long long words, failed, total_bits;
+};
+
+rs_chan_stats *rs_chan_stats_create(int window, double alpha) {
+  if (window < 1 || !(alpha > 0.0 && alpha <= 1.0) || rs_N <= 0)
+    return NULL;
+
+  rs_chan_stats *s = (rs_chan_stats *)calloc(1, sizeof(*s));
+  if (!s)
+    return NULL;
+  s->ring_bits = (int *)calloc((size_t)window, sizeof(int));
+  s->ring_fail = (unsigned char *)calloc((size_t)window, 1);
+  if (!s->ring_bits || !s->ring_fail) {
+    rs_chan_stats_destroy(s);
+    return NULL;
+  }
+
+  pthread_mutex_init(&s->lock, NULL);
+  s->word_bits = rs_N * rs_m;
+  s->fail_bits = rs_T / 2 + 1;
+  s->alpha = alpha;
+  s->window = window;
+  return s;
+}
+
+void rs_chan_stats_destroy(rs_chan_stats *s) {
+  if (!s)
+    return;
+  if (s->ring_bits && s->ring_fail)
+    pthread_mutex_destroy(&s->lock);
+  free(s->ring_bits);
+  free(s->ring_fail);
+  free(s);
+}
+
+void rs_chan_stats_reset(rs_chan_stats *s) {
+  pthread_mutex_lock(&s->lock);
+  memset(s->ring_bits, 0, (size_t)s->window * sizeof(int));
+  memset(s->ring_fail, 0, (size_t)s->window);
+  s->head = s->fill = 0;
+  s->win_bits = 0;
+  s->win_fail = 0;
+  s->ewma = 0.0;
+  s->words = s->failed = s->total_bits = 0;
+  pthread_mutex_unlock(&s->lock);
+}
+
+/* -------------------------------------------------------------------------
+ * Updates
+ * ------------------------------------------------------------------------- */
+static void add_locked(rs_chan_stats *s, int status, int bits) {
+  int fail = (status < 0);
+  if (fail)
+    bits = s->fail_bits;
+
+  /* Window: replace the oldest entry once the ring is full */
+  if (s->fill == s->window) {
+    s->win_bits -= s->ring_bits[s->head];
+    s->win_fail -= s->ring_fail[s->head];
+  } else {
+    s->fill++;
+  }
+  s->ring_bits[s->head] = bits;
+  s->ring_fail[s->head] = (unsigned char)fail;
+  s->win_bits += bits;
+  s->win_fail += fail;
+  if (++s->head == s->window)
+    s->head = 0;
+
+  /* EWMA, seeded with the first word */
+  double x = (double)bits / s->word_bits;
+  s->ewma = s->words ? s->ewma + s->alpha * (x - s->ewma) : x;
+
+  s->words++;
+  s->failed += fail;
+  s->total_bits += bits;
+}
+
+void rs_chan_stats_add(rs_chan_stats *s, int status, int bits) {
+  pthread_mutex_lock(&s->lock);
+  add_locked(s, status, bits);
+  pthread_mutex_unlock(&s->lock);
+}
+
+void rs_chan_stats_add_batch(rs_chan_stats *s, const int *status,
+                             const int *bits, size_t n) {
+  pthread_mutex_lock(&s->lock);
+  for (size_t i = 0; i < n; i++)
+    add_locked(s, status[i], bits[i]);
+  pthread_mutex_unlock(&s->lock);
+}
+
+void rs_chan_stats_read(rs_chan_stats *s, rs_chan_estimate *est) {
+  pthread_mutex_lock(&s->lock);
+  est->words = s->words;
+  est->failed = s->failed;
+  est->ber_ewma = s->ewma;
+  est->ber_window =
+      s->fill ? (double)s->win_bits / ((double)s->fill * s->word_bits) : 0.0;
+  est->fer_window = s->fill ? (double)s->win_fail / s->fill : 0.0;
+  est->ber_total =
+      s->words ? (double)s->total_bits / ((double)s->words * s->word_bits)
+               : 0.0;
+  pthread_mutex_unlock(&s->lock);
+}
@@ -0,0 +1,366 @@
+/**
+ * @file rs_table.c
+ * @brief Precomputed GF/code table files with read-only mmap loading.
+ *
+ * Saving walks the active table views of rs_gf.h and writes them as
+ * 64-byte aligned sections behind a fixed header. Loading maps the whole
+ * file (PROT_READ, MAP_SHARED), validates header, sizes and checksum, and
+ * only then switches the table views and code parameters over to it.
+ * Platforms without mmap read the file into private memory instead.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "rs_table.h"
+#include "rs_gf.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define SECTION_ALIGN 64
+#define FLAG_COMPACT 1u
+
+enum {
+  SEC_EXP,
+  SEC_LOG,
+  SEC_GEN,
+  SEC_GEN_LOG,
+  SEC_GEN_SPLIT,
+  SEC_BITS,
+  SEC_DUAL_TO_CONV,
+  SEC_CONV_TO_DUAL,
+  N_SECTIONS
+};
+
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t header_bytes; /* sizeof(table_header) */
+  uint32_t flags;        /* FLAG_COMPACT */
+  uint32_t m_max;        /* RS_M_MAX of the writer */
+  uint32_t sym_bytes;    /* sizeof(rs_sym_t) of the writer */
+  int32_t m, N, K, T;
+  uint32_t poly;    /* code options (rs_gf_init_params()) */
+  int32_t fcr, prim, dual_basis;
+  uint64_t sec_off[N_SECTIONS];
+  uint64_t sec_len[N_SECTIONS]; /* bytes, 0 = absent */
+  uint64_t file_bytes;
+  uint64_t checksum; /* over [header_bytes, file_bytes) */
+} table_header;
+
+/* Current mapping (replaced by the next successful load) */
+static void *map_base;
+static size_t map_bytes;
+
+/* -------------------------------------------------------------------------
+ * Layout and checksum
+ * ------------------------------------------------------------------------- */
+static uint32_t build_flags(void) {
+#ifdef RS_COMPACT
+  return FLAG_COMPACT;
+#else
+  return 0;
+#endif
+}
+
+static int gcd(int a, int b) {
+  while (b) {
+    int r = a % b;
+    a = b;
+    b = r;
+  }
+  return a;
+}
+
+/* Section sizes the current build expects for field size m, T and basis */
+static void expected_lengths(int m, int T, int dual,
+                             uint64_t len[N_SECTIONS]) {
+  uint64_t np = ((uint64_t)1 << m) - 1;
+  len[SEC_GEN_SPLIT] = 0;
+#if RS_M_MAX > 8
+  if (m > 8 && T <= RS_GEN_SPLIT_T_MAX)
+    len[SEC_GEN_SPLIT] = 64 * (uint64_t)RS_GEN_SPLIT_STRIDE(T) *
+                         sizeof(rs_sym_t);
+#endif
+#ifdef RS_COMPACT
+  len[SEC_EXP] = (np + 1) * sizeof(rs_sym_t);
+  len[SEC_BITS] = 0;
+#else
+  len[SEC_EXP] = 2 * np * sizeof(rs_sym_t);
+  len[SEC_BITS] = (np + 1) * RS_M_MAX * sizeof(int);
+#endif
+  len[SEC_LOG] = (np + 1) * sizeof(rs_sym_t);
+  len[SEC_GEN] = (uint64_t)(T + 1) * sizeof(rs_sym_t);
+  len[SEC_GEN_LOG] = len[SEC_GEN];
+  len[SEC_DUAL_TO_CONV] = dual ? RS_DUAL_SIZE * sizeof(rs_sym_t) : 0;
+  len[SEC_CONV_TO_DUAL] = len[SEC_DUAL_TO_CONV];
+}
+
+static uint64_t align_up(uint64_t v) {
+  return (v + SECTION_ALIGN - 1) & ~(uint64_t)(SECTION_ALIGN - 1);
+}
+
+/* Fletcher-64 over 32-bit words (len is a multiple of 4); the modulo is
+ * deferred to every 4096 words, which keeps both sums below 2^64 */
+static uint64_t checksum(const uint8_t *p, uint64_t len) {
+  const uint64_t mod = 0xFFFFFFFFu;
+  uint64_t a = 0, b = 0;
+  uint64_t i = 0;
+  while (i < len) {
+    uint64_t end = i + 4 * 4096;
+    if (end > len)
+      end = len;
+    for (; i < end; i += 4) {
+      uint32_t w;
+      memcpy(&w, p + i, 4);
+      a += w;
+      b += a;
+    }
+    a %= mod;
+    b %= mod;
+  }
+  return (b << 32) | a;
+}
+
+/* -------------------------------------------------------------------------
+ * Save
+ * ------------------------------------------------------------------------- */
+int rs_table_save(const char *path) {
+  if (rs_T <= 0) {
+    fprintf(stderr, "ERROR: rs_table_save() needs rs_gf_init() first\n");
+    return -1;
+  }
+
+  table_header h;
+  memset(&h, 0, sizeof(h));
+  h.magic = RS_TABLE_MAGIC;
+  h.version = RS_TABLE_VERSION;
+  h.header_bytes = sizeof(table_header);
+  h.flags = build_flags();
+  h.m_max = RS_M_MAX;
+  h.sym_bytes = sizeof(rs_sym_t);
+  h.m = rs_m;
+  h.N = rs_N;
+  h.K = rs_K;
+  h.T = rs_T;
+  h.poly = rs_poly;
+  h.fcr = rs_fcr;
+  h.prim = rs_prim;
+  h.dual_basis = (rs_dual_to_conv != NULL);
+
+  const void *src[N_SECTIONS] = {
+      rs_gf_exp, rs_gf_log,       rs_generator,   rs_generator_log,
+      NULL,      NULL,            rs_dual_to_conv, rs_conv_to_dual};
+#if RS_M_MAX > 8
+  src[SEC_GEN_SPLIT] = rs_generator_split;
+#endif
+#ifndef RS_COMPACT
+  src[SEC_BITS] = rs_symbol_bits;
+#endif
+  expected_lengths(rs_m, rs_T, h.dual_basis, h.sec_len);
+
+  uint64_t off = align_up(sizeof(table_header));
+  for (int s = 0; s < N_SECTIONS; s++) {
+    h.sec_off[s] = h.sec_len[s] ? off : 0;
+    off = align_up(off + h.sec_len[s]);
+  }
+  h.file_bytes = off;
+
+  /* Assemble the image in memory so the checksum covers exactly it */
+  uint8_t *img = (uint8_t *)calloc(1, (size_t)h.file_bytes);
+  if (!img) {
+    fprintf(stderr, "ERROR: table image allocation failed\n");
+    return -1;
+  }
+  for (int s = 0; s < N_SECTIONS; s++)
+    if (h.sec_len[s])
+      memcpy(img + h.sec_off[s], src[s], (size_t)h.sec_len[s]);
+  h.checksum =
+      checksum(img + h.header_bytes, h.file_bytes - h.header_bytes);
+  memcpy(img, &h, sizeof(h));
+
+  /* Write under a temporary name, then rename into place */
+  size_t plen = strlen(path);
+  char *tmp = (char *)malloc(plen + 5);
+  if (!tmp) {
+    free(img);
+    return -1;
+  }
+  memcpy(tmp, path, plen);
+  memcpy(tmp + plen, ".tmp", 5);
+
+  int ret = -1;
+  FILE *fp = fopen(tmp, "wb");
+  if (!fp) {
+    fprintf(stderr, "ERROR: cannot create %s\n", tmp);
+  } else {
+    size_t wr = fwrite(img, 1, (size_t)h.file_bytes, fp);
+    if (fclose(fp) == 0 && wr == h.file_bytes && rename(tmp, path) == 0)
+      ret = 0;
+    else
+      fprintf(stderr, "ERROR: cannot write %s\n", path);
+    if (ret != 0)
+      remove(tmp);
+  }
+
+  free(tmp);
+  free(img);
+  return ret;
+}
+
+/* -------------------------------------------------------------------------
+ * Load
+ * ------------------------------------------------------------------------- */
+static void *map_file(const char *path, size_t *bytes) {
+#ifndef _WIN32
+  int fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return NULL;
+  struct stat st;
+  void *p = NULL;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED)
+      p = NULL;
+    *bytes = (size_t)st.st_size;
+  }
+  close(fd);
+  return p;
+#else
+  FILE *fp = fopen(path, "rb");
+  if (!fp)
+    return NULL;
+  void *p = NULL;
+  if (fseek(fp, 0, SEEK_END) == 0) {
+    long len = ftell(fp);
+    if (len > 0 && fseek(fp, 0, SEEK_SET) == 0 && (p = malloc(len)) &&
+        fread(p, 1, (size_t)len, fp) != (size_t)len) {
+      free(p);
+      p = NULL;
+    }
+    *bytes = (size_t)len;
+  }
+  fclose(fp);
+  return p;
+#endif
+}
+
+static void unmap_file(void *p, size_t bytes) {
+  if (!p)
+    return;
+#ifndef _WIN32
+  munmap(p, bytes);
+#else
+  (void)bytes;
+  free(p);
+#endif
+}
+
+/* Header and layout checks; returns an error message or NULL */
+static const char *validate(const uint8_t *base, size_t bytes) {
+  table_header h;
+  if (bytes < sizeof(h))
+    return "file too short";
+  memcpy(&h, base, sizeof(h));
+
+  if (h.magic != RS_TABLE_MAGIC)
+    return "not an RS table file";
+  if (h.version != RS_TABLE_VERSION || h.header_bytes != sizeof(h))
+    return "unsupported table file version";
+  if (h.m_max != RS_M_MAX || h.sym_bytes != sizeof(rs_sym_t) ||
+      h.flags != build_flags())
+    return "table file built for a different RS_M_MAX/profile";
+  if (h.m < 1 || h.m > RS_M_MAX || h.K < 1 || h.T < 1 ||
+      h.N != h.K + h.T || h.N > (1 << h.m) - 1)
+    return "invalid code parameters";
+  int np = (1 << h.m) - 1;
+  if ((h.poly >> h.m) != 1 || h.fcr < 0 || h.fcr >= (np > 1 ? np : 1) ||
+      h.prim < 0 || h.prim >= (np > 1 ? np : 1) ||
+      (np > 1 && (h.prim == 0 || gcd(h.prim, np) != 1)) ||
+      (h.dual_basis != 0 &&
+       (h.dual_basis != 1 || h.m != 8 || h.poly != RS_CCSDS_POLY)))
+    return "invalid code options";
+  if (h.file_bytes != bytes)
+    return "file size mismatch (truncated?)";
+
+  uint64_t len[N_SECTIONS];
+  expected_lengths(h.m, h.T, h.dual_basis, len);
+  for (int s = 0; s < N_SECTIONS; s++) {
+    if (h.sec_len[s] != len[s])
+      return "section size mismatch";
+    if (len[s] && (h.sec_off[s] % SECTION_ALIGN != 0 ||
+                   h.sec_off[s] < h.header_bytes ||
+                   h.sec_off[s] + len[s] > bytes))
+      return "section outside the file";
+  }
+
+  if (checksum(base + h.header_bytes, bytes - h.header_bytes) != h.checksum)
+    return "checksum mismatch";
+  return NULL;
+}
+
+int rs_table_load(const char *path) {
+  size_t bytes = 0;
+  uint8_t *base = (uint8_t *)map_file(path, &bytes);
+  if (!base) {
+    fprintf(stderr, "ERROR: cannot map table file %s\n", path);
+    return -1;
+  }
+
+  const char *err = validate(base, bytes);
+  if (err) {
+    fprintf(stderr, "ERROR: %s: %s\n", path, err);
+    unmap_file(base, bytes);
+    return -1;
+  }
+
+  table_header h;
+  memcpy(&h, base, sizeof(h));
+
+  rs_m = h.m;
+  rs_N = h.N;
+  rs_K = h.K;
+  rs_T = h.T;
+  rs_Np = (1 << h.m) - 1;
+  rs_S = rs_Np - rs_N;
+  rs_poly = h.poly;
+  rs_fcr = h.fcr;
+  rs_prim = h.prim;
+  rs_root_step = (rs_Np > 1) ? rs_Np - h.prim : 1;
+
+  rs_gf_exp = (const rs_sym_t *)(base + h.sec_off[SEC_EXP]);
+  rs_gf_log = (const rs_sym_t *)(base + h.sec_off[SEC_LOG]);
+  rs_generator = (const rs_sym_t *)(base + h.sec_off[SEC_GEN]);
+  rs_generator_log = (const rs_sym_t *)(base + h.sec_off[SEC_GEN_LOG]);
+#if RS_M_MAX > 8
+  rs_generator_split =
+      h.sec_len[SEC_GEN_SPLIT]
+          ? (const rs_sym_t *)(base + h.sec_off[SEC_GEN_SPLIT])
+          : NULL;
+#endif
+#ifndef RS_COMPACT
+  rs_symbol_bits = (const int(*)[RS_M_MAX])(base + h.sec_off[SEC_BITS]);
+#endif
+  rs_dual_to_conv = h.dual_basis
+                        ? (const rs_sym_t *)(base + h.sec_off[SEC_DUAL_TO_CONV])
+                        : NULL;
+  rs_conv_to_dual = h.dual_basis
+                        ? (const rs_sym_t *)(base + h.sec_off[SEC_CONV_TO_DUAL])
+                        : NULL;
+
+  unmap_file(map_base, map_bytes);
+  map_base = base;
+  map_bytes = bytes;
+
+  rs_code_gen++;
+  return 0;
+}
@@ -0,0 +1,520 @@
+/**
+ * @file rs_tower.c
+ * @brief Composite (tower) field GF((2^4)^2) for table-free GF(256)
+ *        arithmetic in bit-sliced and SIMD kernels.
+ *
+ * Constants (derived offline from 0x11D and checked exhaustively against
+ * rs_gf_mul() / rs_gf_inv() by rs_bench_tower):
+ *
+ *   - TO_* / FROM_*: the basis change x ↦ M·x split into the images of the
+ *     low and high nibble; M's columns are β^i, i < 8 (0x01, 0x21, 0x47,
+ *     0x2b, 0x3d, 0xc8, 0x4f, 0x13), and FROM_* apply M^-1;
+ *   - GF(16) exp/log with generator x, inverses, λ·v and λ·v^2.
+ *
+ * Every kernel computes the same three GF(16) products per GF(256)
+ * product; they differ only in how a GF(16) product is formed (shift and
+ * add, register lookups, or an AND/XOR network on bit planes).
+ */
+
+#include "rs_tower.h"
+
+#include <pthread.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RS_TOWER_X86 1
+#include <immintrin.h>
+#endif
+
+/* Basis change, images of the low / high nibble */
+static const uint8_t TO_LO[16] = {0x00, 0x01, 0x21, 0x20, 0x47, 0x46,
+                                  0x66, 0x67, 0x2b, 0x2a, 0x0a, 0x0b,
+                                  0x6c, 0x6d, 0x4d, 0x4c};
+static const uint8_t TO_HI[16] = {0x00, 0x3d, 0xc8, 0xf5, 0x4f, 0x72,
+                                  0x87, 0xba, 0x13, 0x2e, 0xdb, 0xe6,
+                                  0x5c, 0x61, 0x94, 0xa9};
+static const uint8_t FROM_LO[16] = {0x00, 0x01, 0x4e, 0x4f, 0x99, 0x98,
+                                    0xd7, 0xd6, 0x44, 0x45, 0x0a, 0x0b,
+                                    0xdd, 0xdc, 0x93, 0x92};
+static const uint8_t FROM_HI[16] = {0x00, 0xcf, 0x03, 0xcc, 0xd2, 0x1d,
+                                    0xd1, 0x1e, 0xb6, 0x79, 0xb5, 0x7a,
+                                    0x64, 0xab, 0x67, 0xa8};
+
+/* GF(16) = GF(2)[x] / (x^4 + x + 1); EXP16[15] pads the PSHUFB operand */
+static const uint8_t EXP16[16] = {1, 2, 4, 8,  3,  6,  12, 11,
+                                  5, 10, 7, 14, 15, 13, 9, 1};
+static const uint8_t LOG16[16] = {0, 0, 1, 4,  2,  8,  5,  10,
+                                  3, 14, 9, 7, 6, 13, 11, 12};
+static const uint8_t INV16[16] = {0,  1, 9, 14, 13, 11, 7, 6,
+                                  15, 2, 12, 5, 10, 4, 3, 8};
+static const uint8_t MUL_LAM[16] = {0,  8, 3,  11, 6,  14, 5, 13,
+                                    12, 4, 15, 7,  10, 2,  9, 1};
+static const uint8_t LAM_SQ[16] = {0,  8, 6,  14, 11, 3, 13, 5,
+                                   10, 2, 12, 4,  1,  9, 7,  15};
+
+/* -------------------------------------------------------------------------
+ * Scalar
+ * ------------------------------------------------------------------------- */
+
+/* GF(16) product by shift and add (masks instead of data-dependent
+ * branches) */
+static uint8_t gf16_mul(uint8_t a, uint8_t b) {
+  unsigned p = 0;
+  for (int i = 0; i < 4; i++)
+    p ^= ((unsigned)a << i) & (0u - (b >> i & 1u));
+  for (int i = 6; i >= 4; i--)
+    p ^= (0x13u << (i - 4)) & (0u - (p >> i & 1u));
+  return (uint8_t)p;
+}
+
+uint8_t rs_tower_to(uint8_t x) { return TO_LO[x & 15] ^ TO_HI[x >> 4]; }
+
+uint8_t rs_tower_from(uint8_t t) {
+  return FROM_LO[t & 15] ^ FROM_HI[t >> 4];
+}
+
+uint8_t rs_tower_mul(uint8_t a, uint8_t b) {
+  uint8_t a0 = a & 15, a1 = a >> 4, b0 = b & 15, b1 = b >> 4;
+  uint8_t p00 = gf16_mul(a0, b0);
+  uint8_t c0 = p00 ^ MUL_LAM[gf16_mul(a1, b1)];
+  uint8_t c1 = gf16_mul(a0 ^ a1, b0 ^ b1) ^ p00;
+  return (uint8_t)(c1 << 4 | c0);
+}
+
+uint8_t rs_tower_inv(uint8_t a) {
+  uint8_t a0 = a & 15, a1 = a >> 4;
+  uint8_t d = INV16[gf16_mul(a0, a0 ^ a1) ^ LAM_SQ[a1]];
+  return (uint8_t)(gf16_mul(a1, d) << 4 | gf16_mul(a0 ^ a1, d));
+}
+
+static void mul_scalar(const uint8_t *a, const uint8_t *b, uint8_t *c,
+                       size_t n) {
+  for (size_t i = 0; i < n; i++)
+    c[i] = rs_tower_from(rs_tower_mul(rs_tower_to(a[i]), rs_tower_to(b[i])));
+}
+
+static void inv_scalar(const uint8_t *a, uint8_t *c, size_t n) {
+  for (size_t i = 0; i < n; i++)
+    c[i] = rs_tower_from(rs_tower_inv(rs_tower_to(a[i])));
+}
+
+/* -------------------------------------------------------------------------
+ * Bit-sliced
+ * ------------------------------------------------------------------------- */
+
+/* 8 × 8 bit transpose: bit c of byte r ↔ bit r of byte c */
+static uint64_t transpose8(uint64_t x) {
+  uint64_t t;
+  t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAull;
+  x ^= t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCull;
+  x ^= t ^ (t << 14);
+  t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ull;
+  x ^= t ^ (t << 28);
+  return x;
+}
+
+/* 8 × 8 byte transpose of w[0..7]: byte j of w[g] ↔ byte g of w[j] */
+static void transpose_bytes(uint64_t *w) {
+  for (int g = 0; g < 4; g++) {
+    uint64_t t = ((w[g] >> 32) ^ w[g + 4]) & 0x00000000FFFFFFFFull;
+    w[g] ^= t << 32;
+    w[g + 4] ^= t;
+  }
+  for (int g = 0; g < 8; g += (g % 4 == 1) ? 3 : 1) {
+    uint64_t t = ((w[g] >> 16) ^ w[g + 2]) & 0x0000FFFF0000FFFFull;
+    w[g] ^= t << 16;
+    w[g + 2] ^= t;
+  }
+  for (int g = 0; g < 8; g += 2) {
+    uint64_t t = ((w[g] >> 8) ^ w[g + 1]) & 0x00FF00FF00FF00FFull;
+    w[g] ^= t << 8;
+    w[g + 1] ^= t;
+  }
+}
+
+/* The basis change is applied per byte (two nibble lookups), which is
+ * cheaper than the same 8 × 8 matrix as an XOR network on the planes.
+ * Planes: bits of each 8-symbol group (transpose8), then bytes across the
+ * groups (transpose_bytes). */
+void rs_tower_bs_load(const uint8_t *x, rs_tower_bs *s) {
+  for (int g = 0; g < 8; g++) {
+    uint64_t w = 0;
+    for (int k = 0; k < 8; k++)
+      w |= (uint64_t)rs_tower_to(x[8 * g + k]) << (8 * k);
+    s->p[g] = transpose8(w);
+  }
+  transpose_bytes(s->p);
+}
+
+void rs_tower_bs_store(const rs_tower_bs *s, uint8_t *x) {
+  uint64_t w[8];
+  memcpy(w, s->p, sizeof(w));
+  transpose_bytes(w);
+  for (int g = 0; g < 8; g++) {
+    uint64_t v = transpose8(w[g]);
+    for (int k = 0; k < 8; k++)
+      x[8 * g + k] = rs_tower_from((uint8_t)(v >> (8 * k)));
+  }
+}
+
+/* GF(16) product on 4 planes: carry-less product, x^4 = x + 1 */
+static void bs16_mul(const uint64_t *a, const uint64_t *b, uint64_t *c) {
+  uint64_t p4 = (a[3] & b[1]) ^ (a[2] & b[2]) ^ (a[1] & b[3]);
+  uint64_t p5 = (a[3] & b[2]) ^ (a[2] & b[3]);
+  uint64_t p6 = a[3] & b[3];
+  uint64_t p0 = a[0] & b[0];
+  uint64_t p1 = (a[1] & b[0]) ^ (a[0] & b[1]);
+  uint64_t p2 = (a[2] & b[0]) ^ (a[1] & b[1]) ^ (a[0] & b[2]);
+  uint64_t p3 = (a[3] & b[0]) ^ (a[2] & b[1]) ^ (a[1] & b[2]) ^ (a[0] & b[3]);
+  c[0] = p0 ^ p4;
+  c[1] = p1 ^ p4 ^ p5;
+  c[2] = p2 ^ p5 ^ p6;
+  c[3] = p3 ^ p6;
+}
+
+/* v^2 (linear in characteristic 2) */
+static void bs16_sq(const uint64_t *v, uint64_t *c) {
+  uint64_t c0 = v[0] ^ v[2], c1 = v[2], c2 = v[1] ^ v[3], c3 = v[3];
+  c[0] = c0;
+  c[1] = c1;
+  c[2] = c2;
+  c[3] = c3;
+}
+
+/* λ·v, λ = x^3 */
+static void bs16_mul_lam(const uint64_t *v, uint64_t *c) {
+  uint64_t c0 = v[1], c1 = v[1] ^ v[2], c2 = v[2] ^ v[3], c3 = v[0] ^ v[3];
+  c[0] = c0;
+  c[1] = c1;
+  c[2] = c2;
+  c[3] = c3;
+}
+
+void rs_tower_bs_mul(const rs_tower_bs *a, const rs_tower_bs *b,
+                     rs_tower_bs *c) {
+  uint64_t sa[4], sb[4], p00[4], p11[4], pss[4];
+  for (int j = 0; j < 4; j++) {
+    sa[j] = a->p[j] ^ a->p[4 + j];
+    sb[j] = b->p[j] ^ b->p[4 + j];
+  }
+  bs16_mul(a->p, b->p, p00);
+  bs16_mul(a->p + 4, b->p + 4, p11);
+  bs16_mul(sa, sb, pss);
+  bs16_mul_lam(p11, p11);
+  for (int j = 0; j < 4; j++) {
+    c->p[j] = p00[j] ^ p11[j];
+    c->p[4 + j] = pss[j] ^ p00[j];
+  }
+}
+
+void rs_tower_bs_inv(const rs_tower_bs *a, rs_tower_bs *c) {
+  uint64_t s[4], d[4], q[4], d2[4], d4[4], d8[4];
+  for (int j = 0; j < 4; j++)
+    s[j] = a->p[j] ^ a->p[4 + j];
+
+  /* d = a0 (a0 + a1) + λ a1^2 */
+  bs16_mul(a->p, s, d);
+  bs16_sq(a->p + 4, q);
+  bs16_mul_lam(q, q);
+  for (int j = 0; j < 4; j++)
+    d[j] ^= q[j];
+
+  /* 1 / d = d^14 = d^2 · d^4 · d^8 */
+  bs16_sq(d, d2);
+  bs16_sq(d2, d4);
+  bs16_sq(d4, d8);
+  bs16_mul(d2, d4, d);
+  bs16_mul(d, d8, d);
+
+  uint64_t a1[4];
+  memcpy(a1, a->p + 4, sizeof(a1));
+  bs16_mul(s, d, c->p);
+  bs16_mul(a1, d, c->p + 4);
+}
+
+static void mul_bitslice(const uint8_t *a, const uint8_t *b, uint8_t *c,
+                         size_t n) {
+  size_t i = 0;
+  for (; i + 64 <= n; i += 64) {
+    rs_tower_bs x, y;
+    rs_tower_bs_load(a + i, &x);
+    rs_tower_bs_load(b + i, &y);
+    rs_tower_bs_mul(&x, &y, &x);
+    rs_tower_bs_store(&x, c + i);
+  }
+  mul_scalar(a + i, b + i, c + i, n - i);
+}
+
+static void inv_bitslice(const uint8_t *a, uint8_t *c, size_t n) {
+  size_t i = 0;
+  for (; i + 64 <= n; i += 64) {
+    rs_tower_bs x;
+    rs_tower_bs_load(a + i, &x);
+    rs_tower_bs_inv(&x, &x);
+    rs_tower_bs_store(&x, c + i);
+  }
+  inv_scalar(a + i, c + i, n - i);
+}
+
+#ifdef RS_TOWER_X86
+/* -------------------------------------------------------------------------
+ * SSSE3: 16 lanes, GF(16) tables in PSHUFB operands
+ * ------------------------------------------------------------------------- */
+typedef struct {
+  __m128i to_lo, to_hi, from_lo, from_hi, exp, log, inv, lam, lam_sq, nib;
+} tables128;
+
+__attribute__((target("ssse3"))) static void load128(tables128 *t) {
+  t->to_lo = _mm_loadu_si128((const __m128i *)TO_LO);
+  t->to_hi = _mm_loadu_si128((const __m128i *)TO_HI);
+  t->from_lo = _mm_loadu_si128((const __m128i *)FROM_LO);
+  t->from_hi = _mm_loadu_si128((const __m128i *)FROM_HI);
+  t->exp = _mm_loadu_si128((const __m128i *)EXP16);
+  t->log = _mm_loadu_si128((const __m128i *)LOG16);
+  t->inv = _mm_loadu_si128((const __m128i *)INV16);
+  t->lam = _mm_loadu_si128((const __m128i *)MUL_LAM);
+  t->lam_sq = _mm_loadu_si128((const __m128i *)LAM_SQ);
+  t->nib = _mm_set1_epi8(0x0F);
+}
+
+/* Nibble lookup: lo[x & 15] ^ hi[x >> 4] */
+__attribute__((target("ssse3"))) static inline __m128i
+lookup128(__m128i x, __m128i lo, __m128i hi, __m128i nib) {
+  __m128i h = _mm_and_si128(_mm_srli_epi16(x, 4), nib);
+  return _mm_xor_si128(_mm_shuffle_epi8(lo, _mm_and_si128(x, nib)),
+                       _mm_shuffle_epi8(hi, h));
+}
+
+/* GF(16) product of nibble lanes: exp[(log a + log b) mod 15] */
+__attribute__((target("ssse3"))) static inline __m128i
+gf16_mul128(__m128i a, __m128i b, const tables128 *t) {
+  __m128i s = _mm_add_epi8(_mm_shuffle_epi8(t->log, a),
+                           _mm_shuffle_epi8(t->log, b));
+  s = _mm_min_epu8(s, _mm_sub_epi8(s, _mm_set1_epi8(15)));
+  __m128i zero = _mm_or_si128(_mm_cmpeq_epi8(a, _mm_setzero_si128()),
+                              _mm_cmpeq_epi8(b, _mm_setzero_si128()));
+  return _mm_andnot_si128(zero, _mm_shuffle_epi8(t->exp, s));
+}
+
+__attribute__((target("ssse3"))) static void
+mul_ssse3(const uint8_t *a, const uint8_t *b, uint8_t *c, size_t n) {
+  tables128 t;
+  load128(&t);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i x = lookup128(_mm_loadu_si128((const __m128i *)(a + i)),
+                          t.to_lo, t.to_hi, t.nib);
+    __m128i y = lookup128(_mm_loadu_si128((const __m128i *)(b + i)),
+                          t.to_lo, t.to_hi, t.nib);
+    __m128i x0 = _mm_and_si128(x, t.nib);
+    __m128i x1 = _mm_and_si128(_mm_srli_epi16(x, 4), t.nib);
+    __m128i y0 = _mm_and_si128(y, t.nib);
+    __m128i y1 = _mm_and_si128(_mm_srli_epi16(y, 4), t.nib);
+
+    __m128i p00 = gf16_mul128(x0, y0, &t);
+    __m128i p11 = gf16_mul128(x1, y1, &t);
+    __m128i pss =
+        gf16_mul128(_mm_xor_si128(x0, x1), _mm_xor_si128(y0, y1), &t);
+    __m128i c0 = _mm_xor_si128(p00, _mm_shuffle_epi8(t.lam, p11));
+    __m128i c1 = _mm_xor_si128(pss, p00);
+
+    /* c1 < 16, so the 16-bit shift stays inside each byte */
+    __m128i z = _mm_or_si128(c0, _mm_slli_epi16(c1, 4));
+    _mm_storeu_si128((__m128i *)(c + i),
+                     lookup128(z, t.from_lo, t.from_hi, t.nib));
+  }
+  mul_scalar(a + i, b + i, c + i, n - i);
+}
+
+__attribute__((target("ssse3"))) static void inv_ssse3(const uint8_t *a,
+                                                       uint8_t *c, size_t n) {
+  tables128 t;
+  load128(&t);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i x = lookup128(_mm_loadu_si128((const __m128i *)(a + i)),
+                          t.to_lo, t.to_hi, t.nib);
+    __m128i x0 = _mm_and_si128(x, t.nib);
+    __m128i x1 = _mm_and_si128(_mm_srli_epi16(x, 4), t.nib);
+    __m128i s = _mm_xor_si128(x0, x1);
+
+    __m128i d = _mm_xor_si128(gf16_mul128(x0, s, &t),
+                              _mm_shuffle_epi8(t.lam_sq, x1));
+    d = _mm_shuffle_epi8(t.inv, d);
+    __m128i z = _mm_or_si128(gf16_mul128(s, d, &t),
+                             _mm_slli_epi16(gf16_mul128(x1, d, &t), 4));
+    _mm_storeu_si128((__m128i *)(c + i),
+                     lookup128(z, t.from_lo, t.from_hi, t.nib));
+  }
+  inv_scalar(a + i, c + i, n - i);
+}
+
+/* -------------------------------------------------------------------------
+ * AVX2: 32 lanes, tables repeated in both 128-bit halves
+ * ------------------------------------------------------------------------- */
+typedef struct {
+  __m256i to_lo, to_hi, from_lo, from_hi, exp, log, inv, lam, lam_sq, nib;
+} tables256;
+
+__attribute__((target("avx2"))) static __m256i bcast(const uint8_t *tab) {
+  return _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)tab));
+}
+
+__attribute__((target("avx2"))) static void load256(tables256 *t) {
+  t->to_lo = bcast(TO_LO);
+  t->to_hi = bcast(TO_HI);
+  t->from_lo = bcast(FROM_LO);
+  t->from_hi = bcast(FROM_HI);
+  t->exp = bcast(EXP16);
+  t->log = bcast(LOG16);
+  t->inv = bcast(INV16);
+  t->lam = bcast(MUL_LAM);
+  t->lam_sq = bcast(LAM_SQ);
+  t->nib = _mm256_set1_epi8(0x0F);
+}
+
+__attribute__((target("avx2"))) static inline __m256i
+lookup256(__m256i x, __m256i lo, __m256i hi, __m256i nib) {
+  __m256i h = _mm256_and_si256(_mm256_srli_epi16(x, 4), nib);
+  return _mm256_xor_si256(_mm256_shuffle_epi8(lo, _mm256_and_si256(x, nib)),
+                          _mm256_shuffle_epi8(hi, h));
+}
+
+__attribute__((target("avx2"))) static inline __m256i
+gf16_mul256(__m256i a, __m256i b, const tables256 *t) {
+  __m256i s = _mm256_add_epi8(_mm256_shuffle_epi8(t->log, a),
+                              _mm256_shuffle_epi8(t->log, b));
+  s = _mm256_min_epu8(s, _mm256_sub_epi8(s, _mm256_set1_epi8(15)));
+  __m256i zero =
+      _mm256_or_si256(_mm256_cmpeq_epi8(a, _mm256_setzero_si256()),
+                      _mm256_cmpeq_epi8(b, _mm256_setzero_si256()));
+  return _mm256_andnot_si256(zero, _mm256_shuffle_epi8(t->exp, s));
+}
+
+__attribute__((target("avx2"))) static void
+mul_avx2(const uint8_t *a, const uint8_t *b, uint8_t *c, size_t n) {
+  tables256 t;
+  load256(&t);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i x = lookup256(_mm256_loadu_si256((const __m256i *)(a + i)),
+                          t.to_lo, t.to_hi, t.nib);
+    __m256i y = lookup256(_mm256_loadu_si256((const __m256i *)(b + i)),
+                          t.to_lo, t.to_hi, t.nib);
+    __m256i x0 = _mm256_and_si256(x, t.nib);
+    __m256i x1 = _mm256_and_si256(_mm256_srli_epi16(x, 4), t.nib);
+    __m256i y0 = _mm256_and_si256(y, t.nib);
+    __m256i y1 = _mm256_and_si256(_mm256_srli_epi16(y, 4), t.nib);
+
+    __m256i p00 = gf16_mul256(x0, y0, &t);
+    __m256i p11 = gf16_mul256(x1, y1, &t);
+    __m256i pss = gf16_mul256(_mm256_xor_si256(x0, x1),
+                              _mm256_xor_si256(y0, y1), &t);
+    __m256i c0 = _mm256_xor_si256(p00, _mm256_shuffle_epi8(t.lam, p11));
+    __m256i c1 = _mm256_xor_si256(pss, p00);
+
+    __m256i z = _mm256_or_si256(c0, _mm256_slli_epi16(c1, 4));
+    _mm256_storeu_si256((__m256i *)(c + i),
+                        lookup256(z, t.from_lo, t.from_hi, t.nib));
+  }
+  mul_scalar(a + i, b + i, c + i, n - i);
+}
+
+__attribute__((target("avx2"))) static void inv_avx2(const uint8_t *a,
+                                                     uint8_t *c, size_t n) {
+  tables256 t;
+  load256(&t);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i x = lookup256(_mm256_loadu_si256((const __m256i *)(a + i)),
+                          t.to_lo, t.to_hi, t.nib);
+    __m256i x0 = _mm256_and_si256(x, t.nib);
+    __m256i x1 = _mm256_and_si256(_mm256_srli_epi16(x, 4), t.nib);
+    __m256i s = _mm256_xor_si256(x0, x1);
+
+    __m256i d = _mm256_xor_si256(gf16_mul256(x0, s, &t),
+                                 _mm256_shuffle_epi8(t.lam_sq, x1));
+    d = _mm256_shuffle_epi8(t.inv, d);
+    __m256i z =
+        _mm256_or_si256(gf16_mul256(s, d, &t),
+                        _mm256_slli_epi16(gf16_mul256(x1, d, &t), 4));
+    _mm256_storeu_si256((__m256i *)(c + i),
+                        lookup256(z, t.from_lo, t.from_hi, t.nib));
+  }
+  inv_scalar(a + i, c + i, n - i);
+}
+#endif /* RS_TOWER_X86 */
+
+/* -------------------------------------------------------------------------
+ * Kernel selection
+ * ------------------------------------------------------------------------- */
+typedef struct {
+  const char *name;
+  void (*mul)(const uint8_t *, const uint8_t *, uint8_t *, size_t);
+  void (*inv)(const uint8_t *, uint8_t *, size_t);
+} tower_kernel;
+
+static const tower_kernel kernels[] = {
+#ifdef RS_TOWER_X86
+    {"avx2", mul_avx2, inv_avx2},
+    {"ssse3", mul_ssse3, inv_ssse3},
+#endif
+    {"bitslice", mul_bitslice, inv_bitslice},
+    {"scalar", mul_scalar, inv_scalar},
+};
+
+#define N_KERNELS ((int)(sizeof(kernels) / sizeof(kernels[0])))
+
+static const tower_kernel *active;
+static pthread_once_t select_once = PTHREAD_ONCE_INIT;
+
+static int supported(const tower_kernel *k) {
+#ifdef RS_TOWER_X86
+  __builtin_cpu_init();
+  if (strcmp(k->name, "avx2") == 0)
+    return __builtin_cpu_supports("avx2");
+  if (strcmp(k->name, "ssse3") == 0)
+    return __builtin_cpu_supports("ssse3");
+#endif
+  (void)k;
+  return 1;
+}
+
+/* First supported kernel in order of preference */
+static void select_default(void) {
+  for (int i = 0; i < N_KERNELS && !active; i++)
+    if (supported(&kernels[i]))
+      active = &kernels[i];
+}
+
+static const tower_kernel *kernel(void) {
+  pthread_once(&select_once, select_default);
+  return active;
+}
+
+const char *rs_tower_kernel(void) { return kernel()->name; }
+
+int rs_tower_set_kernel(const char *name) {
+  pthread_once(&select_once, select_default);
+  if (!name) {
+    active = NULL;
+    select_default();
+    return 0;
+  }
+  for (int i = 0; i < N_KERNELS; i++)
+    if (strcmp(kernels[i].name, name) == 0 && supported(&kernels[i])) {
+      active = &kernels[i];
+      return 0;
+    }
+  return -1;
+}
+
+void rs_tower_mul_vec(const uint8_t *a, const uint8_t *b, uint8_t *c,
+                      size_t n) {
+  kernel()->mul(a, b, c, n);
+}
+
+void rs_tower_inv_vec(const uint8_t *a, uint8_t *c, size_t n) {
+  kernel()->inv(a, c, n);
+}
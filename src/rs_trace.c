@@ -0,0 +1,340 @@
+/**
+ * @file rs_trace.c
+ * @brief Binary traces of received codewords: capture and mmap replay.
+ *
+ * The writer assembles each record in a private buffer and appends it
+ * under a mutex through a large stdio buffer, so capture costs one packing
+ * pass and a memcpy per decoded word. The reader maps the file read-only
+ * (read into private memory where mmap is unavailable) and serves records
+ * in place.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "rs_trace.h"
+#include "rs_gf.h"
+#include "rs_pack.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define WRITE_BUFFER (1 << 20)
+
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t header_bytes; /* sizeof(trace_header) */
+  uint32_t flags;        /* RS_TRACE_TIMESTAMPS | RS_TRACE_ERASURES */
+  int32_t m, N, K, T;
+  uint32_t poly; /* code options (rs_gf_init_params()) */
+  int32_t fcr, prim, dual_basis;
+  int32_t bit_order, packing; /* wire format (rs_pack.h) */
+  uint32_t record_bytes;
+  uint32_t reserved;
+} trace_header;
+
+struct rs_trace_writer {
+  pthread_mutex_t lock;
+  FILE *fp;
+  unsigned flags;
+  size_t record_bytes, code_offset, eras_offset, code_bytes;
+  uint8_t *rec; /* record being assembled */
+  int N;
+  int error;
+};
+
+rs_trace_writer *rs_trace_active;
+
+/* Record layout for N symbols of the current field and wire format */
+static void record_layout(unsigned flags, int N, size_t *code_offset,
+                          size_t *eras_offset, size_t *record_bytes) {
+  size_t off = (flags & RS_TRACE_TIMESTAMPS) ? sizeof(uint64_t) : 0;
+  *code_offset = off;
+  off += rs_packed_bytes(N);
+  *eras_offset = off;
+  if (flags & RS_TRACE_ERASURES)
+    off += ((size_t)N + 7) / 8;
+  *record_bytes = off;
+}
+
+/* -------------------------------------------------------------------------
+ * Writing
+ * ------------------------------------------------------------------------- */
+rs_trace_writer *rs_trace_create(const char *path, unsigned flags) {
+  if (rs_T <= 0) {
+    fprintf(stderr, "ERROR: rs_trace_create() needs rs_gf_init() first\n");
+    return NULL;
+  }
+  flags &= RS_TRACE_TIMESTAMPS | RS_TRACE_ERASURES;
+
+  rs_trace_writer *w = (rs_trace_writer *)calloc(1, sizeof(*w));
+  if (!w)
+    return NULL;
+  w->flags = flags;
+  w->N = rs_N;
+  w->code_bytes = rs_packed_bytes(rs_N);
+  record_layout(flags, rs_N, &w->code_offset, &w->eras_offset,
+                &w->record_bytes);
+  w->rec = (uint8_t *)calloc(1, w->record_bytes);
+  w->fp = fopen(path, "wb");
+  if (!w->rec || !w->fp) {
+    fprintf(stderr, "ERROR: cannot create trace %s\n", path);
+    if (w->fp)
+      fclose(w->fp);
+    free(w->rec);
+    free(w);
+    return NULL;
+  }
+  setvbuf(w->fp, NULL, _IOFBF, WRITE_BUFFER);
+  pthread_mutex_init(&w->lock, NULL);
+
+  trace_header h;
+  memset(&h, 0, sizeof(h));
+  h.magic = RS_TRACE_MAGIC;
+  h.version = RS_TRACE_VERSION;
+  h.header_bytes = sizeof(trace_header);
+  h.flags = flags;
+  h.m = rs_m;
+  h.N = rs_N;
+  h.K = rs_K;
+  h.T = rs_T;
+  h.poly = rs_poly;
+  h.fcr = rs_fcr;
+  h.prim = rs_prim;
+  h.dual_basis = (rs_dual_to_conv != NULL);
+  rs_io_get_format(&h.bit_order, &h.packing);
+  h.record_bytes = (uint32_t)w->record_bytes;
+  if (fwrite(&h, sizeof(h), 1, w->fp) != 1)
+    w->error = 1;
+  return w;
+}
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* Fill the optional fields of w->rec and append it; w->lock held */
+static int append_locked(rs_trace_writer *w, const int *eras_pos,
+                         int n_eras, uint64_t t_ns) {
+  if (w->flags & RS_TRACE_TIMESTAMPS) {
+    if (t_ns == 0)
+      t_ns = now_ns();
+    memcpy(w->rec, &t_ns, sizeof(t_ns));
+  }
+  if (w->flags & RS_TRACE_ERASURES) {
+    uint8_t *map = w->rec + w->eras_offset;
+    memset(map, 0, ((size_t)w->N + 7) / 8);
+    for (int j = 0; j < n_eras; j++)
+      if (eras_pos[j] >= 0 && eras_pos[j] < w->N)
+        map[eras_pos[j] >> 3] |= (uint8_t)(1u << (eras_pos[j] & 7));
+  }
+  if (fwrite(w->rec, w->record_bytes, 1, w->fp) != 1) {
+    w->error = 1;
+    return -1;
+  }
+  return 0;
+}
+
+int rs_trace_write(rs_trace_writer *w, const uint8_t *code_pack,
+                   const int *eras_pos, int n_eras, uint64_t t_ns) {
+  pthread_mutex_lock(&w->lock);
+  memcpy(w->rec + w->code_offset, code_pack, w->code_bytes);
+  int ret = append_locked(w, eras_pos, n_eras, t_ns);
+  pthread_mutex_unlock(&w->lock);
+  return ret;
+}
+
+int rs_trace_write_sym(rs_trace_writer *w, const rs_sym_t *code_sym,
+                       const int *eras_pos, int n_eras, uint64_t t_ns) {
+  pthread_mutex_lock(&w->lock);
+  rs_pack_symbols(code_sym, w->rec + w->code_offset, w->N);
+  int ret = append_locked(w, eras_pos, n_eras, t_ns);
+  pthread_mutex_unlock(&w->lock);
+  return ret;
+}
+
+int rs_trace_close(rs_trace_writer *w) {
+  if (!w)
+    return 0;
+  if (rs_trace_active == w)
+    rs_trace_active = NULL;
+  int ret = (fclose(w->fp) == 0 && !w->error) ? 0 : -1;
+  pthread_mutex_destroy(&w->lock);
+  free(w->rec);
+  free(w);
+  return ret;
+}
+
+void rs_trace_capture(rs_trace_writer *w) { rs_trace_active = w; }
+
+/* -------------------------------------------------------------------------
+ * Reading
+ * ------------------------------------------------------------------------- */
+static void *map_file(const char *path, size_t *bytes) {
+#ifndef _WIN32
+  int fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return NULL;
+  struct stat st;
+  void *p = NULL;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED)
+      p = NULL;
+    *bytes = (size_t)st.st_size;
+  }
+  close(fd);
+  return p;
+#else
+  FILE *fp = fopen(path, "rb");
+  if (!fp)
+    return NULL;
+  void *p = NULL;
+  if (fseek(fp, 0, SEEK_END) == 0) {
+    long len = ftell(fp);
+    if (len > 0 && fseek(fp, 0, SEEK_SET) == 0 && (p = malloc(len)) &&
+        fread(p, 1, (size_t)len, fp) != (size_t)len) {
+      free(p);
+      p = NULL;
+    }
+    *bytes = (size_t)len;
+  }
+  fclose(fp);
+  return p;
+#endif
+}
+
+static void unmap_file(void *p, size_t bytes) {
+  if (!p)
+    return;
+#ifndef _WIN32
+  munmap(p, bytes);
+#else
+  (void)bytes;
+  free(p);
+#endif
+}
+
+int rs_trace_map(const char *path, rs_trace *t) {
+  memset(t, 0, sizeof(*t));
+
+  size_t bytes = 0;
+  uint8_t *base = (uint8_t *)map_file(path, &bytes);
+  if (!base) {
+    fprintf(stderr, "ERROR: cannot map trace %s\n", path);
+    return -1;
+  }
+
+  trace_header h;
+  if (bytes < sizeof(h)) {
+    fprintf(stderr, "ERROR: %s: truncated trace header\n", path);
+    unmap_file(base, bytes);
+    return -1;
+  }
+  memcpy(&h, base, sizeof(h));
+  if (h.magic != RS_TRACE_MAGIC || h.version != RS_TRACE_VERSION ||
+      h.header_bytes != sizeof(h) || h.m < 1 || h.m > RS_M_MAX ||
+      h.N < 1 || h.N >= (1 << h.m) || h.K < 1 || h.T < 1 ||
+      h.N != h.K + h.T) {
+    fprintf(stderr, "ERROR: %s is not a trace for this build\n", path);
+    unmap_file(base, bytes);
+    return -1;
+  }
+
+  /* Every offset used by the accessors must lie inside a record */
+  size_t ts_bytes = (h.flags & RS_TRACE_TIMESTAMPS) ? sizeof(uint64_t) : 0;
+  size_t eras_bytes = (h.flags & RS_TRACE_ERASURES) ? ((size_t)h.N + 7) / 8
+                                                    : 0;
+  if ((h.flags & ~(RS_TRACE_TIMESTAMPS | RS_TRACE_ERASURES)) != 0 ||
+      (h.bit_order != RS_BIT_LSB_FIRST && h.bit_order != RS_BIT_MSB_FIRST) ||
+      (h.packing != RS_PACK_DENSE && h.packing != RS_PACK_ALIGNED) ||
+      h.record_bytes !=
+          ts_bytes + rs_packed_bytes_for(h.m, h.packing, h.N) + eras_bytes) {
+    fprintf(stderr, "ERROR: %s: invalid record layout\n", path);
+    unmap_file(base, bytes);
+    return -1;
+  }
+  size_t tail = (bytes - sizeof(h)) % h.record_bytes;
+  if (tail != 0)
+    fprintf(stderr, "WARNING: %s: partial last record (%zu bytes) ignored\n",
+            path, tail);
+
+  t->flags = h.flags;
+  t->m = h.m;
+  t->N = h.N;
+  t->K = h.K;
+  t->T = h.T;
+  t->params.poly = h.poly;
+  t->params.fcr = h.fcr;
+  t->params.prim = h.prim;
+  t->params.dual_basis = h.dual_basis;
+  t->bit_order = h.bit_order;
+  t->packing = h.packing;
+  t->record_bytes = h.record_bytes;
+  t->code_offset = ts_bytes;
+  t->eras_offset = h.record_bytes - eras_bytes;
+  t->n_records = (bytes - sizeof(h)) / h.record_bytes;
+  t->records = base + sizeof(h);
+  t->base = base;
+  t->bytes = bytes;
+  return 0;
+}
+
+void rs_trace_unmap(rs_trace *t) {
+  unmap_file(t->base, t->bytes);
+  memset(t, 0, sizeof(*t));
+}
+
+int rs_trace_select(const rs_trace *t) {
+  if (rs_gf_init_params(t->m, t->N, t->K, t->T, &t->params) != 0 ||
+      rs_io_set_format(t->bit_order, t->packing) != 0)
+    return -1;
+
+  /* The record layout must match what this build packs */
+  size_t code_offset, eras_offset, record_bytes;
+  record_layout(t->flags, t->N, &code_offset, &eras_offset, &record_bytes);
+  if (record_bytes != t->record_bytes) {
+    fprintf(stderr, "ERROR: trace record size %zu, expected %zu\n",
+            t->record_bytes, record_bytes);
+    return -1;
+  }
+  return 0;
+}
+
+const uint8_t *rs_trace_codeword(const rs_trace *t, size_t i) {
+  return t->records + i * t->record_bytes + t->code_offset;
+}
+
+uint64_t rs_trace_time(const rs_trace *t, size_t i) {
+  uint64_t v = 0;
+  if (t->flags & RS_TRACE_TIMESTAMPS)
+    memcpy(&v, t->records + i * t->record_bytes, sizeof(v));
+  return v;
+}
+
+int rs_trace_erasures(const rs_trace *t, size_t i, int *eras_pos) {
+  if (!(t->flags & RS_TRACE_ERASURES))
+    return 0;
+  const uint8_t *map = t->records + i * t->record_bytes + t->eras_offset;
+  int n = 0, last = (t->N - 1) / 8;
+  for (int b = 0; b <= last; b++) {
+    unsigned v = map[b];
+    if (b == last) /* padding bits at and above N are not positions */
+      v &= 0xFFu >> (8 * (last + 1) - t->N);
+    for (; v; v &= v - 1)
+      eras_pos[n++] = b * 8 + __builtin_ctz(v);
+  }
+  return n;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file rs_workspace.c
+ * @brief Per-code scratch memory for the Reed–Solomon encoder/decoder.
+ *
+ * A workspace is one contiguous arena carved into the buffers listed in
+ * rs_workspace.h. The int-typed error positions come first so that the
+ * arena only needs int alignment.
+ *
+ * The implicit per-thread workspace is kept in thread-specific storage
+ * with a destructor, so worker threads that call rs_decode() do not leak.
+ */
+
+#include "rs_workspace.h"
+#include "rs_gf.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+/* -------------------------------------------------------------------------
+ * Layout
+ * ------------------------------------------------------------------------- */
+size_t rs_workspace_size(void) {
+  size_t N = (size_t)rs_N;
+  size_t T = (size_t)rs_T;
+  size_t t = T / 2;
+
+  size_t n_int = T + 1;
+  size_t n_sym = N + T + 3 * (T + 1) + (t + 1) + t * t + t;
+
+  return n_int * sizeof(int) + n_sym * sizeof(rs_sym_t);
+}
+
+int rs_workspace_init(rs_workspace *ws, void *mem, size_t bytes) {
+  if (!ws || !mem || bytes < rs_workspace_size())
+    return -1;
+
+  int N = rs_N;
+  int T = rs_T;
+  int t = T / 2;
+
+  ws->N = N;
+  ws->T = T;
+  ws->gen = rs_code_gen;
+  ws->corr_bits = 0;
+  ws->owned = NULL;
+
+  ws->error_pos = (int *)mem;
+
+  rs_sym_t *p = (rs_sym_t *)(ws->error_pos + (T + 1));
+  ws->sym = p;
+  p += N;
+  ws->synd = p;
+  p += T;
+  ws->bm_C = p;
+  p += T + 1;
+  ws->bm_B = p;
+  p += T + 1;
+  ws->bm_tmp = p;
+  p += T + 1;
+  ws->sigma = p;
+  p += t + 1;
+  ws->mat = p;
+  p += (size_t)t * t;
+  ws->rhs = p;
+
+  return 0;
+}
+
+int rs_workspace_check(const rs_workspace *ws) {
+  if (!ws)
+    return -1;
+  if (ws->gen == rs_code_gen || (ws->N >= rs_N && ws->T >= rs_T))
+    return 0;
+  return -1;
+}
+
+/* -------------------------------------------------------------------------
+ * Heap workspaces
+ * ------------------------------------------------------------------------- */
+rs_workspace *rs_workspace_create(void) {
+  rs_workspace *ws = (rs_workspace *)malloc(sizeof(rs_workspace));
+  size_t bytes = rs_workspace_size();
+  void *mem = malloc(bytes);
+
+  if (!ws || !mem || rs_workspace_init(ws, mem, bytes) != 0) {
+    free(ws);
+    free(mem);
+    return NULL;
+  }
+
+  ws->owned = mem;
+  return ws;
+}
+
+void rs_workspace_destroy(rs_workspace *ws) {
+  if (!ws)
+    return;
+  free(ws->owned);
+  free(ws);
+}
+
+/* -------------------------------------------------------------------------
+ * Implicit per-thread workspace
+ * ------------------------------------------------------------------------- */
+static pthread_key_t tls_key;
+static pthread_once_t tls_once = PTHREAD_ONCE_INIT;
+
+static void tls_destroy(void *ws) { rs_workspace_destroy((rs_workspace *)ws); }
+
+static void tls_make_key(void) { pthread_key_create(&tls_key, tls_destroy); }
+
+rs_workspace *rs_workspace_default(void) {
+  pthread_once(&tls_once, tls_make_key);
+
+  rs_workspace *ws = (rs_workspace *)pthread_getspecific(tls_key);
+  if (ws && ws->gen == rs_code_gen)
+    return ws;
+
+  /* First use on this thread, or rs_gf_init() changed the code */
+  rs_workspace_destroy(ws);
+  ws = rs_workspace_create();
+  pthread_setspecific(tls_key, ws);
+  return ws;
+}
@@ -0,0 +1,61 @@
+#!/bin/sh
+# ============================================================
+#  Memory footprint report per build profile
+#
+#  For each profile the codec library (src/*.c) is compiled with
+#  -fstack-usage and reported as:
+#    - static : text / data / bss of all codec objects (size)
+#    - stack  : largest frame among the encode/decode call chain
+#    - heap   : rs_workspace_size() for RS(255,223)
+#
+#  Usage: tools/footprint.sh   (or: make footprint)
+# ============================================================
+set -e
+
+CC=${CC:-gcc}
+SRC="src/rs_gf.c src/rs_encoder.c src/rs_decoder.c src/rs_pack.c src/rs_workspace.c
+     src/rs_poly.c src/rs_trace.c"
+SRC_WIDE="src/rs_gf16.c" # vector kernels of the m > 8 paths (RS_M_MAX > 8)
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+cat > "$TMP/ws.c" <<'CEOF'
+#include <stdio.h>
+#include "rs_gf.h"
+#include "rs_workspace.h"
+int main(void) {
+  rs_gf_init(8, 255, 223, 32);
+  printf("%zu\n", rs_workspace_size());
+  return 0;
+}
+CEOF
+
+report() {
+  name=$1
+  shift
+  dir="$TMP/$name"
+  src=$SRC
+  [ "$name" = default ] && src="$SRC $SRC_WIDE"
+  mkdir -p "$dir"
+  for f in $src; do
+    "$CC" -Os -std=c11 -pthread -Iinclude -fstack-usage "$@" \
+      -c "$f" -o "$dir/$(basename "$f" .c).o"
+  done
+  "$CC" -std=c11 -pthread -Iinclude "$@" "$TMP/ws.c" "$dir"/*.o \
+    -o "$dir/ws" -lm
+
+  set -- $(size "$dir"/*.o | awk 'NR > 1 { t += $1; d += $2; b += $3 }
+                                  END { print t, d, b }')
+  stack=$(cat "$dir"/*.su | awk -F'\t' '$1 ~ /rs_(en|de)code|berlekamp|chien|correct|syndromes/ {
+            if ($2 + 0 > max) { max = $2 + 0; fn = $1 } }
+          END { sub(/.*:/, "", fn); print max " (" fn ")" }')
+  ws=$("$dir/ws")
+
+  printf "%-9s text=%-7s data=%-5s bss=%-9s stack=%-28s workspace=%s\n" \
+    "$name" "$1" "$2" "$3" "$stack" "$ws"
+}
+
+echo "Codec footprint in bytes (gcc -Os, RS(255,223) workspace)"
+report default
+report m8 -DRS_M_MAX=8
+report compact -DRS_COMPACT